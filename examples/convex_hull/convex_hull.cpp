@@ -39,6 +39,7 @@
 
 #include <chrono>
 #include <vector>
+#include <iterator>
 #include <fstream>
 #include <pstl/algorithm>
 #include <pstl/numeric>
@@ -74,30 +75,30 @@ void divide_and_conquer(Policy exec, Iterator first, Iterator last, pointVec_t &
 template<typename Policy, typename Iterator>
 void find_hull_points(Policy exec, Iterator first, Iterator last, pointVec_t &H, point_t p1, point_t p2) {
 
-    pointVec_t P_reduced(last - first);
+    pointVec_t P_reduced;
 
     //Find points from the range [first, last-1] that are on the right side of the segment [p1,p2]
-    Iterator end = std::copy_if(exec, first, last, P_reduced.begin(),
+    std::copy_if(exec, first, last, std::back_inserter(P_reduced),
         [&p1, &p2](const point_t& pnt) {
         return cross_product(p1, p2, pnt) > 0;
     });
 
-    if ((end - P_reduced.cbegin()) < 2) {
+    if (P_reduced.size() < 2) {
         //Add points into the hull
         H.push_back(p1);
-        H.insert(H.end(), P_reduced.cbegin(), end);
+        H.insert(H.end(), P_reduced.cbegin(), P_reduced.cend());
     }
     else {
         //Find the farthest point from the segment [p1,p1], it will be in the convex hull
-        auto far_point = *std::max_element(exec, P_reduced.cbegin(), end,
+        auto far_point = *std::max_element(exec, P_reduced.cbegin(), P_reduced.cend(),
             [&p1, &p2](const point_t & pnt1, const point_t & pnt2) {
             double how_far1 = cross_product(p1, p2, pnt1);
             double how_far2 = cross_product(p1, p2, pnt2);
             return how_far1 == how_far2 ? pnt1 < pnt2 : how_far1 < how_far2;
         });
 
-        //Repeat for segments [p1, far_point] and [far_point, p2] with points from [P_reduced.cbegin(), end-1]
-        divide_and_conquer(exec, P_reduced.cbegin(), end, H, p1, far_point, p2);
+        //Repeat for segments [p1, far_point] and [far_point, p2] with points from [P_reduced.cbegin(), P_reduced.cend()-1]
+        divide_and_conquer(exec, P_reduced.cbegin(), P_reduced.cend(), H, p1, far_point, p2);
     }
 }
 
@@ -0,0 +1,204 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_coroutine_H
+#define __PSTL_coroutine_H
+
+#include <iterator>
+#include <type_traits>
+
+#include "internal/pstl_config.h"
+
+#if !__PSTL_CPP20_COROUTINES_PRESENT
+#error pstl/coroutine.h requires C++20 coroutines
+#endif
+
+#include "execution"
+#include "algorithm"
+#include "numeric"
+#include "internal/coroutine_impl.h"
+
+// Variants of the parallel algorithms for coroutines: co_await co::reduce(par, __first, __last) suspends the
+// coroutine while a worker thread runs the algorithm and resumes it with the result, so that the thread of the
+// coroutine goes on with other work meanwhile. co_await co::sort(par, __first, __last).via(__executor) resumes
+// the coroutine through __executor.execute(__resume), e.g. on the thread of an event loop. The arguments are
+// copied when the function is called; the algorithm starts when the coroutine awaits it.
+
+namespace __pstl {
+namespace co {
+
+// [alg.foreach]
+
+template<class _ExecutionPolicy, class _ForwardIterator, class _Function>
+auto
+for_each(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, _Function __f) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { std::for_each(__policy, __first, __last, __f); });
+}
+
+// [alg.find]
+
+template<class _ExecutionPolicy, class _ForwardIterator, class _Predicate>
+auto
+find_if(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, _Predicate __pred) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::find_if(__policy, __first, __last, __pred); });
+}
+
+// [alg.count]
+
+template<class _ExecutionPolicy, class _ForwardIterator, class _Predicate>
+auto
+count_if(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, _Predicate __pred) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::count_if(__policy, __first, __last, __pred); });
+}
+
+// [alg.copy]
+
+template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2>
+auto
+copy(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __result) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::copy(__policy, __first, __last, __result); });
+}
+
+template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _Predicate>
+auto
+copy_if(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __result, _Predicate __pred) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::copy_if(__policy, __first, __last, __result, __pred); });
+}
+
+// [alg.transform]
+
+template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _UnaryOperation>
+auto
+transform(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __result,
+          _UnaryOperation __op) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::transform(__policy, __first, __last, __result, __op); });
+}
+
+template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _ForwardIterator, class _BinaryOperation>
+auto
+transform(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2,
+          _ForwardIterator __result, _BinaryOperation __op) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::transform(__policy, __first1, __last1, __first2, __result, __op); });
+}
+
+// [alg.fill]
+
+template<class _ExecutionPolicy, class _ForwardIterator, class _Tp>
+auto
+fill(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, const _Tp& __value) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    _Tp __v(__value);
+    return internal::co_launch([=]() { std::fill(__policy, __first, __last, __v); });
+}
+
+// [alg.sort]
+
+template<class _ExecutionPolicy, class _RandomAccessIterator, class _Compare>
+auto
+sort(_ExecutionPolicy&& __exec, _RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { std::sort(__policy, __first, __last, __comp); });
+}
+
+template<class _ExecutionPolicy, class _RandomAccessIterator>
+auto
+sort(_ExecutionPolicy&& __exec, _RandomAccessIterator __first, _RandomAccessIterator __last) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { std::sort(__policy, __first, __last); });
+}
+
+// [stable.sort]
+
+template<class _ExecutionPolicy, class _RandomAccessIterator, class _Compare>
+auto
+stable_sort(_ExecutionPolicy&& __exec, _RandomAccessIterator __first, _RandomAccessIterator __last, _Compare __comp) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { std::stable_sort(__policy, __first, __last, __comp); });
+}
+
+template<class _ExecutionPolicy, class _RandomAccessIterator>
+auto
+stable_sort(_ExecutionPolicy&& __exec, _RandomAccessIterator __first, _RandomAccessIterator __last) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { std::stable_sort(__policy, __first, __last); });
+}
+
+// [reduce]
+
+template<class _ExecutionPolicy, class _ForwardIterator, class _Tp, class _BinaryOperation>
+auto
+reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, _Tp __init, _BinaryOperation __binary_op) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::reduce(__policy, __first, __last, __init, __binary_op); });
+}
+
+template<class _ExecutionPolicy, class _ForwardIterator, class _Tp>
+auto
+reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, _Tp __init) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::reduce(__policy, __first, __last, __init); });
+}
+
+template<class _ExecutionPolicy, class _ForwardIterator>
+auto
+reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::reduce(__policy, __first, __last); });
+}
+
+// [transform.reduce]
+
+template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _Tp>
+auto
+transform_reduce(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _Tp __init) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() { return std::transform_reduce(__policy, __first1, __last1, __first2, __init); });
+}
+
+template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _Tp, class _BinaryOperation1, class _BinaryOperation2>
+auto
+transform_reduce(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _Tp __init,
+                 _BinaryOperation1 __binary_op1, _BinaryOperation2 __binary_op2) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() {
+        return std::transform_reduce(__policy, __first1, __last1, __first2, __init, __binary_op1, __binary_op2);
+    });
+}
+
+template<class _ExecutionPolicy, class _ForwardIterator, class _Tp, class _BinaryOperation, class _UnaryOperation>
+auto
+transform_reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, _Tp __init,
+                 _BinaryOperation __binary_op, _UnaryOperation __unary_op) {
+    typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+    return internal::co_launch([=]() {
+        return std::transform_reduce(__policy, __first, __last, __init, __binary_op, __unary_op);
+    });
+}
+
+} // namespace co
+} // namespace __pstl
+
+#endif /* __PSTL_coroutine_H */
@@ -0,0 +1,431 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_dataflow_H
+#define __PSTL_dataflow_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "execution"
+#include "algorithm"
+#include "numeric"
+#include "internal/dataflow_impl.h"
+
+// Graphs of parallel algorithm calls that run without a full barrier after each call:
+//
+//     dataflow::graph __g;
+//     __g.transform(par, __a.begin(), __a.end(), __b.begin(), __f);
+//     __g.for_each(par, __b.begin(), __b.end(), __h);              // fused with the transform, chunk by chunk
+//     __g.sort(par, __c.begin(), __c.end());                        // independent of both, runs concurrently
+//     auto __u = __g.unique(par, __c.begin(), __c.end());
+//     auto __s = __g.reduce(par, __c.begin(), __u, 0);             // waits for unique, up to its result
+//     __g.run();                                                    // __s.get() is now the sum
+//
+// A call records a node and returns at once; run() runs the nodes recorded since the last run() and returns
+// when all of them have completed. The sequences passed to the nodes must stay alive until then.
+
+namespace __pstl {
+namespace dataflow {
+
+class graph {
+    std::vector<std::unique_ptr<internal::dataflow_node>> _M_nodes;
+    //! For each node, the nodes it waits for
+    std::vector<std::vector<std::size_t>> _M_before;
+    //! Number of the first node of _M_nodes; the nodes of earlier runs have completed
+    std::size_t _M_base;
+
+    graph(const graph&) = delete;
+    void operator=(const graph&) = delete;
+
+    //! The nodes that __node must wait for
+    std::vector<std::size_t> predecessors(const internal::dataflow_node& __node) const {
+        std::vector<std::size_t> __before;
+        for (std::size_t __i = 0; __i < _M_nodes.size(); ++__i)
+            if (__node.conflicts(*_M_nodes[__i]) ||
+                std::find(__node._M_after.begin(), __node._M_after.end(), _M_base + __i) != __node._M_after.end())
+                __before.push_back(__i);
+        return __before;
+    }
+
+    //! Record __node; returns its number
+    std::size_t add(std::unique_ptr<internal::dataflow_node> __node) {
+        _M_before.push_back(predecessors(*__node));
+        _M_nodes.push_back(std::move(__node));
+        return _M_base + _M_nodes.size() - 1;
+    }
+
+    //! Record __node, or fuse it into the element-wise node it depends on; returns the number of the node running it
+    std::size_t add(std::unique_ptr<internal::dataflow_elementwise_node> __node) {
+        std::vector<std::size_t> __before = predecessors(*__node);
+        if (__before.size() == 1) {
+            internal::dataflow_elementwise_node* __prev = _M_nodes[__before[0]]->elementwise();
+            if (__prev && __prev->can_fuse(*__node)) {
+                __prev->fuse(*__node);
+                return _M_base + __before[0];
+            }
+        }
+        _M_before.push_back(std::move(__before));
+        _M_nodes.push_back(std::move(__node));
+        return _M_base + _M_nodes.size() - 1;
+    }
+
+    template<typename _Tp>
+    std::shared_ptr<internal::dataflow_slot<_Tp>> slot(_Tp __bound) {
+        return std::make_shared<internal::dataflow_slot<_Tp>>(0, __bound);
+    }
+
+    template<typename _Tp>
+    result<_Tp> add(std::unique_ptr<internal::dataflow_node> __node, std::shared_ptr<internal::dataflow_slot<_Tp>> __slot) {
+        __slot->_M_node = add(std::move(__node));
+        return result<_Tp>(std::move(__slot));
+    }
+
+    template<typename _ExecutionPolicy>
+    std::unique_ptr<internal::dataflow_elementwise_node> elementwise_node(std::size_t __size) {
+        return std::unique_ptr<internal::dataflow_elementwise_node>(
+            new internal::dataflow_elementwise_node(__size, internal::allow_parallel<_ExecutionPolicy>::value));
+    }
+
+public:
+    graph() : _M_base(0) {}
+
+    //! Run the nodes recorded since the last run, each once the nodes it depends on have completed
+    void run() {
+        std::vector<std::pair<std::size_t, std::size_t>> __edges;
+        for (std::size_t __j = 0; __j < _M_before.size(); ++__j)
+            for (std::size_t __i: _M_before[__j])
+                __edges.emplace_back(__i, __j);
+        par_backend::parallel_graph(_M_nodes.size(), __edges, [this](std::size_t __i) { _M_nodes[__i]->run(); });
+        _M_base += _M_nodes.size();
+        _M_nodes.clear();
+        _M_before.clear();
+    }
+
+    // [alg.foreach]
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Function>
+    internal::enable_if_execution_policy<_ExecutionPolicy, void>
+    for_each(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, _Function __f) {
+        for_each(std::forward<_ExecutionPolicy>(__exec), __first, __last, __f,
+                 internal::is_dataflow_elementwise<_Last, _ForwardIterator>());
+    }
+
+    // [alg.fill]
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Tp>
+    internal::enable_if_execution_policy<_ExecutionPolicy, void>
+    fill(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, const _Tp& __value) {
+        fill(std::forward<_ExecutionPolicy>(__exec), __first, __last, __value,
+             internal::is_dataflow_elementwise<_Last, _ForwardIterator>());
+    }
+
+    // [alg.copy]
+
+    template<class _ExecutionPolicy, class _ForwardIterator1, class _Last, class _ForwardIterator2>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_ForwardIterator2>>
+    copy(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _Last __last, _ForwardIterator2 __result) {
+        return transform(std::forward<_ExecutionPolicy>(__exec), __first, __last, __result, internal::no_op());
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator1, class _Last, class _ForwardIterator2, class _Predicate>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_ForwardIterator2>>
+    copy_if(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _Last __last, _ForwardIterator2 __result, _Predicate __pred) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::shared_ptr<internal::dataflow_slot<_ForwardIterator2>> __slot =
+            slot(internal::dataflow_along(__first, internal::dataflow_bound(__last), __result));
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            __slot->_M_value.set([&]() { return std::copy_if(__policy, __first, internal::dataflow_get(__last), __result, __pred); });
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), false);
+        __node->touch_along(__first, internal::dataflow_bound(__last), __result, true);
+        internal::dataflow_after(*__node, __last);
+        return add(std::move(__node), __slot);
+    }
+
+    // [alg.transform]
+
+    template<class _ExecutionPolicy, class _ForwardIterator1, class _Last, class _ForwardIterator2, class _UnaryOperation>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_ForwardIterator2>>
+    transform(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _Last __last, _ForwardIterator2 __result, _UnaryOperation __op) {
+        return transform(std::forward<_ExecutionPolicy>(__exec), __first, __last, __result, __op,
+                         internal::is_dataflow_elementwise<_Last, _ForwardIterator1, _ForwardIterator2>());
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator1, class _Last, class _ForwardIterator2, class _ForwardIterator,
+             class _BinaryOperation>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_ForwardIterator>>
+    transform(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _Last __last1, _ForwardIterator2 __first2,
+              _ForwardIterator __result, _BinaryOperation __op) {
+        return transform(std::forward<_ExecutionPolicy>(__exec), __first1, __last1, __first2, __result, __op,
+                         internal::is_dataflow_elementwise<_Last, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>());
+    }
+
+    // [alg.sort]
+
+    template<class _ExecutionPolicy, class _RandomAccessIterator, class _Last, class _Compare>
+    internal::enable_if_execution_policy<_ExecutionPolicy, void>
+    sort(_ExecutionPolicy&& __exec, _RandomAccessIterator __first, _Last __last, _Compare __comp) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            std::sort(__policy, __first, internal::dataflow_get(__last), __comp);
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), true);
+        internal::dataflow_after(*__node, __last);
+        add(std::move(__node));
+    }
+
+    template<class _ExecutionPolicy, class _RandomAccessIterator, class _Last>
+    internal::enable_if_execution_policy<_ExecutionPolicy, void>
+    sort(_ExecutionPolicy&& __exec, _RandomAccessIterator __first, _Last __last) {
+        typedef typename std::iterator_traits<_RandomAccessIterator>::value_type _InputType;
+        sort(std::forward<_ExecutionPolicy>(__exec), __first, __last, std::less<_InputType>());
+    }
+
+    // [alg.unique]
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _BinaryPredicate>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_ForwardIterator>>
+    unique(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, _BinaryPredicate __pred) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::shared_ptr<internal::dataflow_slot<_ForwardIterator>> __slot = slot<_ForwardIterator>(internal::dataflow_bound(__last));
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            __slot->_M_value.set([&]() { return std::unique(__policy, __first, internal::dataflow_get(__last), __pred); });
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), true);
+        internal::dataflow_after(*__node, __last);
+        return add(std::move(__node), __slot);
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_ForwardIterator>>
+    unique(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last) {
+        typedef typename std::iterator_traits<_ForwardIterator>::value_type _InputType;
+        return unique(std::forward<_ExecutionPolicy>(__exec), __first, __last, std::equal_to<_InputType>());
+    }
+
+    // [alg.count]
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Predicate>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<typename std::iterator_traits<_ForwardIterator>::difference_type>>
+    count_if(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, _Predicate __pred) {
+        typedef typename std::iterator_traits<_ForwardIterator>::difference_type _DifferenceType;
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::shared_ptr<internal::dataflow_slot<_DifferenceType>> __slot = slot(_DifferenceType(0));
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            __slot->_M_value.set([&]() { return std::count_if(__policy, __first, internal::dataflow_get(__last), __pred); });
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), false);
+        internal::dataflow_after(*__node, __last);
+        return add(std::move(__node), __slot);
+    }
+
+    // [reduce]
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Tp, class _BinaryOperation>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_Tp>>
+    reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, _Tp __init, _BinaryOperation __binary_op) {
+        return transform_reduce(std::forward<_ExecutionPolicy>(__exec), __first, __last, __init, __binary_op,
+                                internal::no_op());
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Tp>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_Tp>>
+    reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, _Tp __init) {
+        return transform_reduce(std::forward<_ExecutionPolicy>(__exec), __first, __last, __init, std::plus<_Tp>(),
+                                internal::no_op());
+    }
+
+    // [transform.reduce]
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Tp, class _BinaryOperation, class _UnaryOperation>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_Tp>>
+    transform_reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, _Tp __init,
+                     _BinaryOperation __binary_op, _UnaryOperation __unary_op) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::shared_ptr<internal::dataflow_slot<_Tp>> __slot = slot(__init);
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            __slot->_M_value.set([&]() {
+                return std::transform_reduce(__policy, __first, internal::dataflow_get(__last), __init, __binary_op, __unary_op);
+            });
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), false);
+        internal::dataflow_after(*__node, __last);
+        return add(std::move(__node), __slot);
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator1, class _Last, class _ForwardIterator2, class _Tp,
+             class _BinaryOperation1, class _BinaryOperation2>
+    internal::enable_if_execution_policy<_ExecutionPolicy, result<_Tp>>
+    transform_reduce(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _Last __last1, _ForwardIterator2 __first2, _Tp __init,
+                     _BinaryOperation1 __binary_op1, _BinaryOperation2 __binary_op2) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::shared_ptr<internal::dataflow_slot<_Tp>> __slot = slot(__init);
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            __slot->_M_value.set([&]() {
+                return std::transform_reduce(__policy, __first1, internal::dataflow_get(__last1), __first2, __init,
+                                             __binary_op1, __binary_op2);
+            });
+        });
+        __node->touch(__first1, internal::dataflow_bound(__last1), false);
+        __node->touch_along(__first1, internal::dataflow_bound(__last1), __first2, false);
+        internal::dataflow_after(*__node, __last1);
+        return add(std::move(__node), __slot);
+    }
+
+private:
+    // The element-wise algorithms record an element-wise node if the end of their sequence is known, and
+    // else a call like the other algorithms.
+
+    template<class _ExecutionPolicy, class _RandomAccessIterator, class _Function>
+    void for_each(_ExecutionPolicy&&, _RandomAccessIterator __first, _RandomAccessIterator __last, _Function __f,
+                  /*is_elementwise=*/ std::true_type) {
+        typedef internal::dataflow_stage_policy<_ExecutionPolicy> _StagePolicy;
+        std::unique_ptr<internal::dataflow_elementwise_node> __node = elementwise_node<_ExecutionPolicy>(__last - __first);
+        __node->_M_stages.push_back(internal::make_dataflow_stage([__first, __f](std::size_t __i, std::size_t __j) {
+            const _StagePolicy __stage_policy{};
+            std::for_each(__stage_policy, __first + __i, __first + __j, __f);
+        }));
+        __node->touch(__first, __last, true);
+        add(std::move(__node));
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Function>
+    void for_each(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, _Function __f,
+                  /*is_elementwise=*/ std::false_type) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            std::for_each(__policy, __first, internal::dataflow_get(__last), __f);
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), true);
+        internal::dataflow_after(*__node, __last);
+        add(std::move(__node));
+    }
+
+    template<class _ExecutionPolicy, class _RandomAccessIterator, class _Tp>
+    void fill(_ExecutionPolicy&&, _RandomAccessIterator __first, _RandomAccessIterator __last, const _Tp& __value,
+              /*is_elementwise=*/ std::true_type) {
+        typedef internal::dataflow_stage_policy<_ExecutionPolicy> _StagePolicy;
+        std::unique_ptr<internal::dataflow_elementwise_node> __node = elementwise_node<_ExecutionPolicy>(__last - __first);
+        _Tp __v(__value);
+        __node->_M_stages.push_back(internal::make_dataflow_stage([__first, __v](std::size_t __i, std::size_t __j) {
+            const _StagePolicy __stage_policy{};
+            std::fill(__stage_policy, __first + __i, __first + __j, __v);
+        }));
+        __node->touch(__first, __last, true);
+        add(std::move(__node));
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator, class _Last, class _Tp>
+    void fill(_ExecutionPolicy&& __exec, _ForwardIterator __first, _Last __last, const _Tp& __value,
+              /*is_elementwise=*/ std::false_type) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        _Tp __v(__value);
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            std::fill(__policy, __first, internal::dataflow_get(__last), __v);
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), true);
+        internal::dataflow_after(*__node, __last);
+        add(std::move(__node));
+    }
+
+    template<class _ExecutionPolicy, class _RandomAccessIterator1, class _RandomAccessIterator2, class _UnaryOperation>
+    result<_RandomAccessIterator2>
+    transform(_ExecutionPolicy&&, _RandomAccessIterator1 __first, _RandomAccessIterator1 __last, _RandomAccessIterator2 __result,
+              _UnaryOperation __op, /*is_elementwise=*/ std::true_type) {
+        typedef internal::dataflow_stage_policy<_ExecutionPolicy> _StagePolicy;
+        std::unique_ptr<internal::dataflow_elementwise_node> __node = elementwise_node<_ExecutionPolicy>(__last - __first);
+        __node->_M_stages.push_back(internal::make_dataflow_stage([__first, __result, __op](std::size_t __i, std::size_t __j) {
+            const _StagePolicy __stage_policy{};
+            std::transform(__stage_policy, __first + __i, __first + __j, __result + __i, __op);
+        }));
+        __node->touch(__first, __last, false);
+        __node->touch_along(__first, __last, __result, true);
+        // The end of the output is known already
+        std::shared_ptr<internal::dataflow_slot<_RandomAccessIterator2>> __slot = slot(__result + (__last - __first));
+        __slot->_M_value.set([&__slot]() { return __slot->_M_bound; });
+        __slot->_M_node = add(std::move(__node));
+        return result<_RandomAccessIterator2>(std::move(__slot));
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator1, class _Last, class _ForwardIterator2, class _UnaryOperation>
+    result<_ForwardIterator2>
+    transform(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _Last __last, _ForwardIterator2 __result,
+              _UnaryOperation __op, /*is_elementwise=*/ std::false_type) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::shared_ptr<internal::dataflow_slot<_ForwardIterator2>> __slot =
+            slot(internal::dataflow_along(__first, internal::dataflow_bound(__last), __result));
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            __slot->_M_value.set([&]() { return std::transform(__policy, __first, internal::dataflow_get(__last), __result, __op); });
+        });
+        __node->touch(__first, internal::dataflow_bound(__last), false);
+        __node->touch_along(__first, internal::dataflow_bound(__last), __result, true);
+        internal::dataflow_after(*__node, __last);
+        return add(std::move(__node), __slot);
+    }
+
+    template<class _ExecutionPolicy, class _RandomAccessIterator1, class _RandomAccessIterator2, class _RandomAccessIterator,
+             class _BinaryOperation>
+    result<_RandomAccessIterator>
+    transform(_ExecutionPolicy&&, _RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2,
+              _RandomAccessIterator __result, _BinaryOperation __op, /*is_elementwise=*/ std::true_type) {
+        typedef internal::dataflow_stage_policy<_ExecutionPolicy> _StagePolicy;
+        std::unique_ptr<internal::dataflow_elementwise_node> __node = elementwise_node<_ExecutionPolicy>(__last1 - __first1);
+        __node->_M_stages.push_back(internal::make_dataflow_stage([__first1, __first2, __result, __op](std::size_t __i, std::size_t __j) {
+            const _StagePolicy __stage_policy{};
+            std::transform(__stage_policy, __first1 + __i, __first1 + __j, __first2 + __i, __result + __i, __op);
+        }));
+        __node->touch(__first1, __last1, false);
+        __node->touch_along(__first1, __last1, __first2, false);
+        __node->touch_along(__first1, __last1, __result, true);
+        std::shared_ptr<internal::dataflow_slot<_RandomAccessIterator>> __slot = slot(__result + (__last1 - __first1));
+        __slot->_M_value.set([&__slot]() { return __slot->_M_bound; });
+        __slot->_M_node = add(std::move(__node));
+        return result<_RandomAccessIterator>(std::move(__slot));
+    }
+
+    template<class _ExecutionPolicy, class _ForwardIterator1, class _Last, class _ForwardIterator2, class _ForwardIterator,
+             class _BinaryOperation>
+    result<_ForwardIterator>
+    transform(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _Last __last1, _ForwardIterator2 __first2,
+              _ForwardIterator __result, _BinaryOperation __op, /*is_elementwise=*/ std::false_type) {
+        typename std::decay<_ExecutionPolicy>::type __policy(std::forward<_ExecutionPolicy>(__exec));
+        std::shared_ptr<internal::dataflow_slot<_ForwardIterator>> __slot =
+            slot(internal::dataflow_along(__first1, internal::dataflow_bound(__last1), __result));
+        std::unique_ptr<internal::dataflow_node> __node = internal::make_dataflow_call([=]() {
+            __slot->_M_value.set([&]() {
+                return std::transform(__policy, __first1, internal::dataflow_get(__last1), __first2, __result, __op);
+            });
+        });
+        __node->touch(__first1, internal::dataflow_bound(__last1), false);
+        __node->touch_along(__first1, internal::dataflow_bound(__last1), __first2, false);
+        __node->touch_along(__first1, internal::dataflow_bound(__last1), __result, true);
+        internal::dataflow_after(*__node, __last1);
+        return add(std::move(__node), __slot);
+    }
+};
+
+} // namespace dataflow
+} // namespace __pstl
+
+#endif /* __PSTL_dataflow_H */
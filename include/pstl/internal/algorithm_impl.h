@@ -26,9 +26,11 @@
 #include <utility>
 #include <functional>
 #include <algorithm>
+#include <cstring>
 
 #include "execution_impl.h"
 #include "memory_impl.h"
+#include "output_impl.h"
 #include "unseq_backend_simd.h"
 #include "bricks_impl.h"
 
@@ -36,6 +38,8 @@
     #include "parallel_backend.h"
 #endif
 #include "parallel_impl.h"
+#include "parallel_forward_impl.h"
+#include "parallel_input_impl.h"
 
 namespace __pstl {
 namespace internal {
@@ -70,6 +74,53 @@ bool pattern_any_of( _ForwardIterator __first, _ForwardIterator __last, _Pred __
     });
 }
 
+template<class _ForwardIterator, class _Pred, class _IsVector, class _IsParallel>
+bool pattern_any_of( _ForwardIterator __first, _ForwardIterator __last, _Pred __pred, _IsVector __is_vector, _IsParallel __is_parallel,
+                     /*traversal=*/direct_traversal_tag ) {
+    return internal::pattern_any_of( __first, __last, __pred, __is_vector, __is_parallel );
+}
+
+template<class _ForwardIterator, class _Pred, class _IsVector>
+bool pattern_any_of( _ForwardIterator __first, _ForwardIterator __last, _Pred __pred, _IsVector, /*parallel=*/std::false_type,
+                     /*traversal=*/checkpoint_traversal_tag ) {
+    const checkpoint_table<_ForwardIterator> __table(__first, __last);
+    return internal::pattern_any_of( internal::checkpoint_begin(__table), internal::checkpoint_end(__table), __pred,
+                                     /*is_vector=*/std::false_type(), /*parallel=*/std::true_type() );
+}
+
+template<class _SegmentedIterator, class _Pred, class _IsVector>
+bool pattern_any_of( _SegmentedIterator __first, _SegmentedIterator __last, _Pred __pred, _IsVector __is_vector, /*parallel=*/std::false_type,
+                     /*traversal=*/segment_traversal_tag ) noexcept {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    for (_SegmentIterator __s = __r.segments_begin(); __s != __r.segments_end(); ++__s)
+        if (internal::brick_any_of(__r.begin(__s), __r.end(__s), __pred, __is_vector))
+            return true;
+    return false;
+}
+
+template<class _SegmentedIterator, class _Pred, class _IsVector>
+bool pattern_any_of( _SegmentedIterator __first, _SegmentedIterator __last, _Pred __pred, _IsVector __is_vector, /*parallel=*/std::true_type,
+                     /*traversal=*/segment_traversal_tag ) {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    return internal::except_handler([&]() {
+        return internal::parallel_or( __r.segments_begin(), __r.segments_end(),
+            [&__r, __pred, __is_vector]( _SegmentIterator __i, _SegmentIterator __j) {
+                for (; __i != __j; ++__i)
+                    if (internal::brick_any_of(__r.begin(__i), __r.end(__i), __pred, __is_vector))
+                        return true;
+                return false;
+            });
+    });
+}
+
+template<class _InputIterator, class _Pred, class _IsVector, class _IsParallel, bool _IsBatchVector>
+bool pattern_any_of( _InputIterator __first, _InputIterator __last, _Pred __pred, _IsVector __is_vector, _IsParallel __is_parallel,
+                     /*traversal=*/pipeline_traversal_tag<_IsBatchVector> ) {
+    return internal::pattern_any_of( __first, __last, __pred, __is_vector, __is_parallel );
+}
+
 
 // [alg.foreach]
 // for_each_n with no policy
@@ -113,6 +164,57 @@ void pattern_walk1( _ForwardIterator __first, _ForwardIterator __last, _Function
     });
 }
 
+template<class _ForwardIterator, class _Function, class _IsVector, class _IsParallel>
+void pattern_walk1( _ForwardIterator __first, _ForwardIterator __last, _Function __f, _IsVector __is_vector,
+                    _IsParallel __is_parallel, /*traversal=*/direct_traversal_tag ) {
+    internal::pattern_walk1( __first, __last, __f, __is_vector, __is_parallel );
+}
+
+template<class _ForwardIterator, class _Function, class _IsVector>
+void pattern_walk1( _ForwardIterator __first, _ForwardIterator __last, _Function __f, _IsVector,
+                    /*parallel=*/std::false_type, /*traversal=*/checkpoint_traversal_tag ) {
+    const checkpoint_table<_ForwardIterator> __table(__first, __last);
+    internal::pattern_walk1( internal::checkpoint_begin(__table), internal::checkpoint_end(__table), __f,
+                             /*is_vector=*/std::false_type(), /*parallel=*/std::true_type() );
+}
+
+template<class _SegmentedIterator, class _Function, class _IsVector>
+void pattern_walk1( _SegmentedIterator __first, _SegmentedIterator __last, _Function __f, _IsVector __is_vector,
+                    /*parallel=*/std::false_type, /*traversal=*/segment_traversal_tag ) noexcept {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    for (_SegmentIterator __s = __r.segments_begin(); __s != __r.segments_end(); ++__s)
+        internal::brick_walk1( __r.begin(__s), __r.end(__s), __f, __is_vector );
+}
+
+template<class _SegmentedIterator, class _Function, class _IsVector>
+void pattern_walk1( _SegmentedIterator __first, _SegmentedIterator __last, _Function __f, _IsVector __is_vector,
+                    /*parallel=*/std::true_type, /*traversal=*/segment_traversal_tag ) {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    internal::except_handler([&]() {
+        par_backend::parallel_for( __r.segments_begin(), __r.segments_end(),
+            [&__r, __f, __is_vector](_SegmentIterator __i, _SegmentIterator __j) {
+                for (; __i != __j; ++__i)
+                    internal::brick_walk1( __r.begin(__i), __r.end(__i), __f, __is_vector );
+            });
+    });
+}
+
+template<class _InputIterator, class _Function, class _IsVector, bool _IsBatchVector>
+void pattern_walk1( _InputIterator __first, _InputIterator __last, _Function __f, _IsVector,
+                    /*parallel=*/std::false_type, /*traversal=*/pipeline_traversal_tag<_IsBatchVector> ) {
+    typedef typename pipeline_traversal_tag<_IsBatchVector>::is_vector _IsVectorBatch;
+    internal::except_handler([&]() {
+        internal::pipeline_batches( __first, __last,
+            [__f](pipeline_batch<_InputIterator>& __batch) {
+                internal::brick_walk1( __batch.begin(), __batch.end(), __f, _IsVectorBatch() );
+                return true;
+            },
+            [](pipeline_batch<_InputIterator>&, bool) {});
+    });
+}
+
 template<class _ForwardIterator, class _Brick>
 void pattern_walk_brick( _ForwardIterator __first, _ForwardIterator __last, _Brick __brick, /*parallel=*/std::false_type ) noexcept {
     __brick(__first, __last);
@@ -283,6 +385,55 @@ _ForwardIterator2 pattern_walk2(_ForwardIterator1 __first1, _ForwardIterator1 __
     });
 }
 
+template<class _ForwardIterator1, class _ForwardIterator2, class _Function, class _IsVector, class _IsParallel>
+_ForwardIterator2 pattern_walk2(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _Function __f,
+                                _IsVector __is_vector, _IsParallel __is_parallel, /*traversal=*/direct_traversal_tag ) {
+    return internal::pattern_walk2(__first1, __last1, __first2, __f, __is_vector, __is_parallel);
+}
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _Function, class _IsVector>
+_ForwardIterator2 pattern_walk2(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _Function __f,
+                                _IsVector, /*parallel=*/std::false_type, /*traversal=*/checkpoint_traversal_tag ) {
+    checkpoint_table<_ForwardIterator1> __table1;
+    checkpoint_table<_ForwardIterator2> __table2;
+    internal::checkpoint_ranges(__first1, __last1, __first2, __table1, __table2);
+    return internal::pattern_walk2(internal::checkpoint_begin(__table1), internal::checkpoint_end(__table1),
+                                   internal::checkpoint_begin(__table2), __f,
+                                   /*is_vector=*/std::false_type(), /*parallel=*/std::true_type()).base();
+}
+
+template<class _SegmentedIterator, class _RandomAccessIterator, class _Function, class _IsVector>
+_RandomAccessIterator pattern_walk2(_SegmentedIterator __first1, _SegmentedIterator __last1, _RandomAccessIterator __first2, _Function __f,
+                                    _IsVector __is_vector, /*parallel=*/std::false_type, /*traversal=*/segment_traversal_tag ) noexcept {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first1, __last1);
+    for (_SegmentIterator __s = __r.segments_begin(); __s != __r.segments_end(); ++__s)
+        __first2 = internal::brick_walk2(__r.begin(__s), __r.end(__s), __first2, __f, __is_vector);
+    return __first2;
+}
+
+template<class _SegmentedIterator, class _RandomAccessIterator, class _Function, class _IsVector>
+_RandomAccessIterator pattern_walk2(_SegmentedIterator __first1, _SegmentedIterator __last1, _RandomAccessIterator __first2, _Function __f,
+                                    _IsVector __is_vector, /*parallel=*/std::true_type, /*traversal=*/segment_traversal_tag ) {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first1, __last1);
+    return internal::except_handler([&]() {
+        par_backend::parallel_for(__r.segments_begin(), __r.segments_end(),
+            [&__r, __f, __first2, __is_vector](_SegmentIterator __i, _SegmentIterator __j) {
+                for (; __i != __j; ++__i)
+                    internal::brick_walk2(__r.begin(__i), __r.end(__i), __first2 + __r.offset(__i), __f, __is_vector);
+            }
+        );
+        return __first2 + (__last1 - __first1);
+    });
+}
+
+template<class _InputIterator, class _ForwardIterator2, class _Function, class _IsVector, class _IsParallel, bool _IsBatchVector>
+_ForwardIterator2 pattern_walk2(_InputIterator __first1, _InputIterator __last1, _ForwardIterator2 __first2, _Function __f,
+                                _IsVector __is_vector, _IsParallel __is_parallel, /*traversal=*/pipeline_traversal_tag<_IsBatchVector> ) {
+    return internal::pattern_walk2(__first1, __last1, __first2, __f, __is_vector, __is_parallel);
+}
+
 template<class _ForwardIterator1, class _Size, class _ForwardIterator2, class _Function, class _IsVector>
 _ForwardIterator2 pattern_walk2_n( _ForwardIterator1 __first1, _Size n, _ForwardIterator2 __first2, _Function f,
                                    _IsVector is_vector, /*parallel=*/std::false_type ) noexcept {
@@ -404,7 +555,8 @@ _RandomAccessIterator3 pattern_walk3(_RandomAccessIterator1 __first1, _RandomAcc
 //------------------------------------------------------------------------
 
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
-bool brick_equal(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _BinaryPredicate __p, /* IsVector = */ std::false_type) noexcept {
+bool brick_equal(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _BinaryPredicate __p,
+                 /* IsVector = */ std::false_type, /*dispatch=*/std::false_type) noexcept {
     return std::equal(__first1, __last1, __first2, __p);
 }
 
@@ -413,6 +565,20 @@ bool brick_equal(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1
     return unseq_backend::simd_first(__first1, __last1 - __first1, __first2, not_pred<_BinaryPredicate>(__p)).first == __last1;
 }
 
+// The default predicate on contiguous arithmetic sequences runs no user code, so the dispatched
+// compare kernels serve the policies without vectorization too
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _BinaryPredicate>
+bool brick_equal(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _BinaryPredicate __p,
+                 /* IsVector = */ std::false_type, /*dispatch=*/std::true_type) noexcept {
+    return internal::brick_equal(__first1, __last1, __first2, __p, std::true_type());
+}
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
+bool brick_equal(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _BinaryPredicate __p, /* IsVector = */ std::false_type) noexcept {
+    return internal::brick_equal(__first1, __last1, __first2, __p, std::false_type(),
+        typename unseq_backend::is_dispatch_equal_ranges<_ForwardIterator1, _ForwardIterator2, _BinaryPredicate>::type());
+}
+
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate, class _IsVector>
 bool pattern_equal(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _BinaryPredicate __p, _IsVector __is_vector, /* is_parallel = */ std::false_type) noexcept {
     return internal::brick_equal(__first1, __last1, __first2, __p, __is_vector);
@@ -439,9 +605,7 @@ _ForwardIterator brick_find_if(_ForwardIterator __first, _ForwardIterator __last
 
 template<class _RandomAccessIterator, class _Predicate>
 _RandomAccessIterator brick_find_if(_RandomAccessIterator __first, _RandomAccessIterator __last, _Predicate __pred, /*is_vector=*/std::true_type) noexcept {
-    typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _SizeType;
-    return unseq_backend::simd_first(__first, _SizeType(0), __last - __first,
-        [&__pred](_RandomAccessIterator __it, _SizeType __i) {return __pred(__it[__i]); });
+    return unseq_backend::simd_find_if(__first, __last - __first, __pred);
 }
 
 template<class _ForwardIterator, class _Predicate, class _IsVector>
@@ -461,17 +625,281 @@ _ForwardIterator pattern_find_if(_ForwardIterator __first, _ForwardIterator __la
     });
 }
 
+template<class _ForwardIterator, class _Predicate, class _IsVector, class _IsParallel>
+_ForwardIterator pattern_find_if(_ForwardIterator __first, _ForwardIterator __last, _Predicate __pred, _IsVector __is_vector,
+                                 _IsParallel __is_parallel, /*traversal=*/direct_traversal_tag) {
+    return internal::pattern_find_if(__first, __last, __pred, __is_vector, __is_parallel);
+}
+
+template<class _ForwardIterator, class _Predicate, class _IsVector>
+_ForwardIterator pattern_find_if(_ForwardIterator __first, _ForwardIterator __last, _Predicate __pred, _IsVector,
+                                 /*is_parallel=*/std::false_type, /*traversal=*/checkpoint_traversal_tag) {
+    const checkpoint_table<_ForwardIterator> __table(__first, __last);
+    return internal::pattern_find_if(internal::checkpoint_begin(__table), internal::checkpoint_end(__table), __pred,
+                                     /*is_vector=*/std::false_type(), /*is_parallel=*/std::true_type()).base();
+}
+
+template<class _SegmentedIterator, class _Predicate, class _IsVector>
+_SegmentedIterator pattern_find_if(_SegmentedIterator __first, _SegmentedIterator __last, _Predicate __pred, _IsVector __is_vector,
+                                   /*is_parallel=*/std::false_type, /*traversal=*/segment_traversal_tag) noexcept {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    typedef typename segmented_range<_SegmentedIterator>::local_iterator _LocalIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    for (_SegmentIterator __s = __r.segments_begin(); __s != __r.segments_end(); ++__s) {
+        const _LocalIterator __res = internal::brick_find_if(__r.begin(__s), __r.end(__s), __pred, __is_vector);
+        if (__res != __r.end(__s))
+            return __r.compose(__s, __res);
+    }
+    return __last;
+}
+
+template<class _SegmentedIterator, class _Predicate, class _IsVector>
+_SegmentedIterator pattern_find_if(_SegmentedIterator __first, _SegmentedIterator __last, _Predicate __pred, _IsVector __is_vector,
+                                   /*is_parallel=*/std::true_type, /*traversal=*/segment_traversal_tag) {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    return internal::except_handler([&]() {
+        // The first segment with a match, searched again for the match itself
+        const _SegmentIterator __s = internal::parallel_find(__r.segments_begin(), __r.segments_end(),
+            [&__r, __pred, __is_vector](_SegmentIterator __i, _SegmentIterator __j) {
+                for (; __i != __j; ++__i)
+                    if (internal::brick_find_if(__r.begin(__i), __r.end(__i), __pred, __is_vector) != __r.end(__i))
+                        break;
+                return __i;
+            },
+            std::less<typename std::iterator_traits<_SegmentIterator>::difference_type>(), /*is_first=*/true);
+        return __s == __r.segments_end() ? __last
+            : __r.compose(__s, internal::brick_find_if(__r.begin(__s), __r.end(__s), __pred, __is_vector));
+    });
+}
+
+template<class _InputIterator, class _Predicate, class _IsVector, class _IsParallel, bool _IsBatchVector>
+_InputIterator pattern_find_if(_InputIterator __first, _InputIterator __last, _Predicate __pred, _IsVector __is_vector,
+                               _IsParallel __is_parallel, /*traversal=*/pipeline_traversal_tag<_IsBatchVector>) {
+    return internal::pattern_find_if(__first, __last, __pred, __is_vector, __is_parallel);
+}
+
 //------------------------------------------------------------------------
 // find_end
 //------------------------------------------------------------------------
 
+//! Whether search, find_end and find_first_of may compare values instead of calling the predicate:
+//! random access sequences of one integral type and the equality of that type as the predicate
+template<class _Iterator1, class _Iterator2, class _BinaryPredicate,
+         class _Tp = typename std::iterator_traits<_Iterator1>::value_type>
+struct is_search_equal : std::integral_constant<bool, is_random_access_iterator<_Iterator1, _Iterator2>::value &&
+    std::is_integral<_Tp>::value && std::is_same<_Tp, typename std::iterator_traits<_Iterator2>::value_type>::value &&
+    (std::is_same<_BinaryPredicate, pstl_equal>::value || std::is_same<_BinaryPredicate, std::equal_to<_Tp>>::value)> {};
+
+//! Data of the sublinear search engines that depends on the needle only, read first to last or last to first
+template<class _DifferenceType>
+struct search_equal_table {
+    _DifferenceType _M_shift[256]; // Horspool, for bytes: how far the element under the end of the window moves it
+    _DifferenceType _M_ell;        // Two-Way, otherwise: the critical factorization of the needle
+    _DifferenceType _M_per;        // and its period
+    bool _M_periodic;
+};
+
+//! Start of the maximal suffix of [__s, __s + __m) for the order __comp, and the period of that suffix
+template<class _RandomAccessIterator, class _DifferenceType, class _Compare>
+_DifferenceType maximal_suffix(_RandomAccessIterator __s, _DifferenceType __m, _Compare __comp, _DifferenceType& __period) noexcept {
+    _DifferenceType __ms = -1, __j = 0, __k = 1;
+    __period = 1;
+    while (__j + __k < __m) {
+        const auto __a = __s[__j + __k];
+        const auto __b = __s[__ms + __k];
+        if (__comp(__a, __b)) {
+            __j += __k;
+            __k = 1;
+            __period = __j - __ms;
+        }
+        else if (__a == __b) {
+            if (__k != __period) {
+                ++__k;
+            }
+            else {
+                __j += __period;
+                __k = 1;
+            }
+        }
+        else {
+            __ms = __j;
+            __j = __ms + 1;
+            __k = __period = 1;
+        }
+    }
+    return __ms;
+}
+
+//! Fills __table for the needle [__s_first, __s_last); 1 <= __m
+template<class _RandomAccessIterator2, class _DifferenceType>
+void init_search_equal_table(_RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last, search_equal_table<_DifferenceType>& __table) noexcept {
+    const _DifferenceType __m = __s_last - __s_first;
+    // The skip table of Horspool is indexed by the value, so it is used for bytes only
+    if (sizeof(typename std::iterator_traits<_RandomAccessIterator2>::value_type) == 1) {
+        std::fill(__table._M_shift, __table._M_shift + 256, __m);
+        for (_DifferenceType __j = 0; __j + 1 < __m; ++__j)
+            __table._M_shift[static_cast<unsigned char>(__s_first[__j])] = __m - 1 - __j;
+        return;
+    }
+
+    _DifferenceType __p, __q;
+    const _DifferenceType __i1 = internal::maximal_suffix(__s_first, __m, pstl_less(), __p);
+    const _DifferenceType __i2 = internal::maximal_suffix(__s_first, __m, reorder_pred<pstl_less>(pstl_less()), __q);
+    __table._M_ell = __i1 > __i2 ? __i1 : __i2;
+    __table._M_per = __i1 > __i2 ? __p : __q;
+    __table._M_periodic = std::equal(__s_first, __s_first + __table._M_ell + 1, __s_first + __table._M_per);
+    if (!__table._M_periodic)
+        __table._M_per = (__table._M_ell + 1 > __m - __table._M_ell - 1 ? __table._M_ell + 1 : __m - __table._M_ell - 1) + 1;
+}
+
+//! Boyer-Moore-Horspool search of [__s_first, __s_last) in [__first, __last) for a byte type; 1 <= __m <= __n.
+/** The element under the last position of the window determines how far the window moves. */
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _DifferenceType>
+_RandomAccessIterator1 search_horspool(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+                                       _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+                                       const search_equal_table<_DifferenceType>& __table) noexcept {
+    const _DifferenceType __n = __last - __first;
+    const _DifferenceType __m = __s_last - __s_first;
+    const auto __back = __s_first[__m - 1];
+    for (_DifferenceType __i = 0; __i <= __n - __m;) {
+        const auto __x = __first[__i + __m - 1];
+        if (__x == __back && std::equal(__s_first, __s_last - 1, __first + __i))
+            return __first + __i;
+        __i += __table._M_shift[static_cast<unsigned char>(__x)];
+    }
+    return __last;
+}
+
+//! Crochemore-Perrin Two-Way search of [__s_first, __s_last) in [__first, __last); 1 <= __m <= __n.
+/** Linear time and constant space: the needle is split at a critical factorization, the right part is matched
+    left to right and the left part right to left, and a mismatch moves the window past the compared elements. */
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _DifferenceType>
+_RandomAccessIterator1 search_two_way(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+                                      _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+                                      const search_equal_table<_DifferenceType>& __table) noexcept {
+    const _DifferenceType __n = __last - __first;
+    const _DifferenceType __m = __s_last - __s_first;
+    const _DifferenceType __ell = __table._M_ell;
+    const _DifferenceType __per = __table._M_per;
+
+    if (__table._M_periodic) {
+        // Periodic needle: after a match of the right part the already matched prefix is remembered
+        _DifferenceType __memory = -1;
+        for (_DifferenceType __j = 0; __j <= __n - __m;) {
+            _DifferenceType __i = (__ell > __memory ? __ell : __memory) + 1;
+            while (__i < __m && __s_first[__i] == __first[__i + __j])
+                ++__i;
+            if (__i < __m) {
+                __j += __i - __ell;
+                __memory = -1;
+                continue;
+            }
+            __i = __ell;
+            while (__i > __memory && __s_first[__i] == __first[__i + __j])
+                --__i;
+            if (__i <= __memory)
+                return __first + __j;
+            __j += __per;
+            __memory = __m - __per - 1;
+        }
+    }
+    else {
+        for (_DifferenceType __j = 0; __j <= __n - __m;) {
+            _DifferenceType __i = __ell + 1;
+            while (__i < __m && __s_first[__i] == __first[__i + __j])
+                ++__i;
+            if (__i < __m) {
+                __j += __i - __ell;
+                continue;
+            }
+            __i = __ell;
+            while (__i >= 0 && __s_first[__i] == __first[__i + __j])
+                --__i;
+            if (__i < 0)
+                return __first + __j;
+            __j += __per;
+        }
+    }
+    return __last;
+}
+
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _DifferenceType>
+_RandomAccessIterator1 search_equal(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+                                    _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+                                    const search_equal_table<_DifferenceType>& __table) noexcept {
+    if (sizeof(typename std::iterator_traits<_RandomAccessIterator1>::value_type) == 1)
+        return internal::search_horspool(__first, __last, __s_first, __s_last, __table);
+    return internal::search_two_way(__first, __last, __s_first, __s_last, __table);
+}
+
+// Longest needle the SIMD first/last element filter looks for. Every position the filter passes costs a comparison
+// of the whole needle, so longer needles are searched by Horspool or Two-Way, whose cost does not grow with them.
+const std::ptrdiff_t __PSTL_SEARCH_SIMD_MAX = 32;
+
+//! Whether the SIMD first/last element filter searches a needle of __m elements
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _IsVector, class _DifferenceType>
+bool search_equal_by_simd(_DifferenceType __m) noexcept {
+    return _IsVector::value && unseq_backend::is_dispatch_iterator<_RandomAccessIterator1>::value &&
+        unseq_backend::is_dispatch_iterator<_RandomAccessIterator2>::value && __m <= __PSTL_SEARCH_SIMD_MAX;
+}
+
+//! Fills __table for the search of the first (__b_first) or the last occurrence of [__s_first, __s_last), unless
+//! the SIMD filter searches it
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _IsVector, class _DifferenceType>
+void init_search_equal_table(_RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last, bool __b_first,
+                             _IsVector, search_equal_table<_DifferenceType>& __table) noexcept {
+    if (internal::search_equal_by_simd<_RandomAccessIterator1, _RandomAccessIterator2, _IsVector>(__s_last - __s_first))
+        return;
+    if (__b_first) {
+        internal::init_search_equal_table(__s_first, __s_last, __table);
+    }
+    else {
+        typedef std::reverse_iterator<_RandomAccessIterator2> _ReverseIterator2;
+        internal::init_search_equal_table(_ReverseIterator2(__s_last), _ReverseIterator2(__s_first), __table);
+    }
+}
+
+//! First (__b_first) or last occurrence of [__s_first, __s_last) in [__first, __last), or __last; __m >= 1
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _DifferenceType>
+_RandomAccessIterator1 brick_search_equal(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+    _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last, bool __b_first,
+    const search_equal_table<_DifferenceType>& __table, /*dispatch=*/std::false_type) noexcept {
+    const auto __m = __s_last - __s_first;
+    if (__last - __first < __m)
+        return __last;
+    if (__b_first)
+        return internal::search_equal(__first, __last, __s_first, __s_last, __table);
+
+    // The last occurrence is the first occurrence of the reversed needle in the reversed range
+    typedef std::reverse_iterator<_RandomAccessIterator1> _ReverseIterator1;
+    typedef std::reverse_iterator<_RandomAccessIterator2> _ReverseIterator2;
+    const _RandomAccessIterator1 __res = internal::search_equal(_ReverseIterator1(__last), _ReverseIterator1(__first),
+        _ReverseIterator2(__s_last), _ReverseIterator2(__s_first), __table).base();
+    return __res == __first ? __last : __res - __m;
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _DifferenceType>
+_RandomAccessIterator1 brick_search_equal(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+    _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last, bool __b_first,
+    const search_equal_table<_DifferenceType>& __table, /*dispatch=*/std::true_type) noexcept {
+    const auto __m = __s_last - __s_first;
+    if (__last - __first < __m)
+        return __last;
+    if (__m > __PSTL_SEARCH_SIMD_MAX)
+        return internal::brick_search_equal(__first, __last, __s_first, __s_last, __b_first, __table, std::false_type());
+    return unseq_backend::simd_search(__first, __last - __first, __s_first, __m, __b_first);
+}
+#endif
+
 // find the first occurrence of the subsequence [s_first, s_last)
 //   or the  last occurrence of the subsequence in the range [first, last)
 // b_first determines what occurrence we want to find (first or last)
 template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _BinaryPredicate, class _IsVector>
 _RandomAccessIterator1 find_subrange(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
     _RandomAccessIterator1 __global_last, _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
-    _BinaryPredicate __pred, bool __b_first, _IsVector __is_vector) noexcept {
+    _BinaryPredicate __pred, bool __b_first, _IsVector __is_vector, /*is_search_equal=*/std::false_type) noexcept {
     typedef typename std::iterator_traits<_RandomAccessIterator2>::value_type _ValueType;
     auto  __n2 = __s_last - __s_first;
     if (__n2 < 1) {
@@ -514,6 +942,93 @@ _RandomAccessIterator1 find_subrange(_RandomAccessIterator1 __first, _RandomAcce
     return __cur;
 }
 
+// Sublinear engines instead of the element by element scan above: the SIMD first/last element filter for short
+// needles in contiguous sequences under vector policies, Horspool for bytes and Two-Way otherwise. __table is filled
+// by init_search_equal_table; 2 <= __m.
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _IsVector, class _DifferenceType>
+_RandomAccessIterator1 find_subrange(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+    _RandomAccessIterator1 __global_last, _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+    bool __b_first, _IsVector, const search_equal_table<_DifferenceType>& __table) noexcept {
+    const _DifferenceType __n2 = __s_last - __s_first;
+    if (__global_last - __first < __n2) {
+        return __last;
+    }
+
+    // An occurrence has to start in [first, last) but may end in [last, global_last)
+    const _DifferenceType __n1 = std::min<_DifferenceType>(__global_last - __first, (__last - __first) + (__n2 - 1));
+    const auto __res = internal::brick_search_equal(__first, __first + __n1, __s_first, __s_last, __b_first, __table,
+        std::integral_constant<bool, _IsVector::value && unseq_backend::is_dispatch_iterator<_RandomAccessIterator1>::value &&
+                                     unseq_backend::is_dispatch_iterator<_RandomAccessIterator2>::value>());
+    return __res == __first + __n1 ? __last : __res;
+}
+
+// A needle of one element is a plain find.
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _BinaryPredicate, class _IsVector>
+_RandomAccessIterator1 find_subrange(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+    _RandomAccessIterator1 __global_last, _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+    _BinaryPredicate __pred, bool __b_first, _IsVector __is_vector, /*is_search_equal=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_RandomAccessIterator1>::difference_type _DifferenceType;
+    const _DifferenceType __n2 = __s_last - __s_first;
+    if (__n2 < 2 || __global_last - __first < __n2) {
+        return internal::find_subrange(__first, __last, __global_last, __s_first, __s_last, __pred, __b_first, __is_vector,
+                                       std::false_type());
+    }
+    search_equal_table<_DifferenceType> __table;
+    internal::init_search_equal_table<_RandomAccessIterator1>(__s_first, __s_last, __b_first, __is_vector, __table);
+    return internal::find_subrange(__first, __last, __global_last, __s_first, __s_last, __b_first, __is_vector, __table);
+}
+
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _BinaryPredicate, class _IsVector>
+_RandomAccessIterator1 find_subrange(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last,
+    _RandomAccessIterator1 __global_last, _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+    _BinaryPredicate __pred, bool __b_first, _IsVector __is_vector) noexcept {
+    return internal::find_subrange(__first, __last, __global_last, __s_first, __s_last, __pred, __b_first, __is_vector,
+        typename is_search_equal<_RandomAccessIterator1, _RandomAccessIterator2, _BinaryPredicate>::type());
+}
+
+//! Search of a needle in the subranges of a parallel search or find_end, up to __global_last
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _BinaryPredicate, class _IsVector,
+         class _IsSearchEqual = typename is_search_equal<_RandomAccessIterator1, _RandomAccessIterator2, _BinaryPredicate>::type>
+class subrange_finder {
+    _RandomAccessIterator1 _M_global_last;
+    _RandomAccessIterator2 _M_s_first, _M_s_last;
+    _BinaryPredicate _M_pred;
+    bool _M_b_first;
+public:
+    subrange_finder(_RandomAccessIterator1 __global_last, _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+                    _BinaryPredicate __pred, bool __b_first)
+        : _M_global_last(__global_last), _M_s_first(__s_first), _M_s_last(__s_last), _M_pred(__pred), _M_b_first(__b_first) {}
+    _RandomAccessIterator1 operator()(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last) const {
+        return internal::find_subrange(__first, __last, _M_global_last, _M_s_first, _M_s_last, _M_pred, _M_b_first, _IsVector(),
+                                       std::false_type());
+    }
+};
+
+//! The tables of the sublinear engines are built once, not for every subrange
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _BinaryPredicate, class _IsVector>
+class subrange_finder<_RandomAccessIterator1, _RandomAccessIterator2, _BinaryPredicate, _IsVector, std::true_type> {
+    typedef typename std::iterator_traits<_RandomAccessIterator1>::difference_type _DifferenceType;
+    _RandomAccessIterator1 _M_global_last;
+    _RandomAccessIterator2 _M_s_first, _M_s_last;
+    _BinaryPredicate _M_pred;
+    bool _M_b_first;
+    search_equal_table<_DifferenceType> _M_table;
+public:
+    subrange_finder(_RandomAccessIterator1 __global_last, _RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last,
+                    _BinaryPredicate __pred, bool __b_first)
+        : _M_global_last(__global_last), _M_s_first(__s_first), _M_s_last(__s_last), _M_pred(__pred), _M_b_first(__b_first) {
+        if (__s_last - __s_first >= 2)
+            internal::init_search_equal_table<_RandomAccessIterator1>(__s_first, __s_last, __b_first, _IsVector(), _M_table);
+    }
+    _RandomAccessIterator1 operator()(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last) const {
+        if (_M_s_last - _M_s_first < 2) {
+            return internal::find_subrange(__first, __last, _M_global_last, _M_s_first, _M_s_last, _M_pred, _M_b_first, _IsVector(),
+                                           std::false_type());
+        }
+        return internal::find_subrange(__first, __last, _M_global_last, _M_s_first, _M_s_last, _M_b_first, _IsVector(), _M_table);
+    }
+};
+
 template<class _RandomAccessIterator, class _Size, class _Tp, class _BinaryPredicate, class _IsVector>
 _RandomAccessIterator find_subrange(_RandomAccessIterator __first, _RandomAccessIterator __last,
     _RandomAccessIterator __global_last, _Size __count, const _Tp& __value,
@@ -522,32 +1037,43 @@ _RandomAccessIterator find_subrange(_RandomAccessIterator __first, _RandomAccess
         return __last; // According to the standard last shall be returned when count < 1
     }
 
-    auto __n = __global_last - __first;
+    typedef std::reverse_iterator<_RandomAccessIterator> _ReverseIterator;
     auto __unary_pred = internal::equal_value_by_pred<_Tp, _BinaryPredicate>(__value, __pred);
-    while (__first != __last && (__global_last - __first >= __count)) {
-        __first = brick_find_if(__first, __last, __unary_pred, __is_vector);
-
-        // check that all of elements in [first+1, first+count) equal to value
-        if (__first != __last && (__global_last - __first >= __count) &&
-            !internal::brick_any_of(__first + 1, __first + __count,
-                                    internal::not_pred<decltype(__unary_pred)>(__unary_pred), __is_vector)) {
-                return __first;
-        }
-        else if (__first == __last) {
-            break;
-        }
-        else {
-            ++__first;
+    // Each window [first, first + count) is checked from its end: the last element that does not match is where
+    // the next window starts after, and the elements in [first, checked) are already known to match.
+    // So every element is looked at once at most, and a mismatch at the end of a window skips count elements.
+    _RandomAccessIterator __checked = __first;
+    while (__first < __last && __global_last - __first >= __count) {
+        const _RandomAccessIterator __end = __first + __count;
+        const _ReverseIterator __mismatch = internal::brick_find_if(_ReverseIterator(__end), _ReverseIterator(__checked),
+            internal::not_pred<decltype(__unary_pred)>(__unary_pred), __is_vector);
+        if (__mismatch == _ReverseIterator(__checked)) {
+            return __first;
         }
+        __first = __mismatch.base();
+        __checked = __end;
     }
     return __last;
 }
 
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
-_ForwardIterator1 brick_find_end(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*__is_vector=*/std::false_type) noexcept {
+_ForwardIterator1 brick_find_end(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                                 /*__is_vector=*/std::false_type, /*is_search_equal=*/std::false_type) noexcept {
     return std::find_end(__first, __last, __s_first, __s_last, __pred);
 }
 
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
+_ForwardIterator1 brick_find_end(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                                 /*__is_vector=*/std::false_type, /*is_search_equal=*/std::true_type) noexcept {
+    return internal::find_subrange(__first, __last, __last, __s_first, __s_last, __pred, false, std::false_type());
+}
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
+_ForwardIterator1 brick_find_end(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*__is_vector=*/std::false_type) noexcept {
+    return internal::brick_find_end(__first, __last, __s_first, __s_last, __pred, std::false_type(),
+                                    typename is_search_equal<_ForwardIterator1, _ForwardIterator2, _BinaryPredicate>::type());
+}
+
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
 _ForwardIterator1 brick_find_end(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*__is_vector=*/std::true_type) noexcept {
     return internal::find_subrange(__first, __last, __last, __s_first, __s_last, __pred, false, std::true_type());
@@ -566,8 +1092,9 @@ _ForwardIterator1 pattern_find_end(_ForwardIterator1 __first, _ForwardIterator1
     }
     else {
         return except_handler([&]() {
-            return internal::parallel_find(__first, __last, [__first, __last, __s_first, __s_last, __pred, __is_vector](_ForwardIterator1 __i, _ForwardIterator1 __j) {
-                return internal::find_subrange(__i, __j, __last, __s_first, __s_last, __pred, false, __is_vector);
+            const subrange_finder<_ForwardIterator1, _ForwardIterator2, _BinaryPredicate, _IsVector> __finder(__last, __s_first, __s_last, __pred, false);
+            return internal::parallel_find(__first, __last, [&__finder](_ForwardIterator1 __i, _ForwardIterator1 __j) {
+                return __finder(__i, __j);
             },
             std::greater<typename std::iterator_traits<_ForwardIterator1>::difference_type>(), /*is_first=*/false);
         });
@@ -587,18 +1114,133 @@ _ForwardIterator1 brick_find_first_of(_ForwardIterator1 __first, _ForwardIterato
     return unseq_backend::simd_find_first_of(__first, __last, __s_first, __s_last, __pred);
 }
 
+// Most needles find_first_of compares one by one; more are looked up in a sorted copy
+const std::ptrdiff_t __PSTL_FIND_FIRST_OF_LINEAR_MAX = 16;
+// Most needles of the sorted copy, which is kept on the stack
+const std::ptrdiff_t __PSTL_FIND_FIRST_OF_SORTED_MAX = 256;
+
+template<class _RandomAccessIterator, class _IsVector>
+_RandomAccessIterator find_in_byte_set(_RandomAccessIterator __first, _RandomAccessIterator __last, const unsigned char* __set,
+                                       _IsVector __is_vector, /*dispatch=*/std::false_type) noexcept {
+    return internal::brick_find_if(__first, __last, [__set](typename std::iterator_traits<_RandomAccessIterator>::reference __x) {
+        return __set[static_cast<unsigned char>(__x)] != 0;
+    }, __is_vector);
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+template<class _RandomAccessIterator, class _IsVector>
+_RandomAccessIterator find_in_byte_set(_RandomAccessIterator __first, _RandomAccessIterator __last, const unsigned char* __set,
+                                       _IsVector, /*dispatch=*/std::true_type) noexcept {
+    if (__first == __last) {
+        return __last;
+    }
+    return unseq_backend::simd_find_in_byte_set(__first, __last - __first, __set);
+}
+#endif
+
+//! Needles of find_first_of prepared for the lookup of an element.
+/** Bytes: the needles become a 256 entry membership table, so the cost per element does not depend on their number. */
+template<class _Tp, bool _IsByte = sizeof(_Tp) == 1>
+class first_of_set {
+    unsigned char _M_set[256];
+public:
+    //! Whether __m needles are looked up in the set rather than compared one by one
+    static bool applies(std::ptrdiff_t __m) noexcept {
+        // A few needles are compared directly, by the dispatched kernels under a vector policy
+        return __m > 2;
+    }
+    template<class _RandomAccessIterator2>
+    first_of_set(_RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last) noexcept {
+        std::fill(_M_set, _M_set + 256, 0);
+        for (; __s_first != __s_last; ++__s_first)
+            _M_set[static_cast<unsigned char>(*__s_first)] = 1;
+    }
+    template<class _RandomAccessIterator1, class _IsVector>
+    _RandomAccessIterator1 find(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last, _IsVector __is_vector) const noexcept {
+        return internal::find_in_byte_set(__first, __last, _M_set, __is_vector, std::integral_constant<bool,
+            _IsVector::value && unseq_backend::is_dispatch_iterator<_RandomAccessIterator1>::value>());
+    }
+};
+
+//! Wider integers: many needles are binary searched in a sorted copy
+template<class _Tp>
+class first_of_set<_Tp, false> {
+    _Tp _M_set[__PSTL_FIND_FIRST_OF_SORTED_MAX];
+    const _Tp* _M_set_last;
+public:
+    static bool applies(std::ptrdiff_t __m) noexcept {
+        return __m > __PSTL_FIND_FIRST_OF_LINEAR_MAX && __m <= __PSTL_FIND_FIRST_OF_SORTED_MAX;
+    }
+    template<class _RandomAccessIterator2>
+    first_of_set(_RandomAccessIterator2 __s_first, _RandomAccessIterator2 __s_last) noexcept {
+        const auto __m = __s_last - __s_first;
+        std::copy(__s_first, __s_last, _M_set);
+        std::sort(_M_set, _M_set + __m);
+        _M_set_last = std::unique(_M_set, _M_set + __m);
+    }
+    template<class _RandomAccessIterator1, class _IsVector>
+    _RandomAccessIterator1 find(_RandomAccessIterator1 __first, _RandomAccessIterator1 __last, _IsVector __is_vector) const noexcept {
+        const _Tp* __set_first = _M_set;
+        const _Tp* __set_last = _M_set_last;
+        return internal::brick_find_if(__first, __last, [__set_first, __set_last](const _Tp& __x) {
+            return std::binary_search(__set_first, __set_last, __x);
+        }, __is_vector);
+    }
+};
+
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate, class _IsVector>
-_ForwardIterator1 pattern_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, _IsVector __is_vector, /*is_parallel=*/std::false_type) noexcept {
+_ForwardIterator1 brick_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                                      _IsVector __is_vector, /*is_search_equal=*/std::false_type) noexcept {
     return internal::brick_find_first_of(__first, __last, __s_first, __s_last, __pred, __is_vector);
 }
 
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate, class _IsVector>
+_ForwardIterator1 brick_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                                      _IsVector __is_vector, /*is_search_equal=*/std::true_type) noexcept {
+    typedef first_of_set<typename std::iterator_traits<_ForwardIterator1>::value_type> _Set;
+    if (!_Set::applies(__s_last - __s_first)) {
+        return internal::brick_find_first_of(__first, __last, __s_first, __s_last, __pred, __is_vector);
+    }
+    const _Set __set(__s_first, __s_last);
+    return __set.find(__first, __last, __is_vector);
+}
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate, class _IsVector>
+_ForwardIterator1 parallel_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                                         _IsVector __is_vector, /*is_search_equal=*/std::false_type) {
+    return internal::parallel_find(__first, __last, [__s_first, __s_last, __pred, __is_vector](_ForwardIterator1 __i, _ForwardIterator1 __j) {
+        return internal::brick_find_first_of(__i, __j, __s_first, __s_last, __pred, __is_vector);
+    },
+    std::less<typename std::iterator_traits<_ForwardIterator1>::difference_type>(), /*is_first=*/true);
+}
+
+// The set of needles is built once, not for every subrange
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate, class _IsVector>
+_ForwardIterator1 parallel_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                                         _IsVector __is_vector, /*is_search_equal=*/std::true_type) {
+    typedef first_of_set<typename std::iterator_traits<_ForwardIterator1>::value_type> _Set;
+    if (!_Set::applies(__s_last - __s_first)) {
+        return internal::parallel_find_first_of(__first, __last, __s_first, __s_last, __pred, __is_vector, std::false_type());
+    }
+    const _Set __set(__s_first, __s_last);
+    const _Set* __set_ptr = &__set;
+    return internal::parallel_find(__first, __last, [__set_ptr, __is_vector](_ForwardIterator1 __i, _ForwardIterator1 __j) {
+        return __set_ptr->find(__i, __j, __is_vector);
+    },
+    std::less<typename std::iterator_traits<_ForwardIterator1>::difference_type>(), /*is_first=*/true);
+}
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate, class _IsVector>
+_ForwardIterator1 pattern_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, _IsVector __is_vector, /*is_parallel=*/std::false_type) noexcept {
+    return internal::brick_find_first_of(__first, __last, __s_first, __s_last, __pred, __is_vector,
+                                         typename is_search_equal<_ForwardIterator1, _ForwardIterator2, _BinaryPredicate>::type());
+}
+
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate, class _IsVector>
 _ForwardIterator1 pattern_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, _IsVector __is_vector, /*is_parallel=*/std::true_type) noexcept {
     return except_handler([&]() {
-        return internal::parallel_find(__first, __last, [__s_first, __s_last, __pred, __is_vector](_ForwardIterator1 __i, _ForwardIterator1 __j) {
-            return internal::brick_find_first_of(__i, __j, __s_first, __s_last, __pred, __is_vector);
-        },
-        std::less<typename std::iterator_traits<_ForwardIterator1>::difference_type>(), /*is_first=*/true);
+        return internal::parallel_find_first_of(__first, __last, __s_first, __s_last, __pred, __is_vector,
+            typename is_search_equal<_ForwardIterator1, _ForwardIterator2, _BinaryPredicate>::type());
     });
 }
 
@@ -606,10 +1248,23 @@ _ForwardIterator1 pattern_find_first_of(_ForwardIterator1 __first, _ForwardItera
 // search
 //------------------------------------------------------------------------
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
-_ForwardIterator1 brick_search(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*vector=*/std::false_type) noexcept {
+_ForwardIterator1 brick_search(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                               /*vector=*/std::false_type, /*is_search_equal=*/std::false_type) noexcept {
     return std::search(__first, __last, __s_first, __s_last, __pred);
 }
 
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
+_ForwardIterator1 brick_search(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred,
+                               /*vector=*/std::false_type, /*is_search_equal=*/std::true_type) noexcept {
+    return internal::find_subrange(__first, __last, __last, __s_first, __s_last, __pred, true, std::false_type());
+}
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
+_ForwardIterator1 brick_search(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*vector=*/std::false_type) noexcept {
+    return internal::brick_search(__first, __last, __s_first, __s_last, __pred, std::false_type(),
+                                  typename is_search_equal<_ForwardIterator1, _ForwardIterator2, _BinaryPredicate>::type());
+}
+
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
 _ForwardIterator1 brick_search(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first, _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*vector=*/std::true_type) noexcept {
     return internal::find_subrange(__first, __last, __last, __s_first, __s_last, __pred, true, std::true_type());
@@ -628,8 +1283,9 @@ _ForwardIterator1 pattern_search(_ForwardIterator1 __first, _ForwardIterator1 __
     }
     else {
         return except_handler([&]() {
-            return internal::parallel_find(__first, __last, [__last, __s_first, __s_last, __pred, __is_vector](_ForwardIterator1 __i, _ForwardIterator1 __j) {
-                return internal::find_subrange(__i, __j, __last, __s_first, __s_last, __pred, true, __is_vector);
+            const subrange_finder<_ForwardIterator1, _ForwardIterator2, _BinaryPredicate, _IsVector> __finder(__last, __s_first, __s_last, __pred, true);
+            return internal::parallel_find(__first, __last, [&__finder](_ForwardIterator1 __i, _ForwardIterator1 __j) {
+                return __finder(__i, __j);
             },
             std::less<typename std::iterator_traits<_ForwardIterator1>::difference_type>(), /*is_first=*/true);
         });
@@ -656,20 +1312,74 @@ _ForwardIterator pattern_search_n(_ForwardIterator __first, _ForwardIterator __l
 
 template<class _RandomAccessIterator, class _Size, class _Tp, class _BinaryPredicate, class _IsVector>
 _RandomAccessIterator pattern_search_n(_RandomAccessIterator __first, _RandomAccessIterator __last, _Size __count, const _Tp& __value, _BinaryPredicate __pred, _IsVector __is_vector, /*is_parallel=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _DifferenceType;
     if (__last - __first == __count) {
         const bool __result = !internal::pattern_any_of(__first, __last,
             [&__value, &__pred](const _Tp& __val) {return !__pred(__val, __value); },
             __is_vector, /*is_parallel*/ std::true_type());
         return __result ? __first : __last;
     }
-    else {
-        return except_handler([__first, __last, __count, &__value, __pred, __is_vector]() {
-            return internal::parallel_find(__first, __last, [__last, __count, &__value, __pred, __is_vector](_RandomAccessIterator __i, _RandomAccessIterator __j) {
-                return internal::find_subrange(__i, __j, __last, __count, __value, __pred, __is_vector);
-            },
-            std::less<typename std::iterator_traits<_RandomAccessIterator>::difference_type>(), /*is_first=*/true);
-        });
+    if (__last - __first < __count || __count < 1) {
+        return __last;
     }
+
+    // runs of elements equal to value at both ends of a range, and the first occurrence lying entirely in it
+    struct _RunRange {
+        _RandomAccessIterator __begin;
+        _RandomAccessIterator __end;
+        _DifferenceType __lead;
+        _DifferenceType __trail;
+        _RandomAccessIterator __match; // __end if there is none
+    };
+
+    return except_handler([__first, __last, __count, &__value, __pred, __is_vector]() {
+        const _DifferenceType __n = __count;
+        auto __unary_pred = internal::equal_value_by_pred<_Tp, _BinaryPredicate>(__value, __pred);
+        _RunRange __init{ __last, __last, 0, 0, __last };
+
+        // lambda for joining two adjacent ranges: an occurrence not lying in either of them has to be
+        // made of the trailing run of the left range and the leading run of the right one
+        auto __reductor = [__n](const _RunRange& __val1, const _RunRange& __val2)->_RunRange {
+            if (__val1.__begin == __val1.__end) {
+                return __val2;
+            }
+            if (__val2.__begin == __val2.__end) {
+                return __val1;
+            }
+            const _DifferenceType __size1 = __val1.__end - __val1.__begin;
+            const _DifferenceType __size2 = __val2.__end - __val2.__begin;
+            _RandomAccessIterator __match = __val2.__match;
+            if (__val1.__match != __val1.__end) {
+                __match = __val1.__match;
+            }
+            else if (__val1.__trail + __val2.__lead >= __n) {
+                __match = __val1.__end - __val1.__trail;
+            }
+            return { __val1.__begin, __val2.__end,
+                     __val1.__lead == __size1 ? __size1 + __val2.__lead : __val1.__lead,
+                     __val2.__trail == __size2 ? __size2 + __val1.__trail : __val2.__trail, __match };
+        };
+
+        const _RunRange __result = par_backend::parallel_reduce(__first, __last, __init,
+            [__n, &__value, __pred, __unary_pred, __is_vector, __reductor](_RandomAccessIterator __i, _RandomAccessIterator __j, const _RunRange& __range)->_RunRange {
+                // nothing to the right can precede an occurrence found already
+                if (__range.__match != __range.__end) {
+                    return __range;
+                }
+                typedef std::reverse_iterator<_RandomAccessIterator> _ReverseIterator;
+                auto __not_pred = internal::not_pred<decltype(__unary_pred)>(__unary_pred);
+                const _RandomAccessIterator __x = internal::brick_find_if(__i, __j, __not_pred, __is_vector);
+                if (__x == __j) {
+                    return __reductor(__range, { __i, __j, __j - __i, __j - __i, __j - __i >= __n ? __i : __j });
+                }
+                const _RandomAccessIterator __y = internal::brick_find_if(_ReverseIterator(__j), _ReverseIterator(__x), __not_pred, __is_vector).base();
+                const _RandomAccessIterator __match = __x - __i >= __n ? __i :
+                    internal::find_subrange(__x + 1, __j, __j, __n, __value, __pred, __is_vector);
+                return __reductor(__range, { __i, __j, __x - __i, __j - __y, __match });
+            },
+            __reductor);
+        return __result.__match;
+    });
 }
 
 //------------------------------------------------------------------------
@@ -683,10 +1393,7 @@ _OutputIterator brick_copy_n(_ForwardIterator __first, _Size __n, _OutputIterato
 
 template<class _ForwardIterator, class _Size, class _OutputIterator>
 _OutputIterator brick_copy_n(_ForwardIterator __first, _Size __n, _OutputIterator __result, /*vector=*/std::true_type) noexcept {
-    return unseq_backend::simd_assign(__first, __n, __result,
-        [](_ForwardIterator __first, _OutputIterator __result) {
-            *__result = *__first;
-    });
+    return unseq_backend::simd_copy(__first, __n, __result);
 }
 
 //------------------------------------------------------------------------
@@ -699,10 +1406,7 @@ _OutputIterator brick_copy(_ForwardIterator __first, _ForwardIterator __last, _O
 
 template<class _RandomAccessIterator, class _OutputIterator>
 _OutputIterator brick_copy(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __result, /*vector=*/std::true_type) noexcept {
-    return unseq_backend::simd_assign(__first, __last - __first, __result,
-        [](_RandomAccessIterator __first, _OutputIterator __result) {
-            *__result = *__first;
-    });
+    return unseq_backend::simd_copy(__first, __last - __first, __result);
 }
 
 //------------------------------------------------------------------------
@@ -715,10 +1419,7 @@ _OutputIterator brick_move(_ForwardIterator __first, _ForwardIterator __last, _O
 
 template<class _RandomAccessIterator, class _OutputIterator>
 _OutputIterator brick_move(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __result, /*vector=*/std::true_type) noexcept {
-    return unseq_backend::simd_assign(__first, __last - __first, __result,
-        [](_RandomAccessIterator __first, _OutputIterator __result) {
-        *__result = std::move(*__first);
-    });
+    return unseq_backend::simd_move(__first, __last - __first, __result);
 }
 
 //------------------------------------------------------------------------
@@ -731,7 +1432,7 @@ _OutputIterator brick_swap_ranges(_ForwardIterator __first, _ForwardIterator __l
 
 template<class _ForwardIterator, class _OutputIterator>
 _OutputIterator brick_swap_ranges(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, /*vector=*/std::true_type) noexcept {
-    return unseq_backend::simd_assign(__first, __last - __first, __result, std::iter_swap<_ForwardIterator, _OutputIterator>);
+    return unseq_backend::simd_swap_ranges(__first, __last - __first, __result);
 }
 
 //------------------------------------------------------------------------
@@ -744,43 +1445,43 @@ _OutputIterator brick_copy_if(_ForwardIterator __first, _ForwardIterator __last,
 
 template<class _ForwardIterator, class _OutputIterator, class _UnaryPredicate>
 _OutputIterator brick_copy_if(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, _UnaryPredicate __pred, /*vector=*/std::true_type) noexcept {
-#if (__PSTL_MONOTONIC_PRESENT)
     return unseq_backend::simd_copy_if(__first, __last - __first, __result, __pred);
-#else
-    return std::copy_if(__first, __last, __result, __pred);
-#endif
 }
 
 // TODO: Try to use transform_reduce for combining brick_copy_if_phase1 on IsVector.
 template<class _DifferenceType, class _ForwardIterator, class _UnaryPredicate>
 std::pair<_DifferenceType, _DifferenceType> brick_calc_mask_1(
-    _ForwardIterator __first, _ForwardIterator __last, bool* __restrict __mask, _UnaryPredicate __pred, /*vector=*/std::false_type) noexcept {
+    _ForwardIterator __first, _ForwardIterator __last, mask_word* __restrict __mask, _UnaryPredicate __pred, /*vector=*/std::false_type) noexcept {
     auto __count_true  = _DifferenceType(0);
-    auto __count_false = _DifferenceType(0);
     auto __size = __last - __first;
-    
+
     static_assert(internal::is_random_access_iterator<_ForwardIterator>::value, "Pattern-brick error. Should be a random access iterator.");
 
-    for (; __first != __last; ++__first, ++__mask) {
-        *__mask = __pred(*__first);
-        if (*__mask) {
-            ++__count_true;
+    for (_DifferenceType __i = 0; __i < __size; __i += __PSTL_MASK_WORD_BITS, ++__mask) {
+        const _DifferenceType __len = std::min(__size - __i, _DifferenceType(__PSTL_MASK_WORD_BITS));
+        mask_word __word = 0;
+        for (_DifferenceType __j = 0; __j < __len; ++__j, ++__first) {
+            if (__pred(*__first)) {
+                __word |= mask_word(1) << __j;
+            }
         }
+        *__mask = __word;
+        __count_true += mask_popcount(__word);
     }
     return std::make_pair(__count_true, __size - __count_true);
 }
 
 template<class _DifferenceType, class _RandomAccessIterator, class _UnaryPredicate>
 std::pair<_DifferenceType, _DifferenceType> brick_calc_mask_1(
-    _RandomAccessIterator __first, _RandomAccessIterator __last, bool* __mask, _UnaryPredicate __pred, /*vector=*/std::true_type) noexcept {
+    _RandomAccessIterator __first, _RandomAccessIterator __last, mask_word* __mask, _UnaryPredicate __pred, /*vector=*/std::true_type) noexcept {
     auto __result = unseq_backend::simd_calc_mask_1(__first, __last - __first, __mask, __pred);
     return std::make_pair(__result, (__last - __first) - __result);
 }
 
 template<class _ForwardIterator, class _OutputIterator, class _Assigner>
-void brick_copy_by_mask(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, bool* __mask, _Assigner __assigner, /*vector=*/std::false_type) noexcept {
-    for (; __first != __last; ++__first, ++__mask) {
-        if (*__mask) {
+void brick_copy_by_mask(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, const mask_word* __mask, _Assigner __assigner, /*vector=*/std::false_type) noexcept {
+    for (std::size_t __i = 0; __first != __last; ++__first, ++__i) {
+        if (mask_test(__mask, __i)) {
             __assigner(__first, __result);
             ++__result;
         }
@@ -788,19 +1489,15 @@ void brick_copy_by_mask(_ForwardIterator __first, _ForwardIterator __last, _Outp
 }
 
 template<class _ForwardIterator, class _OutputIterator, class _Assigner>
-void brick_copy_by_mask(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, bool* __restrict __mask, _Assigner __assigner, /*vector=*/std::true_type) noexcept {
-#if (__PSTL_MONOTONIC_PRESENT)
+void brick_copy_by_mask(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, const mask_word* __restrict __mask, _Assigner __assigner, /*vector=*/std::true_type) noexcept {
     unseq_backend::simd_copy_by_mask(__first, __last - __first, __result, __mask, __assigner);
-#else
-    internal::brick_copy_by_mask(__first, __last, __result, __mask, __assigner, std::false_type());
-#endif
 }
 
 template<class _ForwardIterator, class _OutputIterator1, class _OutputIterator2>
 void brick_partition_by_mask(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator1 __out_true,
-    _OutputIterator2 __out_false, bool* __mask, /*vector=*/std::false_type) noexcept {
-    for (; __first != __last; ++__first, ++__mask) {
-        if (*__mask) {
+    _OutputIterator2 __out_false, const mask_word* __mask, /*vector=*/std::false_type) noexcept {
+    for (std::size_t __i = 0; __first != __last; ++__first, ++__i) {
+        if (mask_test(__mask, __i)) {
             *__out_true = *__first;
             ++__out_true;
         }
@@ -813,12 +1510,8 @@ void brick_partition_by_mask(_ForwardIterator __first, _ForwardIterator __last,
 
 template<class _RandomAccessIterator, class _OutputIterator1, class _OutputIterator2>
 void brick_partition_by_mask(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator1 __out_true,
-    _OutputIterator2 __out_false, bool* __mask, /*vector=*/std::true_type) noexcept {
-#if (__PSTL_MONOTONIC_PRESENT)
+    _OutputIterator2 __out_false, const mask_word* __mask, /*vector=*/std::true_type) noexcept {
     unseq_backend::simd_partition_by_mask(__first, __last - __first, __out_true, __out_false, __mask);
-#else
-    internal::brick_partition_by_mask(__first, __last, __out_true, __out_false, __mask, std::false_type());
-#endif
 }
 
 template<class _ForwardIterator, class _OutputIterator, class _UnaryPredicate, class _IsVector>
@@ -826,37 +1519,64 @@ _OutputIterator pattern_copy_if(_ForwardIterator __first, _ForwardIterator __las
     return internal::brick_copy_if(__first, __last, __result, __pred, __is_vector);
 }
 
+// The parallel mask patterns scan over mask words, so that no two subranges share a word.
 template<class _RandomAccessIterator, class _OutputIterator, class _UnaryPredicate, class _IsVector>
 _OutputIterator pattern_copy_if(_RandomAccessIterator __first, _RandomAccessIterator __last, _OutputIterator __result, _UnaryPredicate __pred, _IsVector __is_vector, /*parallel=*/std::true_type) {
     typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _DifferenceType;
     const _DifferenceType __n = __last-__first;
     if (_DifferenceType(1) < __n) {
-        par_backend::buffer<bool> __mask_buf(__n);
-        return except_handler([__n, __first, __last, __result, __is_vector, __pred, &__mask_buf]() {
-            bool* __mask = __mask_buf.get();
+        const _DifferenceType __words = mask_size(__n);
+        par_backend::buffer<mask_word> __mask_buf(__words);
+        output_target<_OutputIterator> __target(__result);
+        return except_handler([__n, __words, __first, __last, __is_vector, __pred, &__mask_buf, &__target]() {
+            mask_word* __mask = __mask_buf.get();
+            const _DifferenceType __word_bits = __PSTL_MASK_WORD_BITS;
             _DifferenceType __m{};
-            par_backend::parallel_strict_scan(__n, _DifferenceType(0),
+            par_backend::parallel_strict_scan(__words, _DifferenceType(0),
                 [=](_DifferenceType __i, _DifferenceType __len) {                               // Reduce
-                    return brick_calc_mask_1<_DifferenceType>(__first + __i, __first + (__i + __len),
+                    return brick_calc_mask_1<_DifferenceType>(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
                         __mask + __i,
                         __pred,
                         __is_vector).first;
                 },
                 std::plus<_DifferenceType>(),                                               // Combine
-                [=](_DifferenceType __i, _DifferenceType __len, _DifferenceType __initial) {      // Scan
-                    brick_copy_by_mask(__first + __i, __first + (__i + __len),
-                        __result + __initial, __mask + __i,
-                        [](_RandomAccessIterator __x, _OutputIterator __z) {*__z = *__x; },
+                [=, &__target](_DifferenceType __i, _DifferenceType __len, _DifferenceType __initial) {      // Scan
+                    brick_copy_by_mask(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
+                        __target.begin() + __initial, __mask + __i,
+                        copy_assigner(),
                         __is_vector);
                 },
-                [&__m](_DifferenceType __total) {__m = __total; });
-            return __result + __m;
+                [&__m, &__target](_DifferenceType __total) {__m = __total; __target.grow(__total); });
+            return __target.result(__m);
         });
     }
     // trivial sequence - use serial algorithm
     return brick_copy_if(__first, __last, __result, __pred, __is_vector);
 }
 
+template<class _ForwardIterator, class _OutputIterator, class _UnaryPredicate, class _IsVector, class _IsParallel, class _Traversal>
+_OutputIterator pattern_copy_if(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, _UnaryPredicate __pred,
+                                _IsVector __is_vector, _IsParallel __is_parallel, /*traversal=*/_Traversal) {
+    return internal::pattern_copy_if(__first, __last, __result, __pred, __is_vector, __is_parallel);
+}
+
+template<class _InputIterator, class _OutputIterator, class _UnaryPredicate, class _IsVector, bool _IsBatchVector>
+_OutputIterator pattern_copy_if(_InputIterator __first, _InputIterator __last, _OutputIterator __result, _UnaryPredicate __pred,
+                                _IsVector, /*parallel=*/std::false_type, /*traversal=*/pipeline_traversal_tag<_IsBatchVector>) {
+    typedef typename pipeline_batch<_InputIterator>::size_type _SizeType;
+    except_handler([&]() {
+        internal::pipeline_batches(__first, __last,
+            // The values to copy are moved to the front of the batch, and copied out in the order of the batches
+            [__pred](pipeline_batch<_InputIterator>& __batch) -> _SizeType {
+                return std::remove_if(__batch.begin(), __batch.end(), internal::not_pred<_UnaryPredicate>(__pred)) - __batch.begin();
+            },
+            [&__result](pipeline_batch<_InputIterator>& __batch, _SizeType __n) {
+                __result = std::copy(__batch.begin(), __batch.begin() + __n, __result);
+            });
+    });
+    return __result;
+}
+
 //------------------------------------------------------------------------
 // count
 //------------------------------------------------------------------------
@@ -892,6 +1612,71 @@ pattern_count(_ForwardIterator __first, _ForwardIterator __last, _Predicate __pr
     });
 }
 
+template<class _ForwardIterator, class _Predicate, class _IsParallel, class _IsVector>
+typename std::iterator_traits<_ForwardIterator>::difference_type
+pattern_count(_ForwardIterator __first, _ForwardIterator __last, _Predicate __pred, _IsParallel __is_parallel, _IsVector __is_vector,
+              /* traversal */ direct_traversal_tag) {
+    return internal::pattern_count(__first, __last, __pred, __is_parallel, __is_vector);
+}
+
+template<class _ForwardIterator, class _Predicate, class _IsVector>
+typename std::iterator_traits<_ForwardIterator>::difference_type
+pattern_count(_ForwardIterator __first, _ForwardIterator __last, _Predicate __pred, /* is_parallel */ std::false_type, _IsVector,
+              /* traversal */ checkpoint_traversal_tag) {
+    const checkpoint_table<_ForwardIterator> __table(__first, __last);
+    return internal::pattern_count(internal::checkpoint_begin(__table), internal::checkpoint_end(__table), __pred,
+                                   /* is_parallel */ std::true_type(), /* is_vector */ std::false_type());
+}
+
+template<class _SegmentedIterator, class _Predicate, class _IsVector>
+typename std::iterator_traits<_SegmentedIterator>::difference_type
+pattern_count(_SegmentedIterator __first, _SegmentedIterator __last, _Predicate __pred, /* is_parallel */ std::false_type, _IsVector __is_vector,
+              /* traversal */ segment_traversal_tag) noexcept {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    typedef typename std::iterator_traits<_SegmentedIterator>::difference_type _SizeType;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    _SizeType __count = 0;
+    for (_SegmentIterator __s = __r.segments_begin(); __s != __r.segments_end(); ++__s)
+        __count += brick_count(__r.begin(__s), __r.end(__s), __pred, __is_vector);
+    return __count;
+}
+
+template<class _SegmentedIterator, class _Predicate, class _IsVector>
+typename std::iterator_traits<_SegmentedIterator>::difference_type
+pattern_count(_SegmentedIterator __first, _SegmentedIterator __last, _Predicate __pred, /* is_parallel */ std::true_type, _IsVector __is_vector,
+              /* traversal */ segment_traversal_tag) {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    typedef typename std::iterator_traits<_SegmentedIterator>::difference_type _SizeType;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    return except_handler([&]() {
+        return par_backend::parallel_reduce(__r.segments_begin(), __r.segments_end(), _SizeType(0),
+            [&__r, __pred, __is_vector](_SegmentIterator __i, _SegmentIterator __j, _SizeType __value)->_SizeType {
+                for (; __i != __j; ++__i)
+                    __value += brick_count(__r.begin(__i), __r.end(__i), __pred, __is_vector);
+                return __value;
+            },
+            std::plus<_SizeType>()
+        );
+    });
+}
+
+template<class _InputIterator, class _Predicate, class _IsVector, bool _IsBatchVector>
+typename std::iterator_traits<_InputIterator>::difference_type
+pattern_count(_InputIterator __first, _InputIterator __last, _Predicate __pred, /* is_parallel */ std::false_type, _IsVector,
+              /* traversal */ pipeline_traversal_tag<_IsBatchVector>) {
+    typedef typename pipeline_traversal_tag<_IsBatchVector>::is_vector _IsVectorBatch;
+    typedef typename std::iterator_traits<_InputIterator>::difference_type _SizeType;
+    _SizeType __count = 0;
+    except_handler([&]() {
+        internal::pipeline_batches(__first, __last,
+            [__pred](pipeline_batch<_InputIterator>& __batch) -> _SizeType {
+                return brick_count(__batch.begin(), __batch.end(), __pred, _IsVectorBatch());
+            },
+            [&__count](pipeline_batch<_InputIterator>&, _SizeType __n) { __count += __n; });
+    });
+    return __count;
+}
+
 //------------------------------------------------------------------------
 // unique
 //------------------------------------------------------------------------
@@ -903,8 +1688,7 @@ _ForwardIterator brick_unique(_ForwardIterator __first, _ForwardIterator __last,
 
 template<class _ForwardIterator, class _BinaryPredicate>
 _ForwardIterator brick_unique(_ForwardIterator __first, _ForwardIterator __last, _BinaryPredicate __pred, /*is_vector=*/std::true_type) noexcept {
-    __PSTL_PRAGMA_MESSAGE("Vectorized algorithm unimplemented, redirected to serial");
-    return std::unique(__first, __last, __pred);
+    return unseq_backend::simd_unique(__first, __last - __first, __pred);
 }
 
 template<class _ForwardIterator, class _BinaryPredicate, class _IsVector>
@@ -912,70 +1696,157 @@ _ForwardIterator pattern_unique(_ForwardIterator __first, _ForwardIterator __las
     return internal::brick_unique(__first, __last, __pred, __is_vector);
 }
 
-template<class _ForwardIterator, class _Predicate, class _IsVector>
-_ForwardIterator remove_elements(_ForwardIterator __first, _ForwardIterator __last, _Predicate __pred, _IsVector __is_vector) {
+// Largest number of tiles remove_elements splits the sequence into; bounds its scratch memory.
+const std::size_t __PSTL_REMOVE_MAX_TILES = 256;
+// Smallest tile (in elements) remove_elements works on.
+const std::size_t __PSTL_REMOVE_MIN_TILE_SIZE = 1024;
+// Largest distance (in elements) by which remove_elements moves tiles that overlap their destinations in parallel;
+// every such tile but the last saves that many elements into scratch memory.
+const std::size_t __PSTL_REMOVE_MAX_SHIFT = 1024;
+
+//! Moves the elements of [__first, __last) for which __keep is true to the front of the range and returns their number.
+/** __first_keep is the precomputed value of __keep(__first). __keep(__it + 1) is evaluated before *__it is moved,
+so __keep may also read the element preceding its argument. */
+template<class _ForwardIterator, class _KeepPredicate>
+typename std::iterator_traits<_ForwardIterator>::difference_type
+brick_compact(_ForwardIterator __first, _ForwardIterator __last, bool __first_keep, _KeepPredicate __keep) noexcept {
+    _ForwardIterator __result = __first;
+    bool __keep_current = __first_keep;
+    for (_ForwardIterator __it = __first; __it != __last; ) {
+        _ForwardIterator __next = __it;
+        ++__next;
+        const bool __keep_next = __next != __last && __keep(__next);
+        if (__keep_current) {
+            if (__result != __it)
+                *__result = std::move(*__it);
+            ++__result;
+        }
+        __keep_current = __keep_next;
+        __it = __next;
+    }
+    return __result - __first;
+}
+
+//! Moves [__first + __shift, __last) to [__first, __last - __shift).
+/** The elements are moved front to back in blocks of at most __shift elements, so that no block overlaps its
+destination. */
+template<class _ForwardIterator, class _IsVector>
+void brick_shift_left(_ForwardIterator __first, _ForwardIterator __last,
+                      typename std::iterator_traits<_ForwardIterator>::difference_type __shift, _IsVector __is_vector) noexcept {
     typedef typename std::iterator_traits<_ForwardIterator>::difference_type _DifferenceType;
+    for (_DifferenceType __i = __shift, __n = __last - __first; __i < __n; __i += __shift)
+        brick_move(__first + __i, __first + std::min(__i + __shift, __n), __first + (__i - __shift), __is_vector);
+}
+
+//! Parallel in-place removal of the elements for which __keep is false.
+/** Every tile is compacted to its front independently, then the compacted tiles are moved to their final
+positions. Only O(number of tiles) scratch memory is used. */
+template<class _ForwardIterator, class _KeepPredicate, class _IsVector>
+_ForwardIterator remove_elements(_ForwardIterator __first, _ForwardIterator __last, _KeepPredicate __keep, _IsVector __is_vector) {
     typedef typename std::iterator_traits<_ForwardIterator>::value_type _Tp;
-    _DifferenceType __n = __last - __first;
-    par_backend::buffer<bool> __mask_buf(__n);
-    // 1. find a first iterator that should be removed
+    typedef typename std::iterator_traits<_ForwardIterator>::difference_type _DifferenceType;
+    const _DifferenceType __n = __last - __first;
+    const _DifferenceType __tile_size = std::max(_DifferenceType(__PSTL_REMOVE_MIN_TILE_SIZE),
+        (__n - 1) / _DifferenceType(__PSTL_REMOVE_MAX_TILES) + 1);
+    const _DifferenceType __tiles = (__n - 1) / __tile_size + 1;
+    par_backend::buffer<_DifferenceType> __offset_buf(__tiles + 1);
+    par_backend::buffer<bool> __keep_buf(__tiles);
     return except_handler([&]() {
-        bool* __mask = __mask_buf.get();
-        _DifferenceType __min = par_backend::parallel_reduce(_DifferenceType(0), __n, __n,
-            [__first, __mask, &__pred, __is_vector](_DifferenceType __i, _DifferenceType __j, _DifferenceType __local_min)->_DifferenceType {
-                // Create mask
-                brick_it_walk2(__mask + __i, __mask + __j, __first + __i, __pred, __is_vector);
-
-                // if minimum was found in a previous range we shouldn't do anymore
-                if (__local_min < __i) {
-                    return __local_min;
-                }
-                // find first iterator that should be removed
-                bool* __result = brick_find_if(__mask + __i, __mask + __j,
-                    [](bool __val) { return !__val; }, __is_vector);
-                if (__result - __mask == __j) {
-                    return __local_min;
-                }
-                return std::min(__local_min, __result - __mask);
-            },
-            [](_DifferenceType __local_min1, _DifferenceType __local_min2)->_DifferenceType {
-                return std::min(__local_min1, __local_min2);
-            }
-        );
+        _DifferenceType* __offset = __offset_buf.get();
+        bool* __keep_first = __keep_buf.get();
 
-        // No elements to remove - exit
-        if (__min == __n) {
-            return __last;
-        }
-        __n -= __min;
-        __first += __min;
-
-        par_backend::buffer<_Tp> __buf(__n);
-        _Tp* __result = __buf.get();
-        __mask += __min;
-        _DifferenceType __m {};
-        // 2. Elements that doesn't satisfy pred are moved to result
-        par_backend::parallel_strict_scan(__n, _DifferenceType(0),
-            [__mask, __is_vector](_DifferenceType __i, _DifferenceType __len) {
-                return brick_count(__mask + __i, __mask + __i + __len, [](bool __val) {return __val; }, __is_vector);
-            },
-            std::plus<_DifferenceType>(),
-            [=](_DifferenceType __i, _DifferenceType __len, _DifferenceType __initial) {
-                brick_copy_by_mask(__first + __i, __first + __i + __len, __result + __initial, __mask + __i,
-                    [](_ForwardIterator __x, _Tp* __z) {invoke_if_else(std::is_trivial<_Tp>(),
-                        [&]() {*__z = std::move(*__x); },
-                        [&]() {::new (internal::reduce_to_ptr(__z)) _Tp(std::move(*__x)); }); },
-                    __is_vector);
-            },
-            [&__m](_DifferenceType __total) {__m = __total; }
-        );
+        // 1. Evaluate __keep for the first element of every tile before any element is moved
+        par_backend::parallel_for(_DifferenceType(0), __tiles, [=](_DifferenceType __i, _DifferenceType __j) {
+            for (; __i != __j; ++__i)
+                __keep_first[__i] = __keep(__first + __i * __tile_size);
+        });
 
-        // 3. Elements from result are moved to [first, last)
-        par_backend::parallel_for(__result, __result + __m,
-            [__result, __first, __is_vector](_Tp* __i, _Tp* __j) {
-            brick_move(__i, __j, __first + (__i - __result), __is_vector);
+        // 2. Compact every tile in place, storing the number of kept elements into __offset[__k + 1]
+        par_backend::parallel_for(_DifferenceType(0), __tiles, [=](_DifferenceType __i, _DifferenceType __j) {
+            for (; __i != __j; ++__i) {
+                const _DifferenceType __begin = __i * __tile_size;
+                __offset[__i + 1] = brick_compact(__first + __begin, __first + std::min(__begin + __tile_size, __n),
+                    __keep_first[__i], __keep);
+            }
         });
-        return __first + __m;
+        __offset[0] = 0;
+        for (_DifferenceType __k = 0; __k < __tiles; ++__k)
+            __offset[__k + 1] += __offset[__k];
+
+        // 3. Move the compacted tiles to their final positions. Consecutive tiles are moved together as long as all
+        // their destinations lie before the first tile of the group, so nothing is overwritten before it is moved.
+        for (_DifferenceType __k = 1; __k < __tiles; ) {
+            const _DifferenceType __begin = __k * __tile_size;
+            const _DifferenceType __shift = __begin - __offset[__k];
+            if (__shift == 0) {
+                // Nothing removed so far - the tile is already in place
+                ++__k;
+            }
+            else if (__offset[__k + 1] > __begin && __shift <= _DifferenceType(__PSTL_REMOVE_MAX_SHIFT)) {
+                // A run of tiles that overlap their destinations and move by a short distance. The destination of
+                // a tile overwrites only the last __shift kept elements of the preceding tile, so those are saved
+                // first, and then every tile is shifted in place independently.
+                _DifferenceType __end = __k + 1;
+                while (__end < __tiles && __offset[__end + 1] > __end * __tile_size
+                       && __end * __tile_size - __offset[__end] <= _DifferenceType(__PSTL_REMOVE_MAX_SHIFT))
+                    ++__end;
+                par_backend::buffer<_Tp> __tail_buf((__end - 1 - __k) * __PSTL_REMOVE_MAX_SHIFT);
+                _Tp* __tail = __tail_buf.get();
+                par_backend::parallel_for(__k, __end - 1, [=](_DifferenceType __i, _DifferenceType __j) {
+                    for (; __i != __j; ++__i) {
+                        const _ForwardIterator __saved_first = __first + __offset[__i + 1];
+                        brick_uninitialized_move(__saved_first, __saved_first + (__i * __tile_size - __offset[__i]),
+                            __tail + (__i - __k) * __PSTL_REMOVE_MAX_SHIFT, __is_vector);
+                    }
+                });
+                par_backend::parallel_for(__k, __end, [=](_DifferenceType __i, _DifferenceType __j) {
+                    for (; __i != __j; ++__i) {
+                        const _DifferenceType __tile_shift = __i * __tile_size - __offset[__i];
+                        if (__i + 1 == __end) {
+                            brick_shift_left(__first + __offset[__i], __first + (__offset[__i + 1] + __tile_shift), __tile_shift, __is_vector);
+                        }
+                        else {
+                            brick_shift_left(__first + __offset[__i], __first + __offset[__i + 1], __tile_shift, __is_vector);
+                            _Tp* __saved = __tail + (__i - __k) * __PSTL_REMOVE_MAX_SHIFT;
+                            brick_move(__saved, __saved + __tile_shift, __first + (__offset[__i + 1] - __tile_shift), __is_vector);
+                            par_backend::serial_destroy()(__saved, __saved + __tile_shift);
+                        }
+                    }
+                });
+                __k = __end;
+            }
+            else if (__offset[__k + 1] > __begin) {
+                // A tile that overlaps its destination and moves by a long distance: it is moved front to back in
+                // blocks of __shift elements, each of which is moved in parallel.
+                const _DifferenceType __size = __offset[__k + 1] - __offset[__k];
+                for (_DifferenceType __b = 0; __b < __size; __b += __shift) {
+                    const _ForwardIterator __block_first = __first + (__begin + __b);
+                    const _ForwardIterator __result = __first + (__offset[__k] + __b);
+                    par_backend::parallel_for(__block_first, __first + (__begin + std::min(__b + __shift, __size)),
+                        [__block_first, __result, __is_vector](_ForwardIterator __i, _ForwardIterator __j) {
+                        brick_move(__i, __j, __result + (__i - __block_first), __is_vector);
+                    });
+                }
+                ++__k;
+            }
+            else {
+                _DifferenceType __end = __k + 1;
+                while (__end < __tiles && __offset[__end + 1] <= __begin)
+                    ++__end;
+                par_backend::parallel_for(__k, __end, [=](_DifferenceType __i, _DifferenceType __j) {
+                    for (; __i != __j; ++__i) {
+                        const _ForwardIterator __tile_first = __first + __i * __tile_size;
+                        const _ForwardIterator __result = __first + __offset[__i];
+                        par_backend::parallel_for(__tile_first, __tile_first + (__offset[__i + 1] - __offset[__i]),
+                            [__tile_first, __result, __is_vector](_ForwardIterator __b, _ForwardIterator __e) {
+                            brick_move(__b, __e, __result + (__b - __tile_first), __is_vector);
+                        });
+                    }
+                });
+                __k = __end;
+            }
+        }
+        return __first + __offset[__tiles];
     });
 }
 
@@ -989,7 +1860,7 @@ ForwardIterator pattern_unique(ForwardIterator first, ForwardIterator last, Bina
         return brick_unique(first, last, pred, is_vector);
     }
     return remove_elements(++first, last,
-        [&pred](bool* it1, ForwardIterator it2) {*it1 = !pred(*(it2 - 1), *it2); },
+        [&pred](ForwardIterator it) { return !pred(*(it - 1), *it); },
         is_vector);
 }
 
@@ -1004,11 +1875,7 @@ OutputIterator brick_unique_copy(_ForwardIterator __first, _ForwardIterator __la
 
 template<class _RandomAccessIterator, class OutputIterator, class _BinaryPredicate>
 OutputIterator brick_unique_copy(_RandomAccessIterator __first, _RandomAccessIterator __last, OutputIterator __result, _BinaryPredicate __pred, /*vector=*/std::true_type) noexcept {
-#if (__PSTL_MONOTONIC_PRESENT)
     return unseq_backend::simd_unique_copy(__first, __last - __first, __result, __pred);
-#else
-    return std::unique_copy(__first, __last, __result, __pred);
-#endif
 }
 
 template<class _ForwardIterator, class _OutputIterator, class _BinaryPredicate, class _IsVector>
@@ -1017,17 +1884,25 @@ _OutputIterator pattern_unique_copy(_ForwardIterator __first, _ForwardIterator _
 }
 
 template<class _DifferenceType, class _RandomAccessIterator, class _BinaryPredicate>
-_DifferenceType brick_calc_mask_2(_RandomAccessIterator __first, _RandomAccessIterator __last, bool* __restrict __mask, _BinaryPredicate __pred, /*vector=*/std::false_type) noexcept {
+_DifferenceType brick_calc_mask_2(_RandomAccessIterator __first, _RandomAccessIterator __last, mask_word* __restrict __mask, _BinaryPredicate __pred, /*vector=*/std::false_type) noexcept {
+    const _DifferenceType __size = __last - __first;
     _DifferenceType __count = 0;
-    for (; __first != __last; ++__first, ++__mask) {
-        *__mask = !__pred(*__first, *(__first - 1));
-        __count += *__mask;
+    for (_DifferenceType __i = 0; __i < __size; __i += __PSTL_MASK_WORD_BITS, ++__mask) {
+        const _DifferenceType __len = std::min(__size - __i, _DifferenceType(__PSTL_MASK_WORD_BITS));
+        mask_word __word = 0;
+        for (_DifferenceType __j = 0; __j < __len; ++__j, ++__first) {
+            if (!__pred(*__first, *(__first - 1))) {
+                __word |= mask_word(1) << __j;
+            }
+        }
+        *__mask = __word;
+        __count += mask_popcount(__word);
     }
     return __count;
 }
 
 template<class _DifferenceType, class _RandomAccessIterator, class _BinaryPredicate>
-_DifferenceType brick_calc_mask_2(_RandomAccessIterator __first, _RandomAccessIterator __last, bool* __restrict __mask, _BinaryPredicate __pred, /*vector=*/std::true_type) noexcept {
+_DifferenceType brick_calc_mask_2(_RandomAccessIterator __first, _RandomAccessIterator __last, mask_word* __restrict __mask, _BinaryPredicate __pred, /*vector=*/std::true_type) noexcept {
     return unseq_backend::simd_calc_mask_2(__first, __last - __first, __mask, __pred);
 }
 
@@ -1036,37 +1911,42 @@ _OutputIterator pattern_unique_copy(_RandomAccessIterator __first, _RandomAccess
     typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _DifferenceType;
     const _DifferenceType __n = __last - __first;
     if( _DifferenceType(2) < __n ) {
-        par_backend::buffer<bool> __mask_buf(__n);
+        const _DifferenceType __words = mask_size(__n);
+        par_backend::buffer<mask_word> __mask_buf(__words);
+        output_target<_OutputIterator> __target(__result);
         if( _DifferenceType(2) < __n) {
-          return internal::except_handler([__n, __first, __result, __pred, __is_vector, &__mask_buf]() {
-                bool* __mask = __mask_buf.get();
+          return internal::except_handler([__n, __words, __first, __pred, __is_vector, &__mask_buf, &__target]() {
+                mask_word* __mask = __mask_buf.get();
+                const _DifferenceType __word_bits = __PSTL_MASK_WORD_BITS;
                 _DifferenceType __m{};
-                par_backend::parallel_strict_scan( __n, _DifferenceType(0),
+                par_backend::parallel_strict_scan( __words, _DifferenceType(0),
                     [=](_DifferenceType __i, _DifferenceType __len) -> _DifferenceType {          // Reduce
                         _DifferenceType __extra = 0;
                         if( __i == 0 ) {
-                            // Special boundary case
-                            __mask[__i] = true;
-                            if( --__len == 0 ) return 1;
+                            // Special boundary case: the first element is always copied,
+                            // the rest of the first word is computed shifted by one bit
+                            __extra = 1 + brick_calc_mask_2<_DifferenceType>(__first + 1, __first + std::min(__word_bits, __n),
+                                                                              __mask, __pred, __is_vector);
+                            __mask[0] = (__mask[0] << 1) | 1;
+                            if( --__len == 0 ) return __extra;
                             ++__i;
-                            ++__extra;
                         }
-                        return brick_calc_mask_2<_DifferenceType>(__first + __i, __first + (__i + __len),
+                        return brick_calc_mask_2<_DifferenceType>(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
                                                                    __mask + __i,
                                                                    __pred,
                                                                    __is_vector) + __extra;
                     },
                     std::plus<_DifferenceType>(),                                               // Combine
-                    [=](_DifferenceType __i, _DifferenceType __len, _DifferenceType __initial) {      // Scan
+                    [=, &__target](_DifferenceType __i, _DifferenceType __len, _DifferenceType __initial) {      // Scan
                         // Phase 2 is same as for pattern_copy_if
-                        internal::brick_copy_by_mask(__first + __i, __first + (__i + __len),
-                                                     __result + __initial,
+                        internal::brick_copy_by_mask(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
+                                                     __target.begin() + __initial,
                                                      __mask + __i,
-                                                     [](_RandomAccessIterator __x, _OutputIterator __z) {*__z = *__x; },
+                                                     copy_assigner(),
                                                      __is_vector);
                     },
-                    [&__m](_DifferenceType __total) {__m = __total;});
-                return __result + __m;
+                    [&__m, &__target](_DifferenceType __total) {__m = __total; __target.grow(__total);});
+                return __target.result(__m);
             });
         }
     }
@@ -1181,14 +2061,12 @@ _ForwardIterator brick_rotate(_ForwardIterator __first, _ForwardIterator __middl
         const auto __m_2 = __m*2;
         if (__is_left) {
             for (; __last - __first >= __m_2; __first += __m) {
-                unseq_backend::simd_assign(__first, __m, __first + __m,
-                std::iter_swap<_ForwardIterator, _ForwardIterator>);
+                unseq_backend::simd_swap_ranges(__first, __m, __first + __m);
             }
         }
         else {
             for (; __last - __first  >= __m_2; __last -= __m) {
-                unseq_backend::simd_assign(__last - __m, __m, __last - __m_2,
-                std::iter_swap<_ForwardIterator, _ForwardIterator>);
+                unseq_backend::simd_swap_ranges(__last - __m, __m, __last - __m_2);
             }
         }
         __is_left = !__is_left;
@@ -1204,11 +2082,81 @@ _ForwardIterator pattern_rotate(_ForwardIterator __first, _ForwardIterator __mid
     return internal::brick_rotate(__first, __middle, __last, __is_vector);
 }
 
+// Largest temporary buffer, in bytes, the parallel rotate may allocate; above it the rotation is done in place.
+// The buffered rotation makes three passes over the buffer, which are cheap while the buffer stays in the
+// per-core L2 cache (256 KB on most current x86 and ARM server cores); beyond that the passes go to memory,
+// and the in place rotation, which moves every element once, is faster.
+const std::size_t __PSTL_ROTATE_BUFFER_CUT_OFF = 256 * 1024;
+// Smallest run of positions, in bytes, that a task of the in place rotation swaps through the longer block. Every
+// task walks the whole longer block, so shorter runs would fetch the same cache lines and pages once per task.
+const std::size_t __PSTL_ROTATE_MIN_RUN = 16 * 1024;
+
+//! Evaluation of __f(__i, __j) for the runs [__i, __j) of [0, __n) positions of elements of _Tp of a rotation step
+template<class _Tp, class _DifferenceType, class _Fp>
+void rotate_runs(_DifferenceType __n, _Fp __f) {
+    const _DifferenceType __run = std::max(_DifferenceType(1), _DifferenceType(__PSTL_ROTATE_MIN_RUN / sizeof(_Tp)));
+    const _DifferenceType __runs = (__n + __run - 1) / __run;
+    if (__runs <= 1) {
+        __f(_DifferenceType(0), __n);
+        return;
+    }
+    par_backend::parallel_for(_DifferenceType(0), __runs, [__f, __run, __n](_DifferenceType __i, _DifferenceType __j) {
+        __f(__i * __run, std::min(__j * __run, __n));
+    });
+}
+
+//! Parallel rotate without additional memory.
+/** Gries-Mills block swaps: the shorter block is swapped with each following (or preceding) block of its length
+that fits in the longer one, so that all of those land in their final position, and the rotation continues with
+the shorter block and the remainder of the longer one, as in Euclid's algorithm. The successive swaps of a step
+are independent for each position within the shorter block, so a step runs in parallel over runs of those positions. */
+template<class _ForwardIterator, class _IsVector>
+void rotate_inplace(_ForwardIterator __first, _ForwardIterator __middle, _ForwardIterator __last, _IsVector __is_vector) {
+    typedef typename std::iterator_traits<_ForwardIterator>::value_type _Tp;
+    typedef typename std::iterator_traits<_ForwardIterator>::difference_type _DifferenceType;
+    for (;;) {
+        const _DifferenceType __size1 = __middle - __first;
+        const _DifferenceType __size2 = __last - __middle;
+        if (__size1 == 0 || __size2 == 0)
+            return;
+
+        if (__size1 <= __size2) {
+            // Swap [__first, __middle) rightwards through the __q blocks of its length that follow it
+            const _DifferenceType __q = __size2 / __size1;
+            rotate_runs<_Tp>(__size1, [__first, __size1, __q, __is_vector](_DifferenceType __i, _DifferenceType __j) {
+                for (_DifferenceType __k = 0; __k < __q; ++__k)
+                    brick_swap_ranges(__first + (__k * __size1 + __i), __first + (__k * __size1 + __j),
+                                      __first + ((__k + 1) * __size1 + __i), __is_vector);
+            });
+            __first += __q * __size1;
+            __middle = __first + __size1;
+        }
+        else {
+            // Swap [__middle, __last) leftwards through the __q blocks of its length that precede it
+            const _DifferenceType __q = __size1 / __size2;
+            rotate_runs<_Tp>(__size2, [__last, __size2, __q, __is_vector](_DifferenceType __i, _DifferenceType __j) {
+                for (_DifferenceType __k = 0; __k < __q; ++__k)
+                    brick_swap_ranges(__last - ((__k + 1) * __size2 - __i), __last - ((__k + 1) * __size2 - __j),
+                                      __last - ((__k + 2) * __size2 - __i), __is_vector);
+            });
+            __last -= __q * __size2;
+            __middle = __last - __size2;
+        }
+    }
+}
+
 template<class _ForwardIterator, class _IsVector>
 _ForwardIterator pattern_rotate(_ForwardIterator __first, _ForwardIterator __middle, _ForwardIterator __last, _IsVector __is_vector, /*is_parallel=*/std::true_type) {
     typedef typename std::iterator_traits<_ForwardIterator>::value_type _Tp;
     auto __n = __last - __first;
     auto __m = __middle - __first;
+    // The buffer holds the longer block
+    if (sizeof(_Tp) * std::size_t(std::max(__m, __n - __m)) > __PSTL_ROTATE_BUFFER_CUT_OFF) {
+        return except_handler([__first, __middle, __last, __is_vector]() {
+            rotate_inplace(__first, __middle, __last, __is_vector);
+            return __first + (__last - __middle);
+        });
+    }
     if (__m <= __n / 2) {
         par_backend::buffer<_Tp> __buf(__n - __m);
         return except_handler([__n, __m, __first, __middle, __last, __is_vector, &__buf]() {
@@ -1409,8 +2357,7 @@ _ForwardIterator brick_partition(_ForwardIterator __first, _ForwardIterator __la
 
 template<class _ForwardIterator, class _UnaryPredicate>
 _ForwardIterator brick_partition(_ForwardIterator __first, _ForwardIterator __last, _UnaryPredicate __pred, /*is_vector=*/std::true_type) noexcept {
-    __PSTL_PRAGMA_MESSAGE("Vectorized algorithm unimplemented, redirected to serial");
-    return std::partition(__first, __last, __pred);
+    return unseq_backend::simd_partition(__first, __last - __first, __pred);
 }
 
 template<class _ForwardIterator, class _UnaryPredicate, class _IsVector>
@@ -1499,8 +2446,56 @@ _BidirectionalIterator pattern_stable_partition(_BidirectionalIterator __first,
     return internal::brick_stable_partition(__first, __last, __pred, __is_vector);
 }
 
+//! Move-construct the elements of [__first, __last) marked in __mask to __out_true and the others to __out_false.
+template<class _ForwardIterator, class _Tp>
+void brick_uninitialized_partition_by_mask(_ForwardIterator __first, _ForwardIterator __last, _Tp* __out_true, _Tp* __out_false, const mask_word* __mask) noexcept {
+    for (std::size_t __i = 0; __first != __last; ++__first, ++__i) {
+        if (mask_test(__mask, __i))
+            ::new (__out_true++) _Tp(std::move(*__first));
+        else
+            ::new (__out_false++) _Tp(std::move(*__first));
+    }
+}
+
+//! Parallel stable_partition through a temporary buffer.
+/** Counts the true and false elements of each chunk, prefix-sums the counts and scatters
+every element straight to its final offset in __buf, so each element is moved twice. */
+template<class _RandomAccessIterator, class _UnaryPredicate, class _IsVector>
+_RandomAccessIterator stable_partition_by_scan(_RandomAccessIterator __first, _RandomAccessIterator __last, _UnaryPredicate __pred, _IsVector __is_vector,
+    typename std::iterator_traits<_RandomAccessIterator>::value_type* __buf, mask_word* __mask) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type _Tp;
+    typedef typename std::iterator_traits<_RandomAccessIterator>::difference_type _DifferenceType;
+    typedef std::pair<_DifferenceType, _DifferenceType> _ReturnType;
+    const _DifferenceType __n = __last - __first;
+    const _DifferenceType __word_bits = __PSTL_MASK_WORD_BITS;
+    _DifferenceType __count_true = 0;
+
+    par_backend::parallel_strict_scan(mask_size(__n), std::make_pair(_DifferenceType(0), _DifferenceType(0)),
+        [=](_DifferenceType __i, _DifferenceType __len) {                                  // Reduce
+            return internal::brick_calc_mask_1<_DifferenceType>(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
+                __mask + __i, __pred, __is_vector);
+        },
+        [](const _ReturnType& __x, const _ReturnType& __y)-> _ReturnType {                  // Combine
+            return std::make_pair(__x.first + __y.first, __x.second + __y.second);
+        },
+        [=, &__count_true](_DifferenceType __i, _DifferenceType __len, _ReturnType __initial) { // Scan
+            internal::brick_uninitialized_partition_by_mask(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
+                __buf + __initial.first, __buf + (__count_true + __initial.second), __mask + __i);
+        },
+        [&__count_true](_ReturnType __total) { __count_true = __total.first; });
+
+    par_backend::parallel_for(__buf, __buf + __n, [__first, __buf, __is_vector](_Tp* __b, _Tp* __e) {
+        brick_move(__b, __e, __first + (__b - __buf), __is_vector);
+        par_backend::serial_destroy()(__b, __e);
+    });
+    return __first + __count_true;
+}
+
+//! Parallel stable_partition without additional memory.
+/** Partitions the chunks independently and merges neighbouring partitioned ranges by rotating
+the false part of the left range with the true part of the right one. */
 template<class _BidirectionalIterator, class _UnaryPredicate, class _IsVector>
-_BidirectionalIterator pattern_stable_partition(_BidirectionalIterator __first, _BidirectionalIterator __last, _UnaryPredicate __pred, _IsVector __is_vector, /*is_parallelization=*/std::true_type) noexcept {
+_BidirectionalIterator stable_partition_inplace(_BidirectionalIterator __first, _BidirectionalIterator __last, _UnaryPredicate __pred, _IsVector __is_vector) {
     // partitioned range: elements before pivot satisfy pred (true part),
     //                    elements after pivot don't satisfy pred (false part)
     struct _PartitionRange {
@@ -1508,39 +2503,55 @@ _BidirectionalIterator pattern_stable_partition(_BidirectionalIterator __first,
         _BidirectionalIterator __pivot;
         _BidirectionalIterator __end;
     };
-    typedef typename std::iterator_traits<_BidirectionalIterator>::value_type T;
 
-    return except_handler([&]() {
-        _PartitionRange __init{ __last, __last, __last };
+    _PartitionRange __init{ __last, __last, __last };
 
-        // lambda for merging two partitioned ranges to one partitioned range
-        auto __reductor = [__first, __is_vector, __pred](_PartitionRange __val1, _PartitionRange __val2)->_PartitionRange {
-            auto __size1 = __val1.__end - __val1.__pivot;
-            auto __size2 = __val2.__pivot - __val2.__begin;
-            auto __new_begin = __val2.__begin - (__val1.__end - __val1.__begin);
+    // lambda for merging two partitioned ranges to one partitioned range
+    auto __reductor = [__first, __is_vector, __pred](_PartitionRange __val1, _PartitionRange __val2)->_PartitionRange {
+        auto __size1 = __val1.__end - __val1.__pivot;
+        auto __size2 = __val2.__pivot - __val2.__begin;
+        auto __new_begin = __val2.__begin - (__val1.__end - __val1.__begin);
 
-            // if all elements in left range satisfy pred then we can move new pivot to pivot of right range
-            if (__val1.__end == __val1.__pivot) {
-                return { __new_begin, __val2.__pivot, __val2.__end };
-            }
-            // if true part of right range greater than false part of left range
-            // then we should swap the false part of left range and last part of true part of right range
-            else {
-                brick_rotate(__val1.__pivot, __val2.__begin, __val2.__pivot, __is_vector);
-                return { __new_begin, __val2.__pivot - __size1, __val2.__end };
-            }
-        };
+        // if all elements in left range satisfy pred then we can move new pivot to pivot of right range
+        if (__val1.__end == __val1.__pivot) {
+            return { __new_begin, __val2.__pivot, __val2.__end };
+        }
+        // if true part of right range greater than false part of left range
+        // then we should swap the false part of left range and last part of true part of right range
+        else {
+            rotate_inplace(__val1.__pivot, __val2.__begin, __val2.__pivot, __is_vector);
+            return { __new_begin, __val2.__pivot - __size1, __val2.__end };
+        }
+    };
 
-        _PartitionRange __result = par_backend::parallel_reduce(__first, __last, __init,
-            [__first, &__pred, __is_vector, __reductor](_BidirectionalIterator __i, _BidirectionalIterator __j, _PartitionRange __value)->_PartitionRange {
-                //1. serial stable_partition
-                _BidirectionalIterator __pivot = brick_stable_partition(__i, __j, __pred, __is_vector);
+    _PartitionRange __result = par_backend::parallel_reduce(__first, __last, __init,
+        [__first, &__pred, __is_vector, __reductor](_BidirectionalIterator __i, _BidirectionalIterator __j, _PartitionRange __value)->_PartitionRange {
+            //1. serial stable_partition
+            _BidirectionalIterator __pivot = brick_stable_partition(__i, __j, __pred, __is_vector);
 
-                // 2. merging of two ranges (left and right respectively)
-                return __reductor(__value, { __i, __pivot, __j });
-            },
-            __reductor);
-        return __result.__pivot;
+            // 2. merging of two ranges (left and right respectively)
+            return __reductor(__value, { __i, __pivot, __j });
+        },
+        __reductor);
+    return __result.__pivot;
+}
+
+template<class _BidirectionalIterator, class _UnaryPredicate, class _IsVector>
+_BidirectionalIterator pattern_stable_partition(_BidirectionalIterator __first, _BidirectionalIterator __last, _UnaryPredicate __pred, _IsVector __is_vector, /*is_parallelization=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_BidirectionalIterator>::value_type _Tp;
+    const auto __n = __last - __first;
+    if (__n > 1) {
+        // Under memory pressure fall back to the in-place algorithm rather than fail
+        par_backend::buffer<_Tp> __buf(__n, std::nothrow);
+        par_backend::buffer<mask_word> __mask_buf(__buf ? mask_size(__n) : 0, std::nothrow);
+        if (__buf && __mask_buf) {
+            return except_handler([&]() {
+                return stable_partition_by_scan(__first, __last, __pred, __is_vector, __buf.get(), __mask_buf.get());
+            });
+        }
+    }
+    return except_handler([&]() {
+        return stable_partition_inplace(__first, __last, __pred, __is_vector);
     });
 }
 
@@ -1557,11 +2568,7 @@ brick_partition_copy(_ForwardIterator __first, _ForwardIterator __last, _OutputI
 template<class _ForwardIterator, class _OutputIterator1, class _OutputIterator2, class _UnaryPredicate>
 std::pair<_OutputIterator1, _OutputIterator2>
 brick_partition_copy(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator1 __out_true, _OutputIterator2 __out_false, _UnaryPredicate __pred, /*is_vector=*/std::true_type) noexcept {
-#if (__PSTL_MONOTONIC_PRESENT)
     return unseq_backend::simd_partition_copy(__first, __last - __first, __out_true, __out_false, __pred);
-#else
-    return std::partition_copy(__first, __last, __out_true, __out_false, __pred);
-#endif
 }
 
 template<class _ForwardIterator, class _OutputIterator1, class _OutputIterator2, class _UnaryPredicate, class _IsVector>
@@ -1577,13 +2584,15 @@ pattern_partition_copy(_RandomAccessIterator __first, _RandomAccessIterator __la
     typedef std::pair<_DifferenceType, _DifferenceType> _ReturnType;
     const _DifferenceType __n = __last - __first;
     if (_DifferenceType(1) < __n) {
-        par_backend::buffer<bool> __mask_buf(__n);
-            return internal::except_handler([__n, __first, __last, __out_true, __out_false, __is_vector, __pred, &__mask_buf]() {
-                bool* __mask = __mask_buf.get();
+        const _DifferenceType __words = mask_size(__n);
+        par_backend::buffer<mask_word> __mask_buf(__words);
+            return internal::except_handler([__n, __words, __first, __last, __out_true, __out_false, __is_vector, __pred, &__mask_buf]() {
+                mask_word* __mask = __mask_buf.get();
+                const _DifferenceType __word_bits = __PSTL_MASK_WORD_BITS;
                 _ReturnType __m{};
-                par_backend::parallel_strict_scan(__n, std::make_pair(_DifferenceType(0), _DifferenceType(0)),
+                par_backend::parallel_strict_scan(__words, std::make_pair(_DifferenceType(0), _DifferenceType(0)),
                     [=](_DifferenceType __i, _DifferenceType __len) { // Reduce
-                        return internal::brick_calc_mask_1<_DifferenceType>(__first + __i, __first + (__i + __len),
+                        return internal::brick_calc_mask_1<_DifferenceType>(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
                         __mask + __i,
                         __pred,
                         __is_vector);
@@ -1592,7 +2601,7 @@ pattern_partition_copy(_RandomAccessIterator __first, _RandomAccessIterator __la
                     return std::make_pair(__x.first + __y.first, __x.second + __y.second);
                     },                                                                            // Combine
                     [=](_DifferenceType __i, _DifferenceType __len, _ReturnType __initial) {        // Scan
-                        internal::brick_partition_by_mask(__first + __i, __first + (__i + __len),
+                        internal::brick_partition_by_mask(__first + __i * __word_bits, __first + std::min((__i + __len) * __word_bits, __n),
                         __out_true + __initial.first,
                         __out_false + __initial.second,
                         __mask + __i,
@@ -1959,7 +2968,7 @@ _ForwardIterator pattern_remove_if(_ForwardIterator __first, _ForwardIterator __
     }
 
     return remove_elements(__first, __last,
-        [&__pred](bool* __it1, _ForwardIterator __it2) {*__it1 = !__pred(*__it2); },
+        [&__pred](_ForwardIterator __it) { return !__pred(*__it); },
         __is_vector);
 }
 
@@ -1985,9 +2994,12 @@ _OutputIterator pattern_merge(_ForwardIterator1 __first1, _ForwardIterator1 __la
 
 template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _OutputIterator, class _Compare, class _IsVector>
 _OutputIterator pattern_merge(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _RandomAccessIterator2 __last2, _OutputIterator __d_first, _Compare __comp, _IsVector __is_vector, /* is_parallel = */ std::true_type) {
-    par_backend::parallel_merge(__first1, __last1, __first2, __last2, __d_first, __comp,
-        [__is_vector](_RandomAccessIterator1 __f1, _RandomAccessIterator1 __l1, _RandomAccessIterator2 __f2, _RandomAccessIterator2 __l2, _OutputIterator __f3, _Compare __comp) {return brick_merge(__f1, __l1, __f2, __l2, __f3, __comp, __is_vector); });
-    return __d_first + (__last1 - __first1) + (__last2 - __first2);
+    typedef output_target_iterator_t<_OutputIterator> _TargetIterator;
+    output_target<_OutputIterator> __target(__d_first);
+    __target.grow((__last1 - __first1) + (__last2 - __first2));
+    par_backend::parallel_merge(__first1, __last1, __first2, __last2, __target.begin(), __comp,
+        [__is_vector](_RandomAccessIterator1 __f1, _RandomAccessIterator1 __l1, _RandomAccessIterator2 __f2, _RandomAccessIterator2 __l2, _TargetIterator __f3, _Compare __comp) {return brick_merge(__f1, __l1, __f2, __l2, __f3, __comp, __is_vector); });
+    return __target.result((__last1 - __first1) + (__last2 - __first2));
 }
 
 //------------------------------------------------------------------------
@@ -2097,6 +3109,85 @@ bool pattern_includes(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _Fo
     });
 }
 
+//------------------------------------------------------------------------
+// parallel set operations
+//------------------------------------------------------------------------
+
+//! Set operation over sorted random access ranges, with its result written to a random access or growable output.
+/** [__first1, __last1) is cut into chunks at positions that are moved back to the beginning of their runs of
+    equivalent elements, and [__first2, __last2) at the same values, so that the result is the concatenation of the
+    results of __set_op on the pairs of chunks. The results of the chunks are counted by a scan, the output is grown
+    to their total, and each chunk writes its result at its offset. */
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _OutputIterator, class _Compare, class _SetOp>
+_OutputIterator parallel_set_op(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2,
+                                _RandomAccessIterator2 __last2, _OutputIterator __result, _Compare __comp, _SetOp __set_op) {
+    typedef typename std::iterator_traits<_RandomAccessIterator1>::difference_type _DifferenceType;
+    // Least number of elements of the first range in a chunk
+    const _DifferenceType __chunk = 2048;
+    const _DifferenceType __n1 = __last1 - __first1;
+    const _DifferenceType __chunks = (__n1 + __chunk - 1) / __chunk;
+    if (__chunks < 2)
+        return __set_op(__first1, __last1, __first2, __last2, __result, __comp);
+
+    // Beginnings of the chunk __k in the ranges
+    auto __cut1 = [=](_DifferenceType __k) -> _RandomAccessIterator1 {
+        if (__k == 0 || __k == __chunks)
+            return __k == 0 ? __first1 : __last1;
+        const _RandomAccessIterator1 __it = __first1 + __k * __chunk;
+        return std::lower_bound(__first1, __it, *__it, __comp);
+    };
+    auto __cut2 = [=](_DifferenceType __k) -> _RandomAccessIterator2 {
+        if (__k == 0 || __k == __chunks)
+            return __k == 0 ? __first2 : __last2;
+        return std::lower_bound(__first2, __last2, *(__first1 + __k * __chunk), __comp);
+    };
+    output_target<_OutputIterator> __target(__result);
+    _DifferenceType __m{};
+    par_backend::parallel_strict_scan(__chunks, _DifferenceType(0),
+        [=](_DifferenceType __i, _DifferenceType __len) {                                   // Reduce
+            return __set_op(__cut1(__i), __cut1(__i + __len), __cut2(__i), __cut2(__i + __len),
+                            counting_output_iterator<_DifferenceType>(), __comp).count();
+        },
+        std::plus<_DifferenceType>(),                                                   // Combine
+        [=, &__target](_DifferenceType __i, _DifferenceType __len, _DifferenceType __initial) { // Scan
+            __set_op(__cut1(__i), __cut1(__i + __len), __cut2(__i), __cut2(__i + __len), __target.begin() + __initial, __comp);
+        },
+        [&__m, &__target](_DifferenceType __total) { __m = __total; __target.grow(__total); });
+    return __target.result(__m);
+}
+
+struct set_union_op {
+    template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare>
+    _OutputIterator operator()(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2,
+                               _OutputIterator __result, _Compare __comp) const {
+        return std::set_union(__first1, __last1, __first2, __last2, __result, __comp);
+    }
+};
+
+struct set_intersection_op {
+    template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare>
+    _OutputIterator operator()(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2,
+                               _OutputIterator __result, _Compare __comp) const {
+        return std::set_intersection(__first1, __last1, __first2, __last2, __result, __comp);
+    }
+};
+
+struct set_difference_op {
+    template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare>
+    _OutputIterator operator()(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2,
+                               _OutputIterator __result, _Compare __comp) const {
+        return std::set_difference(__first1, __last1, __first2, __last2, __result, __comp);
+    }
+};
+
+struct set_symmetric_difference_op {
+    template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare>
+    _OutputIterator operator()(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2,
+                               _OutputIterator __result, _Compare __comp) const {
+        return std::set_symmetric_difference(__first1, __last1, __first2, __last2, __result, __comp);
+    }
+};
+
 //------------------------------------------------------------------------
 // set_union
 //------------------------------------------------------------------------
@@ -2118,10 +3209,11 @@ _OutputIterator pattern_set_union(_ForwardIterator1 __first1, _ForwardIterator1
     return internal::brick_set_union(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
 }
 
-template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare, class _IsVector>
-_OutputIterator pattern_set_union(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector __is_vector, /*is_parallel=*/std::true_type) noexcept {
-    __PSTL_PRAGMA_MESSAGE("Parallel algorithm unimplemented, redirected to serial");
-    return internal::brick_set_union(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _OutputIterator, class _Compare, class _IsVector>
+_OutputIterator pattern_set_union(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _RandomAccessIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector, /*is_parallel=*/std::true_type) {
+    return internal::except_handler([&]() {
+        return internal::parallel_set_op(__first1, __last1, __first2, __last2, __result, __comp, set_union_op());
+    });
 }
 
 //------------------------------------------------------------------------
@@ -2144,10 +3236,11 @@ _OutputIterator pattern_set_intersection(_ForwardIterator1 __first1, _ForwardIte
     return internal::brick_set_intersection(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
 }
 
-template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare, class _IsVector>
-_OutputIterator pattern_set_intersection(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector __is_vector, /*is_parallel=*/std::true_type) noexcept {
-    __PSTL_PRAGMA_MESSAGE("Parallel algorithm unimplemented, redirected to serial");
-    return internal::brick_set_intersection(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _OutputIterator, class _Compare, class _IsVector>
+_OutputIterator pattern_set_intersection(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _RandomAccessIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector, /*is_parallel=*/std::true_type) {
+    return internal::except_handler([&]() {
+        return internal::parallel_set_op(__first1, __last1, __first2, __last2, __result, __comp, set_intersection_op());
+    });
 }
 
 //------------------------------------------------------------------------
@@ -2170,10 +3263,11 @@ _OutputIterator pattern_set_difference(_ForwardIterator1 __first1, _ForwardItera
     return internal::brick_set_difference(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
 }
 
-template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare, class _IsVector>
-_OutputIterator pattern_set_difference(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector __is_vector, /*is_parallel=*/std::true_type) noexcept {
-    __PSTL_PRAGMA_MESSAGE("Parallel algorithm unimplemented, redirected to serial");
-    return internal::brick_set_difference(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _OutputIterator, class _Compare, class _IsVector>
+_OutputIterator pattern_set_difference(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _RandomAccessIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector, /*is_parallel=*/std::true_type) {
+    return internal::except_handler([&]() {
+        return internal::parallel_set_op(__first1, __last1, __first2, __last2, __result, __comp, set_difference_op());
+    });
 }
 
 //------------------------------------------------------------------------
@@ -2196,10 +3290,11 @@ _OutputIterator pattern_set_symmetric_difference(_ForwardIterator1 __first1, _Fo
     return internal::brick_set_symmetric_difference(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
 }
 
-template<class _ForwardIterator1, class _ForwardIterator2, class _OutputIterator, class _Compare, class _IsVector>
-_OutputIterator pattern_set_symmetric_difference(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector __is_vector, /*is_parallel=*/std::true_type) noexcept {
-    __PSTL_PRAGMA_MESSAGE("Parallel algorithm unimplemented, redirected to serial");
-    return internal::brick_set_symmetric_difference(__first1, __last1, __first2, __last2, __result, __comp, __is_vector);
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _OutputIterator, class _Compare, class _IsVector>
+_OutputIterator pattern_set_symmetric_difference(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _RandomAccessIterator2 __last2, _OutputIterator __result, _Compare __comp, _IsVector, /*is_parallel=*/std::true_type) {
+    return internal::except_handler([&]() {
+        return internal::parallel_set_op(__first1, __last1, __first2, __last2, __result, __comp, set_symmetric_difference_op());
+    });
 }
 
 //------------------------------------------------------------------------
@@ -2273,11 +3368,7 @@ _ForwardIterator brick_min_element(_ForwardIterator __first, _ForwardIterator __
 
 template <typename _ForwardIterator, typename _Compare>
 _ForwardIterator brick_min_element(_ForwardIterator __first, _ForwardIterator __last, _Compare __comp, /* __is_vector = */ std::true_type) noexcept {
-#if __PSTL_UDR_PRESENT
     return unseq_backend::simd_min_element(__first, __last - __first, __comp);
-#else
-    return std::min_element(__first, __last, __comp);
-#endif
 }
 
 template <typename _ForwardIterator, typename _Compare, typename _IsVector>
@@ -2315,11 +3406,7 @@ std::pair<_ForwardIterator, _ForwardIterator> brick_minmax_element(_ForwardItera
 
 template <typename _ForwardIterator, typename _Compare>
 std::pair<_ForwardIterator, _ForwardIterator> brick_minmax_element(_ForwardIterator __first, _ForwardIterator __last, _Compare __comp, /* __is_vector = */ std::true_type) noexcept {
-#if __PSTL_UDR_PRESENT
     return unseq_backend::simd_minmax_element(__first, __last - __first, __comp);
-#else
-    return std::minmax_element(__first, __last, __comp);
-#endif
 }
 
 template <typename _ForwardIterator, typename _Compare, typename _IsVector>
@@ -2365,7 +3452,8 @@ std::pair<_ForwardIterator1, _ForwardIterator2> mismatch_serial(_ForwardIterator
 }
 
 template <class _ForwardIterator1, class _ForwardIterator2, class _Predicate>
-std::pair<_ForwardIterator1, _ForwardIterator2> brick_mismatch(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Predicate __pred, /* __is_vector = */ std::false_type) noexcept {
+std::pair<_ForwardIterator1, _ForwardIterator2> brick_mismatch(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Predicate __pred,
+                                                               /* __is_vector = */ std::false_type, /*dispatch=*/std::false_type) noexcept {
     return internal::mismatch_serial(__first1, __last1, __first2, __last2, __pred);
 }
 
@@ -2375,6 +3463,19 @@ std::pair<_ForwardIterator1, _ForwardIterator2> brick_mismatch(_ForwardIterator1
     return unseq_backend::simd_first(__first1, __n, __first2, not_pred<_Predicate>(__pred));
 }
 
+// As for equal, the default predicate on contiguous arithmetic sequences is served by the dispatched kernels whatever the policy
+template <class _RandomAccessIterator1, class _RandomAccessIterator2, class _Predicate>
+std::pair<_RandomAccessIterator1, _RandomAccessIterator2> brick_mismatch(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _RandomAccessIterator2 __last2, _Predicate __pred,
+                                                                         /* __is_vector = */ std::false_type, /*dispatch=*/std::true_type) noexcept {
+    return internal::brick_mismatch(__first1, __last1, __first2, __last2, __pred, std::true_type());
+}
+
+template <class _ForwardIterator1, class _ForwardIterator2, class _Predicate>
+std::pair<_ForwardIterator1, _ForwardIterator2> brick_mismatch(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Predicate __pred, /* __is_vector = */ std::false_type) noexcept {
+    return internal::brick_mismatch(__first1, __last1, __first2, __last2, __pred, std::false_type(),
+        typename unseq_backend::is_dispatch_equal_ranges<_ForwardIterator1, _ForwardIterator2, _Predicate>::type());
+}
+
 template <class _ForwardIterator1, class _ForwardIterator2, class _Predicate, class _IsVector>
 std::pair<_ForwardIterator1, _ForwardIterator2> pattern_mismatch(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Predicate __pred, _IsVector __is_vector, /* is_parallel = */ std::false_type) noexcept {
     return internal::brick_mismatch(__first1, __last1, __first2, __last2, __pred, __is_vector);
@@ -2398,12 +3499,14 @@ std::pair<_RandomAccessIterator1, _RandomAccessIterator2> pattern_mismatch(_Rand
 //------------------------------------------------------------------------
 
 template<class _ForwardIterator1, class _ForwardIterator2, class _Compare>
-bool brick_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Compare __comp, /* __is_vector = */ std::false_type) noexcept {
+bool brick_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Compare __comp,
+                                   /* __is_vector = */ std::false_type, /*dispatch=*/std::false_type) noexcept {
     return std::lexicographical_compare(__first1, __last1, __first2, __last2, __comp);
 }
 
 template<class _ForwardIterator1, class _ForwardIterator2, class _Compare>
-bool brick_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Compare __comp, /* __is_vector = */ std::true_type) noexcept {
+bool brick_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Compare __comp,
+                                   /* __is_vector = */ std::true_type, /*dispatch=*/std::false_type) noexcept {
     if (__first2 == __last2) { // if second sequence is empty
         return false;
     }
@@ -2428,6 +3531,48 @@ bool brick_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterator1
     }
 }
 
+//! First position in [__first1, __last1) where the elements are not equivalent under __comp
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _Compare, class _IsVector>
+_RandomAccessIterator1 brick_lexicographical_mismatch(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _Compare __comp,
+                                                      _IsVector __is_vector, /*dispatch=*/std::false_type) noexcept {
+    typedef typename std::iterator_traits<_RandomAccessIterator1>::reference _RefType1;
+    typedef typename std::iterator_traits<_RandomAccessIterator2>::reference _RefType2;
+    return internal::brick_mismatch(__first1, __last1, __first2, __first2 + (__last1 - __first1),
+        [&__comp](const _RefType1 __x, const _RefType2 __y) {return !__comp(__x, __y) && !__comp(__y, __x); }, __is_vector).first;
+}
+
+// "<" of integers: equivalence is equality, which the dispatched kernels test
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _Compare, class _IsVector>
+_RandomAccessIterator1 brick_lexicographical_mismatch(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _Compare,
+                                                      _IsVector, /*dispatch=*/std::true_type) noexcept {
+    return internal::brick_mismatch(__first1, __last1, __first2, __first2 + (__last1 - __first1), pstl_equal(), std::true_type()).first;
+}
+
+template<class _RandomAccessIterator1, class _RandomAccessIterator2, class _Compare, class _IsVector>
+bool brick_lexicographical_compare(_RandomAccessIterator1 __first1, _RandomAccessIterator1 __last1, _RandomAccessIterator2 __first2, _RandomAccessIterator2 __last2, _Compare __comp,
+                                   _IsVector __is_vector, /*dispatch=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_RandomAccessIterator1>::value_type _Tp;
+    const auto __n1 = __last1 - __first1;
+    const auto __n2 = __last2 - __first2;
+    const auto __n = std::min<decltype(__n1)>(__n1, __n2);
+    // Unsigned bytes are ordered as memcmp orders them
+    if (std::is_unsigned<_Tp>::value && sizeof(_Tp) == 1 && __n > 0) {
+        const int __res = std::memcmp(std::addressof(*__first1), std::addressof(*__first2), __n);
+        return __res != 0 ? __res < 0 : __n1 < __n2;
+    }
+    const _RandomAccessIterator1 __result = internal::brick_lexicographical_mismatch(__first1, __first1 + __n, __first2, __comp, __is_vector, std::true_type());
+    if (__result == __first1 + __n) {
+        return __n1 < __n2;
+    }
+    return __comp(*__result, *(__first2 + (__result - __first1)));
+}
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _Compare, class _IsVector>
+bool brick_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Compare __comp, _IsVector __is_vector) noexcept {
+    return internal::brick_lexicographical_compare(__first1, __last1, __first2, __last2, __comp, __is_vector,
+        typename unseq_backend::is_dispatch_less_ranges<_ForwardIterator1, _ForwardIterator2, _Compare>::type());
+}
+
 template<class _ForwardIterator1, class _ForwardIterator2, class _Compare, class _IsVector>
 bool pattern_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2, _ForwardIterator2 __last2, _Compare __comp, _IsVector __is_vector, /* is_parallel = */ std::false_type) noexcept {
     return internal::brick_lexicographical_compare(__first1, __last1, __first2, __last2, __comp, __is_vector);
@@ -2442,14 +3587,12 @@ bool pattern_lexicographical_compare(_ForwardIterator1 __first1, _ForwardIterato
         return true;
     }
     else {
-        typedef typename std::iterator_traits<_ForwardIterator1>::reference _RefType1;
-        typedef typename std::iterator_traits<_ForwardIterator2>::reference _RefType2;
         --__last1;
         --__last2;
         auto __n = std::min(__last1 - __first1, __last2 - __first2);
         auto __result = internal::parallel_find(__first1, __first1 + __n, [__first1, __first2, &__comp, __is_vector](_ForwardIterator1 __i, _ForwardIterator1 __j) {
-            return brick_mismatch(__i, __j, __first2 + (__i - __first1), __first2 + (__j - __first1),
-                [&__comp](const _RefType1 __x, const _RefType2 __y) {return !__comp(__x, __y) && !__comp(__y, __x); }, __is_vector).first;
+            return internal::brick_lexicographical_mismatch(__i, __j, __first2 + (__i - __first1), __comp, __is_vector,
+                typename unseq_backend::is_dispatch_less_ranges<_ForwardIterator1, _ForwardIterator2, _Compare>::type());
         },
         std::less<typename std::iterator_traits<_ForwardIterator1>::difference_type>(), /*is_first=*/true);
 
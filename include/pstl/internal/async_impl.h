@@ -0,0 +1,140 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_async_impl_H
+#define __PSTL_async_impl_H
+
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "parallel_backend.h"
+
+namespace __pstl {
+namespace internal {
+
+//! Storage for the result of asynchronous work, constructed when the work completes
+template<typename _Tp>
+class async_value {
+    typename std::aligned_storage<sizeof(_Tp), alignof(_Tp)>::type _M_storage;
+    bool _M_set;
+    _Tp* ptr() { return reinterpret_cast<_Tp*>(&_M_storage); }
+public:
+    async_value() : _M_set(false) {}
+    template<typename _Fp>
+    void set(const _Fp& __f) {
+        ::new (static_cast<void*>(ptr())) _Tp(__f());
+        _M_set = true;
+    }
+    _Tp get() { return std::move(*ptr()); }
+    const _Tp& value() const { return *reinterpret_cast<const _Tp*>(&_M_storage); }
+    ~async_value() { if (_M_set) ptr()->~_Tp(); }
+};
+
+template<>
+class async_value<void> {
+public:
+    template<typename _Fp>
+    void set(const _Fp& __f) { __f(); }
+    void get() {}
+};
+
+//! State shared by an async::future and the work it refers to
+/** The work is started by the constructor; the destructor waits for it, so that the work never outlives
+the state it writes its result to. */
+template<typename _Tp>
+class async_state {
+    par_backend::async_task _M_task;
+    async_value<_Tp> _M_value;
+    std::exception_ptr _M_exception;
+    std::atomic<bool> _M_ready;
+public:
+    template<typename _Fp>
+    explicit async_state(_Fp __f) : _M_ready(false) {
+        _M_task.run([this, __f]() {
+            try {
+                _M_value.set(__f);
+            }
+            catch(...) {
+                _M_exception = std::current_exception();
+            }
+            _M_ready.store(true, std::memory_order_release);
+        });
+    }
+    bool is_ready() const { return _M_ready.load(std::memory_order_acquire); }
+    void wait() { _M_task.wait(); }
+    _Tp get() {
+        _M_task.wait();
+        if (_M_exception)
+            std::rethrow_exception(_M_exception);
+        return _M_value.get();
+    }
+    ~async_state() { _M_task.wait(); }
+};
+
+template<typename _Fp>
+using async_result_t = decltype(std::declval<const _Fp&>()());
+
+} // namespace internal
+
+namespace async {
+
+//! Result of an algorithm started by one of the async:: functions
+/** Unlike std::future, waiting for the result does not block the waiting thread: it runs tasks of the
+algorithm, or of other parallel work, until the result is ready. Like the std::future returned by std::async,
+a future that still refers to work waits for it on destruction. */
+template<typename _Tp>
+class future {
+    std::unique_ptr<internal::async_state<_Tp>> _M_state;
+public:
+    future() noexcept {}
+    explicit future(internal::async_state<_Tp>* __state) : _M_state(__state) {}
+    future(future&&) = default;
+    future& operator=(future&&) = default;
+
+    //! True if the future refers to work, i.e. get() has not yet been called
+    bool valid() const noexcept { return bool(_M_state); }
+    //! True if the work has completed, so that get() would not wait; does not wait itself
+    bool is_ready() const { return _M_state->is_ready(); }
+    //! Help run the work until it completes
+    void wait() const { _M_state->wait(); }
+    //! Wait for the work, then return its result or rethrow the exception that ended it; invalidates the future
+    _Tp get() {
+        std::unique_ptr<internal::async_state<_Tp>> __state(std::move(_M_state));
+        return __state->get();
+    }
+};
+
+} // namespace async
+
+namespace internal {
+
+//! Start __f() in the background and return the future of its result
+template<typename _Fp>
+async::future<async_result_t<_Fp>> async_launch(_Fp __f) {
+    return async::future<async_result_t<_Fp>>(new async_state<async_result_t<_Fp>>(__f));
+}
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_async_impl_H */
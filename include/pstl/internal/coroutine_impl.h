@@ -0,0 +1,94 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_coroutine_impl_H
+#define __PSTL_coroutine_impl_H
+
+#include <coroutine>
+#include <exception>
+#include <utility>
+
+#include "async_impl.h"
+#include "parallel_backend.h"
+
+namespace __pstl {
+namespace co {
+
+//! Executor that resumes the awaiting coroutine on the worker thread that completed the algorithm
+struct inline_executor {
+    template<typename _Fp>
+    void execute(_Fp __f) const { __f(); }
+};
+
+//! Result of the co:: functions: the algorithm, started when a coroutine awaits it
+/** The awaiting coroutine is suspended while a worker thread runs the algorithm, then resumed with the result
+through __executor.execute(__resume). The default executor resumes it on the worker thread; pass the executor
+of an event loop to via() to be resumed there instead. */
+template<typename _Fp, typename _Executor = inline_executor>
+class awaitable {
+    typedef internal::async_result_t<_Fp> _Tp;
+    _Fp _M_f;
+    _Executor _M_executor;
+    internal::async_value<_Tp> _M_value;
+    std::exception_ptr _M_exception;
+    awaitable(const awaitable&) = delete;
+    void operator=(const awaitable&) = delete;
+public:
+    awaitable(_Fp __f, _Executor __executor) : _M_f(std::move(__f)), _M_executor(std::move(__executor)) {}
+
+    //! The same algorithm, resuming the awaiting coroutine through __executor
+    template<typename _OtherExecutor>
+    awaitable<_Fp, _OtherExecutor> via(_OtherExecutor __executor) && {
+        return awaitable<_Fp, _OtherExecutor>(std::move(_M_f), std::move(__executor));
+    }
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(std::coroutine_handle<> __h) {
+        par_backend::async_enqueue([this, __h]() {
+            try {
+                _M_value.set(_M_f);
+            }
+            catch(...) {
+                _M_exception = std::current_exception();
+            }
+            // The coroutine may be resumed, and destroy *this, before execute() returns
+            _Executor __executor(std::move(_M_executor));
+            __executor.execute([__h]() { __h.resume(); });
+        });
+    }
+    _Tp await_resume() {
+        if (_M_exception)
+            std::rethrow_exception(_M_exception);
+        return _M_value.get();
+    }
+};
+
+} // namespace co
+
+namespace internal {
+
+template<typename _Fp>
+co::awaitable<_Fp> co_launch(_Fp __f) {
+    return co::awaitable<_Fp>(std::move(__f), co::inline_executor());
+}
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_coroutine_impl_H */
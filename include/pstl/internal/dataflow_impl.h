@@ -0,0 +1,327 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_dataflow_impl_H
+#define __PSTL_dataflow_impl_H
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "pstl_config.h"
+#include "execution_impl.h"
+#include "utils.h"
+#include "async_impl.h"
+#include "parallel_backend.h"
+
+// A dataflow graph records algorithm calls, its nodes, and runs them later, each as soon as the nodes it
+// depends on have completed. A node depends on an earlier one if one of them writes memory that the other
+// reads or writes, or if it takes the result of the earlier one as an argument. The memory of a node is
+// known when its sequences are contiguous; a node over other sequences depends on, and is depended on by,
+// every other node.
+//
+// Element-wise algorithms (for_each, transform, copy, fill) over the same index space are fused when one
+// depends only on the other and the sequences they share are the same: the fused node runs the stages on a
+// chunk of __PSTL_DATAFLOW_CHUNK elements after the other, so that the data of a chunk stays in cache.
+
+#ifndef __PSTL_DATAFLOW_CHUNK
+//! Number of elements that the stages of a fused element-wise node process in turn
+#define __PSTL_DATAFLOW_CHUNK 2048
+#endif
+
+namespace __pstl {
+namespace dataflow {
+template<typename _Tp> class result;
+class graph;
+} // namespace dataflow
+
+namespace internal {
+
+//! Bytes [_M_first, _M_last) that a node reads or writes
+struct dataflow_extent {
+    const char* _M_first;
+    const char* _M_last;
+    bool overlaps(const dataflow_extent& __other) const {
+        return _M_first < __other._M_last && __other._M_first < _M_last;
+    }
+    bool operator==(const dataflow_extent& __other) const {
+        return _M_first == __other._M_first && _M_last == __other._M_last;
+    }
+};
+
+//! Iterators whose elements have known addresses: pointers and the iterators of std::vector
+template<typename _Iterator, typename _Tp = typename std::iterator_traits<_Iterator>::value_type>
+struct is_dataflow_contiguous : std::integral_constant<bool,
+    std::is_pointer<_Iterator>::value || (!std::is_same<_Tp, bool>::value &&
+    (std::is_same<_Iterator, typename std::vector<_Tp>::iterator>::value ||
+     std::is_same<_Iterator, typename std::vector<_Tp>::const_iterator>::value))> {};
+
+class dataflow_elementwise_node;
+
+//! An algorithm call of a dataflow graph
+class dataflow_node {
+public:
+    std::vector<dataflow_extent> _M_reads;
+    std::vector<dataflow_extent> _M_writes;
+    //! True if the node touches memory whose addresses are not known
+    bool _M_unknown;
+    //! Nodes whose results the node takes as arguments
+    std::vector<std::size_t> _M_after;
+
+    dataflow_node() : _M_unknown(false) {}
+    virtual ~dataflow_node() {}
+    virtual void run() = 0;
+    //! The node as an element-wise one, which later element-wise nodes may be fused into, or null
+    virtual dataflow_elementwise_node* elementwise() { return nullptr; }
+
+    //! Note that the node reads (or writes) the elements of [__first, __last)
+    template<typename _Iterator>
+    void touch(_Iterator __first, _Iterator __last, bool __write) {
+        touch(__first, __last, __write, is_dataflow_contiguous<_Iterator>());
+    }
+    template<typename _Iterator>
+    void touch(_Iterator __first, _Iterator __last, bool __write, /*is_contiguous=*/ std::true_type) {
+        if (__first == __last)
+            return;
+        const char* __begin = reinterpret_cast<const char*>(std::addressof(*__first));
+        dataflow_extent __extent = {__begin,
+            __begin + (__last - __first) * sizeof(typename std::iterator_traits<_Iterator>::value_type)};
+        (__write ? _M_writes : _M_reads).push_back(__extent);
+    }
+    template<typename _Iterator>
+    void touch(_Iterator, _Iterator, bool, /*is_contiguous=*/ std::false_type) {
+        _M_unknown = true;
+    }
+
+    //! Note that the node reads (or writes) as many elements from __other as there are in [__first, __last)
+    template<typename _Iterator1, typename _Iterator2>
+    void touch_along(_Iterator1 __first, _Iterator1 __last, _Iterator2 __other, bool __write) {
+        touch_along(__first, __last, __other, __write, std::integral_constant<bool,
+            is_dataflow_contiguous<_Iterator1>::value && is_dataflow_contiguous<_Iterator2>::value>());
+    }
+    template<typename _Iterator1, typename _Iterator2>
+    void touch_along(_Iterator1 __first, _Iterator1 __last, _Iterator2 __other, bool __write, /*is_contiguous=*/ std::true_type) {
+        touch(__other, __other + (__last - __first), __write, std::true_type());
+    }
+    template<typename _Iterator1, typename _Iterator2>
+    void touch_along(_Iterator1, _Iterator1, _Iterator2, bool, /*is_contiguous=*/ std::false_type) {
+        _M_unknown = true;
+    }
+
+    //! Whether the node must wait for __before, an earlier node, or the other way round
+    bool conflicts(const dataflow_node& __before) const {
+        if (_M_unknown || __before._M_unknown)
+            return true;
+        return overlap(__before._M_writes, _M_reads) || overlap(__before._M_writes, _M_writes) ||
+               overlap(__before._M_reads, _M_writes);
+    }
+    static bool overlap(const std::vector<dataflow_extent>& __xs, const std::vector<dataflow_extent>& __ys) {
+        for (const dataflow_extent& __x: __xs)
+            for (const dataflow_extent& __y: __ys)
+                if (__x.overlaps(__y))
+                    return true;
+        return false;
+    }
+};
+
+//! A node that calls _Fp
+template<typename _Fp>
+class dataflow_call_node: public dataflow_node {
+    _Fp _M_f;
+public:
+    explicit dataflow_call_node(_Fp __f) : _M_f(std::move(__f)) {}
+    void run() override { _M_f(); }
+};
+
+template<typename _Fp>
+std::unique_ptr<dataflow_node> make_dataflow_call(_Fp __f) {
+    return std::unique_ptr<dataflow_node>(new dataflow_call_node<_Fp>(std::move(__f)));
+}
+
+//! A stage of an element-wise node: runs its algorithm on the elements [__i, __j) of the index space
+class dataflow_stage {
+public:
+    virtual ~dataflow_stage() {}
+    virtual void run(std::size_t __i, std::size_t __j) = 0;
+};
+
+template<typename _Fp>
+class dataflow_stage_impl: public dataflow_stage {
+    _Fp _M_f;
+public:
+    explicit dataflow_stage_impl(_Fp __f) : _M_f(std::move(__f)) {}
+    void run(std::size_t __i, std::size_t __j) override { _M_f(__i, __j); }
+};
+
+template<typename _Fp>
+std::unique_ptr<dataflow_stage> make_dataflow_stage(_Fp __f) {
+    return std::unique_ptr<dataflow_stage>(new dataflow_stage_impl<_Fp>(std::move(__f)));
+}
+
+//! A node of element-wise stages over the index space [0, _M_size), run one chunk after the other
+class dataflow_elementwise_node: public dataflow_node {
+public:
+    std::size_t _M_size;
+    bool _M_parallel;
+    std::vector<std::unique_ptr<dataflow_stage>> _M_stages;
+
+    dataflow_elementwise_node(std::size_t __size, bool __parallel) : _M_size(__size), _M_parallel(__parallel) {}
+    dataflow_elementwise_node* elementwise() override { return this; }
+    void run() override {
+        if (_M_parallel)
+            par_backend::parallel_for(std::size_t(0), _M_size, [this](std::size_t __i, std::size_t __j) { run_chunks(__i, __j); });
+        else
+            run_chunks(0, _M_size);
+    }
+    void run_chunks(std::size_t __i, std::size_t __j) {
+        while (__i < __j) {
+            std::size_t __k = __i + std::min<std::size_t>(__j - __i, __PSTL_DATAFLOW_CHUNK);
+            for (std::unique_ptr<dataflow_stage>& __stage: _M_stages)
+                __stage->run(__i, __k);
+            __i = __k;
+        }
+    }
+
+    //! Whether __next, a node that depends on this one only, may run as further stages of this node
+    /** Fusion moves the work of __next earlier, among the chunks of this node: every element that both touch,
+    and one of them writes, must be at the same position of the index space, i.e. in the same sequence. */
+    bool can_fuse(const dataflow_elementwise_node& __next) const {
+        if (_M_unknown || __next._M_unknown || _M_size != __next._M_size || _M_parallel != __next._M_parallel ||
+            !__next._M_after.empty())
+            return false;
+        return aligned(_M_writes, __next._M_reads) && aligned(_M_writes, __next._M_writes) &&
+               aligned(_M_reads, __next._M_writes);
+    }
+    static bool aligned(const std::vector<dataflow_extent>& __xs, const std::vector<dataflow_extent>& __ys) {
+        for (const dataflow_extent& __x: __xs)
+            for (const dataflow_extent& __y: __ys)
+                if (__x.overlaps(__y) && !(__x == __y))
+                    return false;
+        return true;
+    }
+    void fuse(dataflow_elementwise_node& __next) {
+        _M_reads.insert(_M_reads.end(), __next._M_reads.begin(), __next._M_reads.end());
+        _M_writes.insert(_M_writes.end(), __next._M_writes.begin(), __next._M_writes.end());
+        for (std::unique_ptr<dataflow_stage>& __stage: __next._M_stages)
+            _M_stages.push_back(std::move(__stage));
+    }
+};
+
+//! Where a node puts its result
+template<typename _Tp>
+struct dataflow_slot {
+    async_value<_Tp> _M_value;
+    //! The node computing the result
+    std::size_t _M_node;
+    //! For an iterator result, the furthest position it may take
+    _Tp _M_bound;
+    dataflow_slot(std::size_t __node, _Tp __bound) : _M_node(__node), _M_bound(__bound) {}
+};
+
+//! The arguments of the nodes are either values or the results of earlier nodes
+template<typename _Tp>
+const _Tp& dataflow_get(const _Tp& __x) { return __x; }
+template<typename _Tp>
+const _Tp& dataflow_get(const dataflow::result<_Tp>& __r);
+
+//! The furthest position of an iterator argument
+template<typename _Tp>
+_Tp dataflow_bound(const _Tp& __x) { return __x; }
+template<typename _Tp>
+_Tp dataflow_bound(const dataflow::result<_Tp>& __r);
+
+//! Note the nodes whose results are among __args
+inline void dataflow_after(dataflow_node&) {}
+template<typename _Tp, typename... _Args>
+void dataflow_after(dataflow_node& __node, const dataflow::result<_Tp>& __r, const _Args&... __args);
+template<typename _Tp, typename... _Args>
+void dataflow_after(dataflow_node& __node, const _Tp&, const _Args&... __args) { dataflow_after(__node, __args...); }
+
+} // namespace internal
+
+namespace dataflow {
+
+//! The result of a node of a graph, available once graph::run() has returned.
+/** A result may be passed to later nodes in place of a value, or as the end of a sequence when it is an
+iterator, e.g. the one returned by unique; such a node runs once the result is known. */
+template<typename _Tp>
+class result {
+    std::shared_ptr<internal::dataflow_slot<_Tp>> _M_slot;
+    friend class graph;
+    template<typename _Up>
+    friend const _Up& internal::dataflow_get(const result<_Up>&);
+    template<typename _Up>
+    friend _Up internal::dataflow_bound(const result<_Up>&);
+    template<typename _Up, typename... _Args>
+    friend void internal::dataflow_after(internal::dataflow_node&, const result<_Up>&, const _Args&...);
+    explicit result(std::shared_ptr<internal::dataflow_slot<_Tp>> __slot) : _M_slot(std::move(__slot)) {}
+public:
+    const _Tp& get() const { return _M_slot->_M_value.value(); }
+};
+
+} // namespace dataflow
+
+namespace internal {
+
+template<typename _Tp>
+const _Tp& dataflow_get(const dataflow::result<_Tp>& __r) { return __r._M_slot->_M_value.value(); }
+
+template<typename _Tp>
+_Tp dataflow_bound(const dataflow::result<_Tp>& __r) { return __r._M_slot->_M_bound; }
+
+template<typename _Tp, typename... _Args>
+void dataflow_after(dataflow_node& __node, const dataflow::result<_Tp>& __r, const _Args&... __args) {
+    __node._M_after.push_back(__r._M_slot->_M_node);
+    dataflow_after(__node, __args...);
+}
+
+template<typename _Iterator1, typename _Iterator2>
+_Iterator2 dataflow_along(_Iterator1 __first, _Iterator1 __last, _Iterator2 __result, /*is_random_access=*/ std::true_type) {
+    return __result + (__last - __first);
+}
+
+template<typename _Iterator1, typename _Iterator2>
+_Iterator2 dataflow_along(_Iterator1, _Iterator1, _Iterator2 __result, /*is_random_access=*/ std::false_type) {
+    return __result;
+}
+
+//! __result advanced by the length of [__first, __last) if that is cheap, i.e. the bound of the output of a node
+template<typename _Iterator1, typename _Iterator2>
+_Iterator2 dataflow_along(_Iterator1 __first, _Iterator1 __last, _Iterator2 __result) {
+    return dataflow_along(__first, __last, __result, typename is_random_access_iterator<_Iterator1, _Iterator2>::type());
+}
+
+//! Whether a node over [__first, __last) is element-wise: its end is known, and its iterators are random access
+template<typename _Last, typename _Iterator, typename... _OtherIterators>
+using is_dataflow_elementwise = std::integral_constant<bool,
+    std::is_same<_Last, _Iterator>::value && is_random_access_iterator<_Iterator, _OtherIterators...>::value>;
+
+//! Policy of the stages of an element-wise node, which runs the chunks of its index space in parallel itself
+template<typename _ExecutionPolicy>
+using dataflow_stage_policy = typename std::conditional<allow_vector<_ExecutionPolicy>::value,
+    pstl::execution::unsequenced_policy, pstl::execution::sequenced_policy>::type;
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_dataflow_impl_H */
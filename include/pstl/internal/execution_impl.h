@@ -23,8 +23,10 @@
 
 #include <iterator>
 #include <type_traits>
+#include <utility>
 
 #include "execution_defs.h"
+#include "segmented_impl.h"
 
 namespace __pstl {
 namespace internal {
@@ -59,6 +61,26 @@ struct is_random_access_iterator<_IteratorType>
                    std::random_access_iterator_tag> {
 };
 
+template<typename _IteratorType, typename... _OtherIteratorTypes>
+struct is_forward_iterator {
+    static constexpr bool value =
+        is_forward_iterator<_IteratorType>::value &&
+        is_forward_iterator<_OtherIteratorTypes...>::value;
+    typedef std::integral_constant<bool, value> type;
+};
+
+template<typename _IteratorType>
+struct is_forward_iterator<_IteratorType>
+    : std::is_base_of<std::forward_iterator_tag, typename std::iterator_traits<_IteratorType>::iterator_category> {
+};
+
+//! Forward iterators that are not all random access ones
+template<typename... _IteratorTypes>
+struct is_forward_only_iterator {
+    static constexpr bool value =
+        is_forward_iterator<_IteratorTypes...>::value && !is_random_access_iterator<_IteratorTypes...>::value;
+    typedef std::integral_constant<bool, value> type;
+};
 
 /* policy */
 template<typename Policy>
@@ -128,6 +150,54 @@ decltype(lazy_and( __exec.__allow_parallel(), typename is_random_access_iterator
     return internal::lazy_and( __exec.__allow_parallel(), typename is_random_access_iterator<_IteratorTypes...>::type() );
 }
 
+//! Single-pass input iterators whose elements cannot be modified through them
+template<typename _IteratorType, typename _Reference = typename std::iterator_traits<_IteratorType>::reference>
+struct is_read_only_input_iterator {
+    static constexpr bool value =
+        std::is_base_of<std::input_iterator_tag, typename std::iterator_traits<_IteratorType>::iterator_category>::value &&
+        !is_forward_iterator<_IteratorType>::value &&
+        !(std::is_lvalue_reference<_Reference>::value && !std::is_const<typename std::remove_reference<_Reference>::type>::value);
+    typedef std::integral_constant<bool, value> type;
+};
+
+//! How a pattern traverses its ranges; the patterns take it after their is_vector and is_parallel tags
+/** direct_traversal_tag: as they are;
+    checkpoint_traversal_tag: forward ranges, checkpointed to run in parallel (see parallel_forward_impl.h);
+    segment_traversal_tag: a segmented range, segment by segment (see segmented_impl.h), the others being random access;
+    pipeline_traversal_tag: an input range, read in batches that are processed in parallel (see parallel_input_impl.h),
+    vectorized if _IsVector. */
+struct direct_traversal_tag {};
+struct checkpoint_traversal_tag {};
+struct segment_traversal_tag {};
+
+template<bool _IsVector>
+struct pipeline_traversal_tag {
+    typedef std::integral_constant<bool, _IsVector> is_vector;
+};
+
+template<typename _ExecutionPolicy, typename _IteratorType, typename... _OtherIteratorTypes>
+struct traversal_preference {
+    typedef decltype(std::declval<_ExecutionPolicy&>().__allow_parallel()) _AllowParallel;
+    typedef decltype(std::declval<_ExecutionPolicy&>().__allow_vector()) _AllowVector;
+
+    typedef typename std::conditional<
+        is_segmented_iterator<_IteratorType>::value && is_random_access_iterator<_IteratorType, _OtherIteratorTypes...>::value,
+        segment_traversal_tag,
+    typename std::conditional<
+        _AllowParallel::value && is_forward_only_iterator<_IteratorType, _OtherIteratorTypes...>::value,
+        checkpoint_traversal_tag,
+    typename std::conditional<
+        _AllowParallel::value && is_read_only_input_iterator<_IteratorType>::value,
+        pipeline_traversal_tag<_AllowVector::value>,
+        direct_traversal_tag>::type>::type>::type type;
+};
+
+template<typename _ExecutionPolicy, typename... _IteratorTypes>
+auto preferred_traversal(_ExecutionPolicy&&) -> typename traversal_preference<_ExecutionPolicy, _IteratorTypes...>::type
+{
+    return {};
+}
+
 template<typename policy, typename... _IteratorTypes>
 struct prefer_unsequenced_tag {
     static constexpr bool value =
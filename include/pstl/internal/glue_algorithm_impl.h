@@ -38,7 +38,8 @@ any_of(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __l
     using namespace __pstl;
     return internal::pattern_any_of( __first, __last, __pred,
                                      internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
-                                     internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec));
+                                     internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
+                                     internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator>(__exec));
 }
 
 // [alg.all_of]
@@ -66,7 +67,8 @@ for_each(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator _
     internal::pattern_walk1(
         __first, __last, __f,
         internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
-        internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec));
+        internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
+        internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator, class _Size, class _Function>
@@ -86,7 +88,8 @@ find_if(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __
     using namespace __pstl;
     return internal::pattern_find_if( __first, __last, __pred,
                                       internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
-                                      internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec));
+                                      internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
+                                      internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator, class _Predicate>
@@ -165,11 +168,11 @@ adjacent_find(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardItera
 template<class _ExecutionPolicy, class _ForwardIterator, class _Tp>
 __pstl::internal::enable_if_execution_policy<_ExecutionPolicy,typename iterator_traits<_ForwardIterator>::difference_type>
 count(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator __last, const _Tp& __value) {
-    typedef typename iterator_traits<_ForwardIterator>::value_type _ValueType;
     using namespace __pstl;
-    return internal::pattern_count(__first, __last, [&__value](const _ValueType& __x) {return __value == __x;},
+    return internal::pattern_count(__first, __last, internal::equal_value<_Tp>(__value),
                                    internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
-                                   internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec));
+                                   internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
+                                   internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator, class _Predicate>
@@ -178,7 +181,8 @@ count_if(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator _
     using namespace __pstl;
     return internal::pattern_count(__first, __last, __pred,
                                    internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
-                                   internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec));
+                                   internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
+                                   internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator>(__exec));
 }
 
 // [alg.search]
@@ -246,7 +250,8 @@ copy_if(_ExecutionPolicy&& __exec,
     using namespace __pstl;
     return internal::pattern_copy_if(__first, __last, __result, __pred,
                                      internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec),
-                                     internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec));
+                                     internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator1,internal::output_target_iterator_t<_ForwardIterator2>>(__exec),
+                                     internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec));
 }
 
 // [alg.swap]
@@ -271,13 +276,11 @@ swap_ranges(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _ForwardItera
 template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _UnaryOperation>
 __pstl::internal::enable_if_execution_policy<_ExecutionPolicy,_ForwardIterator2>
 transform( _ExecutionPolicy&& __exec, _ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __result, _UnaryOperation __op ) {
-    typedef typename iterator_traits<_ForwardIterator1>::reference _InputType;
-    typedef typename iterator_traits<_ForwardIterator2>::reference _OutputType;
     using namespace __pstl;
-    return internal::pattern_walk2(__first, __last, __result,
-        [__op](_InputType __x, _OutputType __y ) mutable { __y = __op(__x);},
+    return internal::pattern_walk2(__first, __last, __result, internal::transform_functor<_UnaryOperation>(__op),
                                    internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec),
-                                   internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec));
+                                   internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec),
+                                   internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _ForwardIterator, class _BinaryOperation>
@@ -306,7 +309,8 @@ replace_if(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIterator
                   }
               },
           internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator>(__exec),
-          internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator>(__exec));
+          internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator>(__exec),
+          internal::preferred_traversal<_ExecutionPolicy, _ForwardIterator>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator, class _Tp>
@@ -432,7 +436,7 @@ unique_copy(_ExecutionPolicy&& __exec, _ForwardIterator1 __first, _ForwardIterat
     using namespace __pstl;
     return internal::pattern_unique_copy(__first, __last, __result, __pred,
                                          internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec),
-                                         internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator1,_ForwardIterator2>(__exec));
+                                         internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator1,internal::output_target_iterator_t<_ForwardIterator2>>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2>
@@ -716,7 +720,7 @@ merge(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _ForwardIterator1 _
     using namespace __pstl;
     return internal::pattern_merge(__first1, __last1, __first2, __last2, __d_first, __comp,
                                    internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec),
-                                   internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec));
+                                   internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, internal::output_target_iterator_t<_ForwardIterator>>(__exec));
 }
 
 template< class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _ForwardIterator>
@@ -768,7 +772,7 @@ set_union(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _ForwardIterato
     using namespace __pstl;
     return internal::pattern_set_union(__first1, __last1, __first2, __last2, __result, __comp,
                                        internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec),
-                                       internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec));
+                                       internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, internal::output_target_iterator_t<_ForwardIterator>>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _ForwardIterator>
@@ -788,7 +792,7 @@ set_intersection(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _Forward
     using namespace __pstl;
     return internal::pattern_set_intersection(__first1, __last1, __first2, __last2, __result, __comp,
                                               internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec),
-                                              internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec));
+                                              internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, internal::output_target_iterator_t<_ForwardIterator>>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _ForwardIterator>
@@ -808,7 +812,7 @@ set_difference(_ExecutionPolicy&& __exec, _ForwardIterator1 __first1, _ForwardIt
     using namespace __pstl;
     return internal::pattern_set_difference(__first1, __last1, __first2, __last2, __result, __comp,
                                             internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec),
-                                            internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec));
+                                            internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, internal::output_target_iterator_t<_ForwardIterator>>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _ForwardIterator>
@@ -829,7 +833,7 @@ set_symmetric_difference(_ExecutionPolicy&& __exec,
     using namespace __pstl;
     return internal::pattern_set_symmetric_difference(__first1, __last1, __first2, __last2, __result, __comp,
                                                       internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec),
-                                                      internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, _ForwardIterator>(__exec));
+                                                      internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator1, _ForwardIterator2, internal::output_target_iterator_t<_ForwardIterator>>(__exec));
 }
 
 template<class _ExecutionPolicy, class _ForwardIterator1, class _ForwardIterator2, class _ForwardIterator>
@@ -186,7 +186,7 @@ uninitialized_default_construct(_ExecutionPolicy&& __exec, _ForwardIterator __fi
     const auto __is_parallel = internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator>(__exec);
     const auto __is_vector = internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator>(__exec);
 
-    internal::invoke_if_not(std::is_trivial<_ValueType>(),
+    internal::invoke_if_not(internal::is_trivially_default_constructible<_ValueType>(),
                             [&]() { internal::pattern_it_walk1(__first, __last, [](_ForwardIterator __it) { ::new (internal::reduce_to_ptr(__it)) _ValueType; },
                                  __is_vector, __is_parallel); });
 }
@@ -200,7 +200,7 @@ uninitialized_default_construct_n(_ExecutionPolicy&& __exec, _ForwardIterator __
     const auto __is_parallel = internal::is_parallelization_preferred<_ExecutionPolicy, _ForwardIterator>(__exec);
     const auto __is_vector = internal::is_vectorization_preferred<_ExecutionPolicy, _ForwardIterator>(__exec);
 
-    return internal::invoke_if_else(std::is_trivial<_ValueType>(),
+    return internal::invoke_if_else(internal::is_trivially_default_constructible<_ValueType>(),
         [&]() { return std::next(__first, __n);},
                                     [&]() { return internal::pattern_it_walk1_n(__first, __n, [](_ForwardIterator __it)
                                                                                 { ::new (internal::reduce_to_ptr(__it)) _ValueType; }, __is_vector, __is_parallel); }
@@ -220,7 +220,7 @@ uninitialized_value_construct(_ExecutionPolicy&& __exec, _ForwardIterator __firs
 
     internal::invoke_if_else(std::is_trivial<_ValueType>(),
                              [&]() { internal::pattern_walk_brick(__first, __last, [__is_vector](_ForwardIterator __begin, _ForwardIterator __end)
-                                                                  { internal::brick_fill(__begin, __end, _ValueType(), __is_vector);}, __is_parallel); },
+                                                                  { internal::brick_value_construct(__begin, __end, __is_vector);}, __is_parallel); },
                              [&]() { internal::pattern_it_walk1(__first, __last, [](_ForwardIterator it)
                                                                 { ::new (internal::reduce_to_ptr(it)) _ValueType(); }, __is_vector, __is_parallel); }
         );
@@ -237,7 +237,7 @@ uninitialized_value_construct_n(_ExecutionPolicy&& __exec, _ForwardIterator __fi
 
     return internal::invoke_if_else(std::is_trivial<_ValueType>(),
                                     [&]() { return internal::pattern_walk_brick_n(__first, __n, [__is_vector](_ForwardIterator __begin, _Size __count)
-                                                                                  { return internal::brick_fill_n(__begin, __count, _ValueType(), __is_vector);}, __is_parallel); },
+                                                                                  { return internal::brick_value_construct_n(__begin, __count, __is_vector);}, __is_parallel); },
                                     [&]() { return internal::pattern_it_walk1_n(__first, __n, [](_ForwardIterator __it)
                                                                                 { ::new (internal::reduce_to_ptr(__it)) _ValueType(); }, __is_vector, __is_parallel); }
         );
@@ -77,7 +77,8 @@ transform_reduce(_ExecutionPolicy&& __exec, _ForwardIterator __first, _ForwardIt
     using namespace __pstl;
     return internal::pattern_transform_reduce(__first, __last, __init, __binary_op, __unary_op,
                                               internal::is_vectorization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
-                                              internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec));
+                                              internal::is_parallelization_preferred<_ExecutionPolicy,_ForwardIterator>(__exec),
+                                              internal::preferred_traversal<_ExecutionPolicy,_ForwardIterator>(__exec));
 }
 
 // [exclusive.scan]
@@ -21,8 +21,12 @@
 #ifndef __PSTL_memory_impl_H
 #define __PSTL_memory_impl_H
 
+#include <algorithm>
+#include <cstring>
 #include <iterator>
+#include <type_traits>
 
+#include "pstl_config.h"
 #include "unseq_backend_simd.h"
 
 namespace __pstl {
@@ -42,13 +46,104 @@ _OutputIterator brick_uninitialized_move(_ForwardIterator __first, _ForwardItera
 }
 
 template<class _ForwardIterator, class _OutputIterator>
-_OutputIterator brick_uninitialized_move(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, /*vector=*/std::true_type) noexcept {
+_OutputIterator brick_uninitialized_move(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, /*vector=*/std::true_type,
+                                         /*bytewise=*/std::false_type) noexcept {
     typedef typename std::iterator_traits<_OutputIterator>::value_type __ValueType2;
     return unseq_backend::simd_it_walk_2(__first, __last - __first, __result,
         [](_ForwardIterator __first1, _OutputIterator first2) {::new (reduce_to_ptr(first2)) __ValueType2(std::move(*__first1));
     });
 }
 
+template<class _ForwardIterator, class _OutputIterator>
+_OutputIterator brick_uninitialized_move(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, /*vector=*/std::true_type,
+                                         /*bytewise=*/std::true_type) noexcept {
+    return unseq_backend::simd_copy_bytes(__first, __last - __first, __result);
+}
+
+template<class _ForwardIterator, class _OutputIterator>
+_OutputIterator brick_uninitialized_move(_ForwardIterator __first, _ForwardIterator __last, _OutputIterator __result, /*vector=*/std::true_type) noexcept {
+    return internal::brick_uninitialized_move(__first, __last, __result, std::true_type(),
+                                              unseq_backend::is_bytewise_copy<_ForwardIterator, _OutputIterator>());
+}
+
+//------------------------------------------------------------------------
+// uninitialized_default_construct, uninitialized_value_construct
+//------------------------------------------------------------------------
+
+//! std::is_trivially_default_constructible, or std::is_trivial where the library lacks it
+template<typename _Tp>
+struct is_trivially_default_constructible : std::integral_constant<bool,
+#if __PSTL_CPP11_IS_TRIVIALLY_COPYABLE_BROKEN
+    std::is_trivial<_Tp>::value
+#else
+    std::is_trivially_default_constructible<_Tp>::value
+#endif
+    > {};
+
+//! Whether the value-initialized object at __p is represented by zero bytes, as for most trivial types but not e.g. pointers to data members
+template<typename _Tp>
+bool is_zero_bytes(const _Tp* __p) noexcept {
+    const unsigned char* __bytes = reinterpret_cast<const unsigned char*>(__p);
+    return std::find_if(__bytes, __bytes + sizeof(_Tp), [](unsigned char __b) { return __b != 0; }) == __bytes + sizeof(_Tp);
+}
+
+// The bricks below value-initialize trivial objects. On contiguous storage the first object is value-initialized
+// in place and, if that gave zero bytes, the others are zero-filled by one memset.
+template<class _ForwardIterator>
+void brick_value_construct(_ForwardIterator __first, _ForwardIterator __last, /*vector=*/std::false_type, /*bytewise=*/std::false_type) noexcept {
+    typedef typename std::iterator_traits<_ForwardIterator>::value_type _ValueType;
+    std::fill(__first, __last, _ValueType());
+}
+
+template<class _ForwardIterator>
+void brick_value_construct(_ForwardIterator __first, _ForwardIterator __last, /*vector=*/std::true_type, /*bytewise=*/std::false_type) noexcept {
+    typedef typename std::iterator_traits<_ForwardIterator>::value_type _ValueType;
+    unseq_backend::simd_fill_n(__first, __last - __first, _ValueType());
+}
+
+template<class _ForwardIterator, class _IsVector>
+void brick_value_construct(_ForwardIterator __first, _ForwardIterator __last, _IsVector __is_vector, /*bytewise=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_ForwardIterator>::value_type _ValueType;
+    if (__first == __last)
+        return;
+    _ValueType* __p = std::addressof(*__first);
+    ::new (static_cast<void*>(__p)) _ValueType();
+    if (internal::is_zero_bytes(__p))
+        std::memset(static_cast<void*>(__p + 1), 0, std::size_t(__last - __first - 1) * sizeof(_ValueType));
+    else
+        internal::brick_value_construct(__first + 1, __last, __is_vector, std::false_type());
+}
+
+template<class _ForwardIterator, class _IsVector>
+void brick_value_construct(_ForwardIterator __first, _ForwardIterator __last, _IsVector __is_vector) noexcept {
+    internal::brick_value_construct(__first, __last, __is_vector, unseq_backend::is_bytewise_iterator<_ForwardIterator>());
+}
+
+template<class _ForwardIterator, class _Size>
+_ForwardIterator brick_value_construct_n(_ForwardIterator __first, _Size __n, /*vector=*/std::false_type, /*bytewise=*/std::false_type) noexcept {
+    typedef typename std::iterator_traits<_ForwardIterator>::value_type _ValueType;
+    return std::fill_n(__first, __n, _ValueType());
+}
+
+template<class _ForwardIterator, class _Size>
+_ForwardIterator brick_value_construct_n(_ForwardIterator __first, _Size __n, /*vector=*/std::true_type, /*bytewise=*/std::false_type) noexcept {
+    typedef typename std::iterator_traits<_ForwardIterator>::value_type _ValueType;
+    return unseq_backend::simd_fill_n(__first, __n, _ValueType());
+}
+
+template<class _ForwardIterator, class _Size, class _IsVector>
+_ForwardIterator brick_value_construct_n(_ForwardIterator __first, _Size __n, _IsVector __is_vector, /*bytewise=*/std::true_type) noexcept {
+    if (__n <= 0)
+        return __first;
+    internal::brick_value_construct(__first, __first + __n, __is_vector, std::true_type());
+    return __first + __n;
+}
+
+template<class _ForwardIterator, class _Size, class _IsVector>
+_ForwardIterator brick_value_construct_n(_ForwardIterator __first, _Size __n, _IsVector __is_vector) noexcept {
+    return internal::brick_value_construct_n(__first, __n, __is_vector, unseq_backend::is_bytewise_iterator<_ForwardIterator>());
+}
+
 } // namespace internal
 } // namespace __pstl
 
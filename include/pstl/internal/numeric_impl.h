@@ -33,6 +33,8 @@
 #if __PSTL_USE_PAR_POLICIES
     #include "parallel_backend.h"
 #endif
+#include "parallel_forward_impl.h"
+#include "parallel_input_impl.h"
 
 namespace __pstl {
 namespace internal {
@@ -110,6 +112,69 @@ _Tp pattern_transform_reduce(_ForwardIterator __first, _ForwardIterator __last,
     });
 }
 
+template<class _ForwardIterator, class _Tp, class _BinaryOperation, class _UnaryOperation, class _IsVector, class _IsParallel>
+_Tp pattern_transform_reduce(_ForwardIterator __first, _ForwardIterator __last, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op, _IsVector __is_vector, _IsParallel __is_parallel,
+                             /*traversal=*/direct_traversal_tag) {
+    return internal::pattern_transform_reduce(__first, __last, __init, __binary_op, __unary_op, __is_vector, __is_parallel);
+}
+
+template<class _ForwardIterator, class _Tp, class _BinaryOperation, class _UnaryOperation, class _IsVector>
+_Tp pattern_transform_reduce(_ForwardIterator __first, _ForwardIterator __last, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op, _IsVector, /*is_parallel=*/std::false_type,
+                             /*traversal=*/checkpoint_traversal_tag) {
+    const checkpoint_table<_ForwardIterator> __table(__first, __last);
+    return internal::pattern_transform_reduce(internal::checkpoint_begin(__table), internal::checkpoint_end(__table), __init, __binary_op, __unary_op,
+                                              /*is_vector=*/std::false_type(), /*is_parallel=*/std::true_type());
+}
+
+template<class _SegmentedIterator, class _Tp, class _BinaryOperation, class _UnaryOperation, class _IsVector>
+_Tp pattern_transform_reduce(_SegmentedIterator __first, _SegmentedIterator __last, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op, _IsVector __is_vector, /*is_parallel=*/std::false_type,
+                             /*traversal=*/segment_traversal_tag) noexcept {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    for (_SegmentIterator __s = __r.segments_begin(); __s != __r.segments_end(); ++__s)
+        __init = brick_transform_reduce(__r.begin(__s), __r.end(__s), __init, __binary_op, __unary_op, __is_vector);
+    return __init;
+}
+
+template<class _SegmentedIterator, class _Tp, class _BinaryOperation, class _UnaryOperation, class _IsVector>
+_Tp pattern_transform_reduce(_SegmentedIterator __first, _SegmentedIterator __last, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op, _IsVector __is_vector, /*is_parallel=*/std::true_type,
+                             /*traversal=*/segment_traversal_tag) {
+    typedef typename segmented_range<_SegmentedIterator>::segment_iterator _SegmentIterator;
+    const segmented_range<_SegmentedIterator> __r(__first, __last);
+    return except_handler([&]() {
+        return par_backend::parallel_transform_reduce(__r.segments_begin(), __r.segments_end(),
+            // A segment of the range is not empty, and its first element starts its reduction
+            [&__r, __unary_op, __binary_op, __is_vector](_SegmentIterator __s) mutable {
+                return brick_transform_reduce(__r.begin(__s) + 1, __r.end(__s), _Tp(__unary_op(*__r.begin(__s))), __binary_op, __unary_op, __is_vector);
+            },
+            __init,
+            __binary_op,
+            [&__r, __unary_op, __binary_op, __is_vector](_SegmentIterator __i, _SegmentIterator __j, _Tp __init) {
+                for (; __i != __j; ++__i)
+                    __init = brick_transform_reduce(__r.begin(__i), __r.end(__i), __init, __binary_op, __unary_op, __is_vector);
+                return __init;
+        });
+    });
+}
+
+template<class _InputIterator, class _Tp, class _BinaryOperation, class _UnaryOperation, class _IsVector, bool _IsBatchVector>
+_Tp pattern_transform_reduce(_InputIterator __first, _InputIterator __last, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op, _IsVector, /*is_parallel=*/std::false_type,
+                             /*traversal=*/pipeline_traversal_tag<_IsBatchVector>) {
+    typedef typename pipeline_traversal_tag<_IsBatchVector>::is_vector _IsVectorBatch;
+    except_handler([&]() {
+        internal::pipeline_batches(__first, __last,
+            // A batch is not empty, and its first value starts its reduction
+            [__unary_op, __binary_op](pipeline_batch<_InputIterator>& __batch) mutable -> _Tp {
+                return brick_transform_reduce(__batch.begin() + 1, __batch.end(), _Tp(__unary_op(__batch.front())), __binary_op, __unary_op, _IsVectorBatch());
+            },
+            // The reductions of the batches are combined in the order of the batches
+            [&__init, __binary_op](pipeline_batch<_InputIterator>&, const _Tp& __value) mutable {
+                __init = __binary_op(__init, __value);
+            });
+    });
+    return __init;
+}
+
 
 //------------------------------------------------------------------------
 // transform_exclusive_scan
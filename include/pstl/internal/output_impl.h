@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_output_impl_H
+#define __PSTL_output_impl_H
+
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "pstl_config.h"
+
+// The parallel patterns whose result size is only known once it is computed, like copy_if, write their output at
+// offsets from its beginning, so it must be random access and have room for the result. A growable output, which
+// is a std::back_insert_iterator of a container with random access iterators and resize, gets that room instead:
+// the pattern grows the container once by the size of the result, and writes to the new elements in parallel.
+
+namespace __pstl {
+namespace internal {
+
+template<typename _Container, typename = void>
+struct is_growable_container : std::false_type {};
+
+template<typename _Container>
+struct is_growable_container<_Container, typename std::enable_if<
+    std::is_same<decltype(std::declval<_Container&>().resize(std::declval<typename _Container::size_type>())), void>::value>::type>
+    : std::integral_constant<bool, std::is_default_constructible<typename _Container::value_type>::value &&
+        std::is_same<typename std::iterator_traits<typename _Container::iterator>::iterator_category,
+                     std::random_access_iterator_tag>::value> {};
+
+//! Whether the output is grown to the size of the result of a parallel pattern
+template<typename _OutputIterator>
+struct is_growable_output : std::false_type {};
+
+template<typename _Container>
+struct is_growable_output<std::back_insert_iterator<_Container>> : is_growable_container<_Container> {};
+
+//! The iterator that a parallel pattern writes an output through: the one of the container for a growable output
+template<typename _OutputIterator, bool = is_growable_output<_OutputIterator>::value>
+struct output_target_iterator {
+    typedef _OutputIterator type;
+};
+
+template<typename _Container>
+struct output_target_iterator<std::back_insert_iterator<_Container>, true> {
+    typedef typename _Container::iterator type;
+};
+
+template<typename _OutputIterator>
+using output_target_iterator_t = typename output_target_iterator<_OutputIterator>::type;
+
+//! The room for the result of a parallel pattern in an output.
+/** grow(__n) makes room for __n values, to be written from begin(); result(__n) is the output past them.
+    It is not copyable, as the patterns that grow it share it with the tasks that write to it. */
+template<typename _OutputIterator, bool = is_growable_output<_OutputIterator>::value>
+class output_target {
+public:
+    typedef typename std::iterator_traits<_OutputIterator>::difference_type difference_type;
+
+    explicit output_target(_OutputIterator __result) : _M_first(__result) {}
+    output_target(const output_target&) = delete;
+    void operator=(const output_target&) = delete;
+
+    void grow(difference_type) {}
+    _OutputIterator begin() const { return _M_first; }
+    _OutputIterator result(difference_type __n) const { return _M_first + __n; }
+
+private:
+    _OutputIterator _M_first;
+};
+
+template<typename _Container>
+class output_target<std::back_insert_iterator<_Container>, true> {
+    // The container of a back_insert_iterator is a protected member
+    struct access : std::back_insert_iterator<_Container> {
+        static _Container& get(std::back_insert_iterator<_Container>& __it) {
+            return *(__it.*&access::container);
+        }
+    };
+public:
+    typedef typename _Container::difference_type difference_type;
+
+    explicit output_target(std::back_insert_iterator<_Container> __result) :
+        _M_result(__result), _M_container(access::get(_M_result)), _M_first(_M_container.end()) {}
+    output_target(const output_target&) = delete;
+    void operator=(const output_target&) = delete;
+
+    void grow(difference_type __n) {
+        const typename _Container::size_type __size = _M_container.size();
+        _M_container.resize(__size + __n);
+        _M_first = _M_container.begin() + __size;
+    }
+    typename _Container::iterator begin() const { return _M_first; }
+    std::back_insert_iterator<_Container> result(difference_type) const { return _M_result; }
+
+private:
+    std::back_insert_iterator<_Container> _M_result;
+    _Container& _M_container;
+    typename _Container::iterator _M_first;
+};
+
+//! Output iterator that only counts the values written through it
+template<typename _DifferenceType>
+class counting_output_iterator {
+public:
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef void difference_type;
+    typedef void pointer;
+    typedef void reference;
+
+    explicit counting_output_iterator(_DifferenceType __count = 0) : _M_count(__count) {}
+
+    template<typename _Tp>
+    counting_output_iterator& operator=(const _Tp&) { return *this; }
+    counting_output_iterator& operator*() { return *this; }
+    counting_output_iterator& operator++() { ++_M_count; return *this; }
+    counting_output_iterator operator++(int) { counting_output_iterator __tmp(*this); ++_M_count; return __tmp; }
+
+    _DifferenceType count() const { return _M_count; }
+
+private:
+    _DifferenceType _M_count;
+};
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_output_impl_H */
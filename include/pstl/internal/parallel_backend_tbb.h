@@ -22,15 +22,22 @@
 #define __PSTL_parallel_backend_tbb_H
 
 #include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
 
 #include "parallel_backend_utils.h"
 
 // Bring in minimal required subset of Intel TBB
 #include <tbb/blocked_range.h>
+#include <tbb/flow_graph.h>
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_reduce.h>
 #include <tbb/parallel_scan.h>
 #include <tbb/parallel_invoke.h>
+#include <tbb/task_group.h>
 #include <tbb/task_arena.h>
 #include <tbb/tbb_allocator.h>
 
@@ -38,6 +45,13 @@
 #error Intel(R) Threading Building Blocks 2018 is required; older versions are not supported.
 #endif
 
+// oneTBB moved parallel_pipeline to its own header and the filter modes to tbb::filter_mode
+#if TBB_INTERFACE_VERSION >= 12000
+#include <tbb/parallel_pipeline.h>
+#else
+#include <tbb/pipeline.h>
+#endif
+
 namespace __pstl {
 namespace par_backend {
 
@@ -56,12 +70,19 @@ class buffer {
 public:
     //! Try to obtain buffer of given size to store objects of _Tp type
     buffer(std::size_t n) : _M_allocator(), _M_ptr(_M_allocator.allocate(n)), _M_buf_size(n) {}
+    //! Try to obtain buffer of given size; on allocation failure the buffer is left empty instead of throwing
+    buffer(std::size_t n, const std::nothrow_t&) : _M_allocator(), _M_ptr(NULL), _M_buf_size(n) {
+        try {
+            _M_ptr = _M_allocator.allocate(n);
+        }
+        catch(const std::bad_alloc&) {}
+    }
     //! True if buffer was successfully obtained, zero otherwise.
     operator bool() const { return _M_ptr != NULL; }
     //! Return pointer to buffer, or  NULL if buffer could not be obtained.
     _Tp* get() const { return _M_ptr; }
     //! Destroy buffer
-    ~buffer() { _M_allocator.deallocate(_M_ptr, _M_buf_size); }
+    ~buffer() { if (_M_ptr) _M_allocator.deallocate(_M_ptr, _M_buf_size); }
 };
 
 // Wrapper for tbb::task
@@ -349,6 +370,116 @@ _Tp parallel_transform_scan(_Index __n, _Up __u, _Tp __init, _Cp __combine, _Rp
     return __body.sum();
 }
 
+//------------------------------------------------------------------------
+// parallel_pipeline
+//
+// Notation:
+//      s() returns the next token, or a null one at the end; it is called serially
+//      f(t) processes token t; it is called in parallel
+//      c(x) consumes the result x of f; it is called serially, in the order of the tokens
+//------------------------------------------------------------------------
+
+#if TBB_INTERFACE_VERSION >= 12000
+typedef tbb::filter_mode pipeline_filter_mode;
+#else
+typedef tbb::filter::mode pipeline_filter_mode;
+#endif
+
+//! Evaluation of c(f(t)) for the tokens t of s(), with at most __max_tokens of them in flight
+// wrapper over tbb::parallel_pipeline
+template<class _Sp, class _Fp, class _Cp>
+void parallel_pipeline(std::size_t __max_tokens, _Sp __source, _Fp __f, _Cp __consume) {
+    typedef decltype(__source()) _Token;
+    typedef decltype(__f(std::declval<_Token>())) _Result;
+    tbb::this_task_arena::isolate([&]() {
+        tbb::parallel_pipeline(__max_tokens,
+            tbb::make_filter<void, _Token>(pipeline_filter_mode::serial_in_order, [&__source](tbb::flow_control& __control) -> _Token {
+                _Token __token = __source();
+                if (!__token)
+                    __control.stop();
+                return __token;
+            }) &
+            tbb::make_filter<_Token, _Result>(pipeline_filter_mode::parallel, [&__f](_Token __token) -> _Result {
+                return __f(__token);
+            }) &
+            tbb::make_filter<_Result, void>(pipeline_filter_mode::serial_in_order, [&__consume](_Result __result) {
+                __consume(__result);
+            }));
+    });
+}
+
+//------------------------------------------------------------------------
+// parallel_graph
+//
+// Notation:
+//      f(i) evaluates node i of [0, n)
+//      an edge (i, j) makes f(j) wait for f(i) to return
+//------------------------------------------------------------------------
+
+//! Evaluation of f(i) for every node i of [0, __n), each once the nodes of the edges to it have been evaluated
+/** Nodes without edges to them start at once; independent nodes run concurrently. */
+// wrapper over tbb::flow::graph
+template<class _Fp>
+void parallel_graph(std::size_t __n, const std::vector<std::pair<std::size_t, std::size_t>>& __edges, _Fp __f) {
+    typedef tbb::flow::continue_node<tbb::flow::continue_msg> _Node;
+    tbb::this_task_arena::isolate([&]() {
+        tbb::flow::graph __graph;
+        std::vector<std::unique_ptr<_Node>> __nodes;
+        std::vector<bool> __is_root(__n, true);
+        __nodes.reserve(__n);
+        for (std::size_t __i = 0; __i < __n; ++__i)
+            __nodes.emplace_back(new _Node(__graph, [&__f, __i](const tbb::flow::continue_msg&) {
+                __f(__i);
+                return tbb::flow::continue_msg();
+            }));
+        for (const std::pair<std::size_t, std::size_t>& __edge: __edges) {
+            tbb::flow::make_edge(*__nodes[__edge.first], *__nodes[__edge.second]);
+            __is_root[__edge.second] = false;
+        }
+        for (std::size_t __i = 0; __i < __n; ++__i)
+            if (__is_root[__i])
+                __nodes[__i]->try_put(tbb::flow::continue_msg());
+        __graph.wait_for_all();
+    });
+}
+
+//------------------------------------------------------------------------
+// async_task, async_enqueue
+//------------------------------------------------------------------------
+
+//! The arena of the work started in the background
+/** Threads enter it only to start or wait for work, so that any thread may wait for the work, not only the one
+that started it. */
+inline tbb::task_arena& async_arena() {
+    static tbb::task_arena __arena;
+    return __arena;
+}
+
+//! Work started with run() that proceeds while the caller does something else
+/** wait() returns when the work is done; until then the waiting thread takes part in it, and in any other work
+of the arena, instead of blocking. */
+// wrapper over tbb::task_group
+class async_task {
+    tbb::task_group _M_group;
+    async_task(const async_task&) = delete;
+    void operator=(const async_task&) = delete;
+public:
+    async_task() {}
+    template<class _Fp>
+    void run(_Fp __f) { async_arena().execute([this, &__f]() { _M_group.run(__f); }); }
+    void wait() { async_arena().execute([this]() { _M_group.wait(); }); }
+    ~async_task() { wait(); }
+};
+
+//! Evaluation of __f() by a worker thread, with nobody waiting for it
+/** Unlike async_task, the work makes progress even if no thread ever waits, so that __f itself must report
+its completion. */
+// wrapper over tbb::task_arena::enqueue
+template<class _Fp>
+void async_enqueue(_Fp __f) {
+    async_arena().enqueue(__f);
+}
+
 //------------------------------------------------------------------------
 // parallel_stable_sort
 //------------------------------------------------------------------------
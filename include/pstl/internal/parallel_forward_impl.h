@@ -0,0 +1,193 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_parallel_forward_impl_H
+#define __PSTL_parallel_forward_impl_H
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <vector>
+
+#include "pstl_config.h"
+
+// The parallel patterns split their ranges at arbitrary positions, so they need random access iterators.
+// A forward range gets random access after a serial pass that records its iterators at regular positions,
+// the checkpoints: an iterator at position k then starts at the checkpoint before k and walks the rest
+// of the way. The parallel patterns run as they are over checkpointed iterators; each split costs a
+// walk between two checkpoints, and the traversal of the elements themselves is divided among the threads.
+
+#ifndef __PSTL_FORWARD_CHECKPOINTS
+//! Least number of checkpoints of a forward range that is at least as long; there are at most twice as many
+#define __PSTL_FORWARD_CHECKPOINTS 1024
+#endif
+
+namespace __pstl {
+namespace internal {
+
+//! Iterators at the positions of a forward range that are multiples of a stride, the stride being doubled
+//! as they are recorded so that they stay between __PSTL_FORWARD_CHECKPOINTS and twice as many.
+/** Tables filled with ranges of the same length in lockstep have the same stride. */
+template<typename _ForwardIterator>
+class checkpoint_table {
+public:
+    typedef typename std::iterator_traits<_ForwardIterator>::difference_type difference_type;
+
+    checkpoint_table() : _M_stride(1), _M_size(0) { _M_cuts.reserve(2 * __PSTL_FORWARD_CHECKPOINTS); }
+
+    checkpoint_table(_ForwardIterator __first, _ForwardIterator __last) : checkpoint_table() {
+        for (; __first != __last; ++__first)
+            push(__first);
+        close(__last);
+    }
+
+    //! Records the iterator at the next position of the range
+    void push(_ForwardIterator __it) {
+        if ((_M_size & (_M_stride - 1)) == 0) {
+            if (_M_cuts.size() == 2 * __PSTL_FORWARD_CHECKPOINTS) {
+                // Keep the even checkpoints: _M_size is a multiple of the doubled stride as well
+                for (std::size_t __k = 1; __k < __PSTL_FORWARD_CHECKPOINTS; ++__k)
+                    _M_cuts[__k] = _M_cuts[2 * __k];
+                _M_cuts.resize(__PSTL_FORWARD_CHECKPOINTS);
+                _M_stride *= 2;
+            }
+            _M_cuts.push_back(__it);
+        }
+        ++_M_size;
+    }
+
+    //! Records the end of the range
+    void close(_ForwardIterator __last) { _M_last = __last; }
+
+    difference_type size() const { return _M_size; }
+
+    //! Iterator at position __pos, reached from the checkpoint before it
+    _ForwardIterator at(difference_type __pos) const {
+        if (__pos == _M_size)
+            return _M_last;
+        _ForwardIterator __it = _M_cuts[__pos / _M_stride];
+        std::advance(__it, __pos % _M_stride);
+        return __it;
+    }
+
+    //! Iterator __n positions after __it at __pos; a short forward step walks from __it itself
+    _ForwardIterator advance(_ForwardIterator __it, difference_type __pos, difference_type __n) const {
+        if (__n >= 0 && __n <= _M_stride) {
+            std::advance(__it, __n);
+            return __it;
+        }
+        return at(__pos + __n);
+    }
+
+private:
+    std::vector<_ForwardIterator> _M_cuts;
+    _ForwardIterator _M_last;
+    difference_type _M_stride;
+    difference_type _M_size;
+};
+
+//! Random access iterator over a forward range recorded in a checkpoint_table
+/** Positions order and measure the iterators; base() is the iterator of the range. */
+template<typename _ForwardIterator>
+class checkpointed_iterator {
+public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef typename std::iterator_traits<_ForwardIterator>::value_type value_type;
+    typedef typename std::iterator_traits<_ForwardIterator>::difference_type difference_type;
+    typedef typename std::iterator_traits<_ForwardIterator>::pointer pointer;
+    typedef typename std::iterator_traits<_ForwardIterator>::reference reference;
+
+    checkpointed_iterator() : _M_table(nullptr), _M_pos(0) {}
+    checkpointed_iterator(const checkpoint_table<_ForwardIterator>* __table, difference_type __pos)
+        : _M_table(__table), _M_pos(__pos), _M_it(__table->at(__pos)) {}
+
+    _ForwardIterator base() const { return _M_it; }
+
+    reference operator*() const { return *_M_it; }
+    pointer operator->() const { return std::addressof(*_M_it); }
+    reference operator[](difference_type __n) const { return *(*this + __n); }
+
+    checkpointed_iterator& operator++() {
+        ++_M_it;
+        ++_M_pos;
+        return *this;
+    }
+    checkpointed_iterator operator++(int) {
+        checkpointed_iterator __tmp(*this);
+        ++*this;
+        return __tmp;
+    }
+    checkpointed_iterator& operator--() { return *this -= 1; }
+    checkpointed_iterator operator--(int) {
+        checkpointed_iterator __tmp(*this);
+        --*this;
+        return __tmp;
+    }
+
+    checkpointed_iterator& operator+=(difference_type __n) {
+        _M_it = _M_table->advance(_M_it, _M_pos, __n);
+        _M_pos += __n;
+        return *this;
+    }
+    checkpointed_iterator& operator-=(difference_type __n) { return *this += -__n; }
+
+    checkpointed_iterator operator+(difference_type __n) const { return checkpointed_iterator(*this) += __n; }
+    checkpointed_iterator operator-(difference_type __n) const { return checkpointed_iterator(*this) -= __n; }
+    friend checkpointed_iterator operator+(difference_type __n, const checkpointed_iterator& __it) { return __it + __n; }
+    difference_type operator-(const checkpointed_iterator& __it) const { return _M_pos - __it._M_pos; }
+
+    bool operator==(const checkpointed_iterator& __it) const { return _M_pos == __it._M_pos; }
+    bool operator!=(const checkpointed_iterator& __it) const { return _M_pos != __it._M_pos; }
+    bool operator<(const checkpointed_iterator& __it) const { return _M_pos < __it._M_pos; }
+    bool operator>(const checkpointed_iterator& __it) const { return _M_pos > __it._M_pos; }
+    bool operator<=(const checkpointed_iterator& __it) const { return _M_pos <= __it._M_pos; }
+    bool operator>=(const checkpointed_iterator& __it) const { return _M_pos >= __it._M_pos; }
+
+private:
+    const checkpoint_table<_ForwardIterator>* _M_table;
+    difference_type _M_pos;
+    _ForwardIterator _M_it;
+};
+
+template<typename _ForwardIterator>
+checkpointed_iterator<_ForwardIterator> checkpoint_begin(const checkpoint_table<_ForwardIterator>& __table) {
+    return checkpointed_iterator<_ForwardIterator>(&__table, 0);
+}
+
+template<typename _ForwardIterator>
+checkpointed_iterator<_ForwardIterator> checkpoint_end(const checkpoint_table<_ForwardIterator>& __table) {
+    return checkpointed_iterator<_ForwardIterator>(&__table, __table.size());
+}
+
+//! Fills the tables of [__first1, __last1) and of the range of the same length from __first2, in a single pass
+template<typename _ForwardIterator1, typename _ForwardIterator2>
+void checkpoint_ranges(_ForwardIterator1 __first1, _ForwardIterator1 __last1, _ForwardIterator2 __first2,
+                       checkpoint_table<_ForwardIterator1>& __table1, checkpoint_table<_ForwardIterator2>& __table2) {
+    for (; __first1 != __last1; ++__first1, ++__first2) {
+        __table1.push(__first1);
+        __table2.push(__first2);
+    }
+    __table1.close(__last1);
+    __table2.close(__first2);
+}
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_parallel_forward_impl_H */
@@ -0,0 +1,85 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_parallel_input_impl_H
+#define __PSTL_parallel_input_impl_H
+
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include "pstl_config.h"
+
+// A single-pass input range, like one of std::istream_iterator, cannot be split among threads, but it can be read
+// ahead. The patterns over such a range run a pipeline: a serial stage reads the range in batches of values,
+// a parallel stage runs the brick on each batch, and a serial stage consumes the results in the order of the
+// batches. Reading and computing overlap, and at most __PSTL_PIPELINE_TOKENS batches are in memory at a time.
+
+#ifndef __PSTL_PIPELINE_BATCH
+//! Number of values of an input range in a batch of the pipeline
+#define __PSTL_PIPELINE_BATCH 4096
+#endif
+
+#ifndef __PSTL_PIPELINE_TOKENS
+//! Most batches of an input range in flight in the pipeline
+#define __PSTL_PIPELINE_TOKENS 16
+#endif
+
+namespace __pstl {
+namespace internal {
+
+//! A batch of the values of an input range
+template<typename _InputIterator>
+using pipeline_batch = std::vector<typename std::iterator_traits<_InputIterator>::value_type>;
+
+//! Evaluation of __consume(__batch, __process(__batch)) for the batches of values read from [__first, __last).
+/** __process runs on the batches in parallel, __consume serially in the order of the batches; a batch is a
+    std::vector of the values, and it is not empty. The batches are reused once consumed. */
+template<typename _InputIterator, typename _Process, typename _Consume>
+void pipeline_batches(_InputIterator __first, _InputIterator __last, _Process __process, _Consume __consume) {
+    typedef pipeline_batch<_InputIterator> _Batch;
+    typedef decltype(__process(std::declval<_Batch&>())) _Result;
+
+    // Batches are consumed in order, so the one read __PSTL_PIPELINE_TOKENS batches before is free again
+    std::vector<_Batch> __batches(__PSTL_PIPELINE_TOKENS);
+    std::size_t __read = 0;
+    par_backend::parallel_pipeline(__PSTL_PIPELINE_TOKENS,
+        [&]() -> _Batch* {
+            if (__first == __last)
+                return nullptr;
+            _Batch& __batch = __batches[__read++ % __PSTL_PIPELINE_TOKENS];
+            __batch.clear();
+            __batch.reserve(__PSTL_PIPELINE_BATCH);
+            for (; __first != __last && __batch.size() < __PSTL_PIPELINE_BATCH; ++__first)
+                __batch.push_back(*__first);
+            return &__batch;
+        },
+        [&__process](_Batch* __batch) {
+            return std::pair<_Batch*, _Result>(__batch, __process(*__batch));
+        },
+        [&__consume](const std::pair<_Batch*, _Result>& __result) {
+            __consume(*__result.first, __result.second);
+        });
+}
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_parallel_input_impl_H */
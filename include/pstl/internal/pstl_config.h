@@ -110,6 +110,7 @@
 #define __PSTL_CPP14_INTEGER_SEQUENCE_PRESENT (_MSC_VER >= 1900 || __cplusplus >= 201402L)
 #define __PSTL_CPP14_VARIABLE_TEMPLATES_PRESENT \
     (!__INTEL_COMPILER || __INTEL_COMPILER >= 1700) && (_MSC_FULL_VER >= 190023918 || __cplusplus >= 201402L)
+#define __PSTL_CPP20_COROUTINES_PRESENT (__cpp_impl_coroutine >= 201902L)
 
 #define __PSTL_EARLYEXIT_PRESENT  (__INTEL_COMPILER >= 1800)
 #define __PSTL_MONOTONIC_PRESENT  (__INTEL_COMPILER >= 1800)
@@ -130,6 +131,61 @@
 #define __PSTL_PRAGMA_SIMD_ORDERED_MONOTONIC_2ARGS(PRM1, PRM2)
 #endif
 
+// Instruction set of the compress-store engine of the vectorized stream compaction, when it cannot be chosen
+// at run time (__PSTL_SIMD_DISPATCH_PRESENT below)
+#if defined(__AVX512F__)
+#define __PSTL_SIMD_COMPRESS_AVX512 1
+#elif defined(__AVX2__)
+#define __PSTL_SIMD_COMPRESS_AVX2 1
+#elif defined(__SSSE3__)
+#define __PSTL_SIMD_COMPRESS_SSSE3 1
+#endif
+
+// Runtime-dispatched vector kernels of the unseq backend (GCC and Clang on x86).
+// They can be disabled by defining PSTL_USE_SIMD_DISPATCH to 0.
+#if defined(PSTL_USE_SIMD_DISPATCH) && !PSTL_USE_SIMD_DISPATCH
+#undef __PSTL_SIMD_DISPATCH_PRESENT
+#define __PSTL_SIMD_DISPATCH_PRESENT 0
+#elif !defined(__PSTL_SIMD_DISPATCH_PRESENT)
+#if (__x86_64__ || __i386__) && !__INTEL_COMPILER && (__clang__ ? __PSTL_CLANG_VERSION >= 70000 : __PSTL_GCC_VERSION >= 60000)
+#define __PSTL_SIMD_DISPATCH_PRESENT 1
+#else
+#define __PSTL_SIMD_DISPATCH_PRESENT 0
+#endif
+#endif
+
+// Regions of code compiled for an instruction set beyond the one of the translation unit.
+// The code of a region is put into an inline namespace named after both instruction sets, __PSTL_TARGET_NAMESPACE(ISA),
+// so that the linker does not merge the copies of translation units compiled with different -m flags, and its
+// entry points are __PSTL_TARGET_KERNEL functions, which are never inlined into code that runs before the
+// processor has been checked.
+#if __PSTL_SIMD_DISPATCH_PRESENT && __clang__
+#define __PSTL_TARGET_REGION_BEGIN(ISA) __PSTL_PRAGMA(clang attribute push(__attribute__((target(ISA))), apply_to = function))
+#define __PSTL_TARGET_REGION_END __PSTL_PRAGMA(clang attribute pop)
+#define __PSTL_TARGET_KERNEL __attribute__((noinline))
+#elif __PSTL_SIMD_DISPATCH_PRESENT
+#define __PSTL_TARGET_REGION_BEGIN(ISA) __PSTL_PRAGMA(GCC push_options) __PSTL_PRAGMA(GCC target(ISA))
+#define __PSTL_TARGET_REGION_END __PSTL_PRAGMA(GCC pop_options)
+#define __PSTL_TARGET_KERNEL __attribute__((noinline))
+#else
+#define __PSTL_TARGET_REGION_BEGIN(ISA)
+#define __PSTL_TARGET_REGION_END
+#define __PSTL_TARGET_KERNEL
+#endif
+
+#if __AVX512F__
+#define __PSTL_TARGET_BASE _on_avx512
+#elif __AVX2__
+#define __PSTL_TARGET_BASE _on_avx2
+#elif __SSE4_2__
+#define __PSTL_TARGET_BASE _on_sse42
+#else
+#define __PSTL_TARGET_BASE _on_default
+#endif
+#define __PSTL_TARGET_CONCAT_(X, Y) X##Y
+#define __PSTL_TARGET_CONCAT(X, Y) __PSTL_TARGET_CONCAT_(X, Y)
+#define __PSTL_TARGET_NAMESPACE(ISA) __PSTL_TARGET_CONCAT(ISA, __PSTL_TARGET_BASE)
+
 #if (__INTEL_COMPILER >= 1600)
 #define __PSTL_PRAGMA_VECTOR_UNALIGNED __PSTL_PRAGMA(vector unaligned)
 #else
@@ -143,6 +199,14 @@
 #define __PSTL_USE_NONTEMPORAL_STORES_IF_ALLOWED
 #endif
 
+// With GCC and Clang the same macro makes large contiguous copies, fills and transforms use the streaming
+// stores of the runtime-dispatched vector kernels.
+#if defined(PSTL_USE_NONTEMPORAL_STORES) && __PSTL_SIMD_DISPATCH_PRESENT
+#define __PSTL_NONTEMPORAL_STORES_PRESENT 1
+#else
+#define __PSTL_NONTEMPORAL_STORES_PRESENT 0
+#endif
+
 #if _MSC_VER || __INTEL_COMPILER //the preprocessors don't type a message location
 #define __PSTL_PRAGMA_LOCATION __FILE__ ":" __PSTL_STRING(__LINE__) ": [Parallel STL message]: "
 #else
@@ -161,6 +225,7 @@
 
 // broken macros
 #define __PSTL_CPP11_STD_ROTATE_BROKEN ((__GLIBCXX__ && __GLIBCXX__ < 20150716) || (_MSC_VER && _MSC_VER < 1800))
+#define __PSTL_CPP11_IS_TRIVIALLY_COPYABLE_BROKEN (__GLIBCXX__ && __PSTL_GCC_VERSION < 50000)
 #define __PSTL_ICC_19_VC_UDR_RELEASE_DEBUG_BROKEN (_DEBUG && __INTEL_COMPILER == 1900 && _MSC_VER && _MSC_VER <= 1913)
 
 #define __PSTL_ICC_18_OMP_SIMD_BROKEN (__INTEL_COMPILER == 1800)
@@ -0,0 +1,274 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_ranges_impl_H
+#define __PSTL_ranges_impl_H
+
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "execution_impl.h"
+#include "glue_algorithm_defs.h"
+#include "glue_numeric_defs.h"
+#include "../views.h"
+
+namespace __pstl {
+namespace internal {
+
+//! Whether std::begin and std::end apply to _Range
+template<typename _Range, typename = void>
+struct is_range : std::false_type {};
+
+template<typename _Range>
+struct is_range<_Range, decltype((void)std::begin(std::declval<_Range&>()), (void)std::end(std::declval<_Range&>()))> : std::true_type {};
+
+//! Whether _Range has data() returning a pointer and size(), as the contiguous containers and spans have
+template<typename _Range, typename = void>
+struct has_data : std::false_type {};
+
+template<typename _Range>
+struct has_data<_Range, decltype((void)std::declval<_Range&>().data(), (void)std::declval<_Range&>().size())>
+    : std::is_pointer<decltype(std::declval<_Range&>().data())> {};
+
+template<typename _Range>
+using range_iterator_t = decltype(std::begin(std::declval<_Range&>()));
+
+//! How the algorithms see a range: contiguous ranges as pointers, the others as their iterators.
+/** first() and last() delimit the sequence for the algorithms, result() maps an iterator of the algorithms
+    back to the range and inner() maps an iterator of the range, e.g. the middle of rotate, to the algorithms. */
+template<typename _Range, bool = has_data<_Range>::value && !std::is_pointer<range_iterator_t<_Range>>::value &&
+                                 is_random_access_iterator<range_iterator_t<_Range>>::value>
+struct range_access {
+    typedef range_iterator_t<_Range> iterator;
+    typedef iterator brick_iterator;
+    typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+
+    static brick_iterator first(_Range& __r) { return std::begin(__r); }
+    static brick_iterator last(_Range& __r) { return std::end(__r); }
+    static iterator result(_Range&, brick_iterator __it) { return __it; }
+    static brick_iterator inner(_Range&, iterator __it) { return __it; }
+};
+
+template<typename _Range>
+struct range_access<_Range, true> {
+    typedef range_iterator_t<_Range> iterator;
+    typedef decltype(std::declval<_Range&>().data()) brick_iterator;
+    typedef typename std::iterator_traits<iterator>::difference_type difference_type;
+
+    static brick_iterator first(_Range& __r) { return __r.data(); }
+    static brick_iterator last(_Range& __r) { return __r.data() + __r.size(); }
+    static iterator result(_Range& __r, brick_iterator __it) { return std::begin(__r) + (__it - __r.data()); }
+    static brick_iterator inner(_Range& __r, iterator __it) { return __r.data() + (__it - std::begin(__r)); }
+};
+
+template<typename _Range>
+using range_access_t = range_access<typename std::remove_reference<_Range>::type>;
+
+template<typename _Range>
+typename range_access_t<_Range>::brick_iterator range_first(_Range& __r) {
+    return range_access_t<_Range>::first(__r);
+}
+
+template<typename _Range>
+typename range_access_t<_Range>::brick_iterator range_last(_Range& __r) {
+    return range_access_t<_Range>::last(__r);
+}
+
+template<typename _Range>
+typename range_access_t<_Range>::difference_type range_size(_Range& __r) {
+    return std::distance(range_access_t<_Range>::first(__r), range_access_t<_Range>::last(__r));
+}
+
+template<typename _Range>
+typename range_access_t<_Range>::iterator range_result(_Range& __r, typename range_access_t<_Range>::brick_iterator __it) {
+    return range_access_t<_Range>::result(__r, __it);
+}
+
+template<typename _Range>
+typename range_access_t<_Range>::brick_iterator range_inner(_Range& __r, typename range_access_t<_Range>::iterator __it) {
+    return range_access_t<_Range>::inner(__r, __it);
+}
+
+//! The first __n elements of __r, or all of them if there are fewer
+template<typename _Range>
+typename range_access_t<_Range>::brick_iterator range_last(_Range& __r, std::ptrdiff_t __n) {
+    if (__n == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r) <= __n)
+        return internal::range_last(__r);
+    return std::next(internal::range_first(__r), __n);
+}
+
+//! Output of an algorithm: an iterator, or a range that also bounds the number of elements written
+template<typename _Out, bool = is_range<typename std::remove_reference<_Out>::type>::value>
+struct output_access {
+    typedef typename std::decay<_Out>::type iterator;
+    typedef iterator brick_iterator;
+
+    static brick_iterator first(_Out& __out) { return __out; }
+    static std::ptrdiff_t capacity(_Out&) { return std::numeric_limits<std::ptrdiff_t>::max(); }
+    static iterator result(_Out&, brick_iterator __it) { return __it; }
+};
+
+template<typename _Out>
+struct output_access<_Out, true> {
+    typedef typename range_access_t<_Out>::iterator iterator;
+    typedef typename range_access_t<_Out>::brick_iterator brick_iterator;
+
+    static brick_iterator first(_Out& __out) { return internal::range_first(__out); }
+    static std::ptrdiff_t capacity(_Out& __out) { return internal::range_size(__out); }
+    static iterator result(_Out& __out, brick_iterator __it) { return internal::range_result(__out, __it); }
+};
+
+template<typename _Out>
+using output_access_t = output_access<typename std::remove_reference<_Out>::type>;
+
+template<typename _Out>
+using output_iterator_t = typename output_access_t<_Out>::iterator;
+
+//! Output iterator that writes the first __cap elements assigned through it and drops the others
+template<typename _Iterator>
+class bounded_output_iterator {
+public:
+    typedef std::output_iterator_tag iterator_category;
+    typedef void value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef void pointer;
+    typedef void reference;
+
+    bounded_output_iterator(_Iterator __it, std::ptrdiff_t __cap) : _M_it(__it), _M_cap(__cap) {}
+
+    bounded_output_iterator& operator*() { return *this; }
+    template<typename _Tp, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<_Tp>::type, bounded_output_iterator>::value>::type>
+    bounded_output_iterator& operator=(_Tp&& __x) {
+        if (_M_cap > 0) {
+            *_M_it = std::forward<_Tp>(__x);
+            ++_M_it;
+            --_M_cap;
+        }
+        return *this;
+    }
+    bounded_output_iterator& operator++() { return *this; }
+    bounded_output_iterator& operator++(int) { return *this; }
+
+    _Iterator base() const { return _M_it; }
+
+private:
+    _Iterator _M_it;
+    std::ptrdiff_t _M_cap;
+};
+
+//! Writes the elements passed to it through an output iterator, in order
+template<typename _Iterator>
+struct output_writer {
+    _Iterator* _M_it;
+    template<typename _Tp>
+    void operator()(_Tp&& __x) const {
+        **_M_it = std::forward<_Tp>(__x);
+        ++*_M_it;
+    }
+};
+
+//------------------------------------------------------------------------
+// Algorithms that views execute fused, dispatched on whether the range is a view
+//------------------------------------------------------------------------
+
+template<class _ExecutionPolicy, class _Range, class _Function>
+void
+range_for_each(_ExecutionPolicy&& __exec, _Range&& __r, _Function __f, /*is_view=*/std::false_type) {
+    std::for_each(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __f);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Function>
+void
+range_for_each(_ExecutionPolicy&& __exec, _Range&& __r, _Function __f, /*is_view=*/std::true_type) {
+    views::for_each(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __f);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+std::ptrdiff_t
+range_count_if(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred, /*is_view=*/std::false_type) {
+    return std::count_if(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __pred);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+std::ptrdiff_t
+range_count_if(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred, /*is_view=*/std::true_type) {
+    return views::count(std::forward<_ExecutionPolicy>(__exec), views::filter(std::forward<_Range>(__r), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::output_iterator_t<_Output>
+range_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, /*is_view=*/std::false_type) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::copy(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::output_iterator_t<_Output>
+range_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, /*is_view=*/std::true_type) {
+    typedef internal::output_access_t<_Output> _Out;
+    typedef typename _Out::brick_iterator _OutputIterator;
+    const typename views::view_of<_Range>::type __v = views::all(std::forward<_Range>(__r));
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__v.size() <= __cap)
+        return _Out::result(__result, views::copy(std::forward<_ExecutionPolicy>(__exec), __v, _Out::first(__result)));
+    // The view may have more elements than the output holds: write them in order, up to the end of the output
+    internal::bounded_output_iterator<_OutputIterator> __out(_Out::first(__result), __cap);
+    internal::output_writer<internal::bounded_output_iterator<_OutputIterator>> __writer{&__out};
+    internal::pattern_view_for_each(__v, __writer, /*is_vector=*/std::false_type(), /*is_parallel=*/std::false_type());
+    return _Out::result(__result, __out.base());
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp, class _BinaryOperation>
+_Tp
+range_reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init, _BinaryOperation __binary_op, /*is_view=*/std::false_type) {
+    return std::reduce(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __init,
+        __binary_op);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp, class _BinaryOperation>
+_Tp
+range_reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init, _BinaryOperation __binary_op, /*is_view=*/std::true_type) {
+    return views::reduce(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __init, __binary_op);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp, class _BinaryOperation, class _UnaryOperation>
+_Tp
+range_transform_reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op,
+                       /*is_view=*/std::false_type) {
+    return std::transform_reduce(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r),
+        __init, __binary_op, __unary_op);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp, class _BinaryOperation, class _UnaryOperation>
+_Tp
+range_transform_reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op,
+                       /*is_view=*/std::true_type) {
+    return views::reduce(std::forward<_ExecutionPolicy>(__exec), views::transform(std::forward<_Range>(__r), __unary_op), __init,
+        __binary_op);
+}
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_ranges_impl_H */
@@ -0,0 +1,145 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_segmented_impl_H
+#define __PSTL_segmented_impl_H
+
+#include <deque>
+#include <iterator>
+#include <type_traits>
+
+#include "pstl_config.h"
+
+// A segmented iterator runs over a sequence of contiguous segments, like the blocks of std::deque. Random access
+// through it recomputes the segment of every element, so the bricks over such a range neither vectorize nor get
+// the benefit of the contiguity. segmented_iterator_traits splits the iterator into its segment and an iterator
+// local to the segment; the patterns then divide the range among the threads at segment boundaries and hand every
+// segment to the bricks as a range of local iterators, which are pointers for std::deque.
+
+namespace __pstl {
+
+//! Protocol of segmented iterators, to be specialized for the iterators of a segmented container with
+/** @code
+    typedef std::true_type is_segmented_iterator;
+    typedef ... segment_iterator;                    // random access iterator over the segments
+    typedef ... local_iterator;                      // random access iterator within a segment
+    static segment_iterator segment(_Iterator);      // segment of an iterator
+    static local_iterator local(_Iterator);          // position of an iterator within its segment
+    static local_iterator begin(segment_iterator);   // beginning of a segment
+    static local_iterator end(segment_iterator);     // end of a segment
+    static _Iterator compose(segment_iterator, local_iterator);
+    @endcode
+    The iterators at the end of a segment and at the beginning of the next one must be equal. */
+template<typename _Iterator>
+struct segmented_iterator_traits {
+    typedef std::false_type is_segmented_iterator;
+};
+
+#if defined(__GLIBCXX__)
+namespace internal {
+
+template<typename _Iterator, typename _LocalIterator>
+struct deque_segmented_iterator_traits {
+    typedef std::true_type is_segmented_iterator;
+    typedef typename _Iterator::_Map_pointer segment_iterator;
+    typedef _LocalIterator local_iterator;
+
+    static segment_iterator segment(const _Iterator& __it) { return __it._M_node; }
+    static local_iterator local(const _Iterator& __it) { return __it._M_cur; }
+    static local_iterator begin(segment_iterator __s) { return *__s; }
+    static local_iterator end(segment_iterator __s) { return *__s + _Iterator::_S_buffer_size(); }
+    static _Iterator compose(segment_iterator __s, local_iterator __l) {
+        _Iterator __it;
+        __it._M_set_node(__s);
+        __it._M_cur = const_cast<typename _Iterator::_Elt_pointer>(__l);
+        return __it;
+    }
+};
+
+} // namespace internal
+
+template<typename _Tp>
+struct segmented_iterator_traits<std::_Deque_iterator<_Tp, _Tp&, _Tp*>>
+    : internal::deque_segmented_iterator_traits<std::_Deque_iterator<_Tp, _Tp&, _Tp*>, _Tp*> {};
+
+template<typename _Tp>
+struct segmented_iterator_traits<std::_Deque_iterator<_Tp, const _Tp&, const _Tp*>>
+    : internal::deque_segmented_iterator_traits<std::_Deque_iterator<_Tp, const _Tp&, const _Tp*>, const _Tp*> {};
+#endif
+
+namespace internal {
+
+template<typename _Iterator>
+struct is_segmented_iterator : segmented_iterator_traits<_Iterator>::is_segmented_iterator {};
+
+//! The segments that a segmented range [__first, __last) spans, none of them empty within the range.
+/** The patterns run over the segment iterators in [segments_begin(), segments_end()), and over
+    [begin(__s), end(__s)) within a segment __s. */
+template<typename _Iterator>
+class segmented_range {
+    typedef segmented_iterator_traits<_Iterator> _Traits;
+public:
+    typedef typename _Traits::segment_iterator segment_iterator;
+    typedef typename _Traits::local_iterator local_iterator;
+    typedef typename std::iterator_traits<_Iterator>::difference_type difference_type;
+
+    segmented_range(_Iterator __first, _Iterator __last) :
+        _M_first(__first), _M_first_segment(_Traits::segment(__first)), _M_last_segment(_Traits::segment(__last)),
+        _M_first_local(_Traits::local(__first)), _M_last_local(_Traits::local(__last)) {
+        // The end of the range at the beginning of a segment is the end of the previous one
+        if (_M_last_segment != _M_first_segment && _M_last_local == _Traits::begin(_M_last_segment)) {
+            --_M_last_segment;
+            _M_last_local = _Traits::end(_M_last_segment);
+        }
+        _M_segments_end = _M_last_segment;
+        if (_M_last_segment != _M_first_segment || _M_first_local != _M_last_local)
+            ++_M_segments_end;
+    }
+
+    segment_iterator segments_begin() const { return _M_first_segment; }
+    segment_iterator segments_end() const { return _M_segments_end; }
+
+    local_iterator begin(segment_iterator __s) const {
+        return __s == _M_first_segment ? _M_first_local : _Traits::begin(__s);
+    }
+    local_iterator end(segment_iterator __s) const {
+        return __s == _M_last_segment ? _M_last_local : _Traits::end(__s);
+    }
+
+    //! The iterator of the range at __l in segment __s
+    _Iterator compose(segment_iterator __s, local_iterator __l) const { return _Traits::compose(__s, __l); }
+
+    //! Position of the beginning of segment __s in the range
+    difference_type offset(segment_iterator __s) const {
+        return __s == _M_first_segment ? difference_type(0) : _Traits::compose(__s, _Traits::begin(__s)) - _M_first;
+    }
+
+private:
+    _Iterator _M_first;
+    segment_iterator _M_first_segment;
+    segment_iterator _M_last_segment;
+    segment_iterator _M_segments_end;
+    local_iterator _M_first_local;
+    local_iterator _M_last_local;
+};
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_segmented_impl_H */
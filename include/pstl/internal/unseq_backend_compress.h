@@ -0,0 +1,257 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+
+#ifndef __PSTL_unseq_backend_compress_H
+#define __PSTL_unseq_backend_compress_H
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "pstl_config.h"
+#include "utils.h"
+#include "unseq_backend_dispatch.h"
+
+#if __PSTL_SIMD_DISPATCH_PRESENT || __PSTL_SIMD_COMPRESS_AVX512 || __PSTL_SIMD_COMPRESS_AVX2 || __PSTL_SIMD_COMPRESS_SSSE3
+#include <immintrin.h>
+#endif
+
+// This header defines the compress-store engine used by the vectorized stream compaction
+// (copy_if, partition_copy, unique_copy, partition, unique). Where the vector kernels are dispatched at run time,
+// the engine uses the instruction set get_simd_isa() reports; otherwise the one the translation unit is compiled for.
+namespace __pstl {
+namespace unseq_backend {
+
+//! Element types the engine can move as raw 32- or 64-bit lanes
+template<typename _Tp, bool = std::is_scalar<_Tp>::value>
+struct is_compressible_type : std::false_type {};
+
+template<typename _Tp>
+struct is_compressible_type<_Tp, true> : std::integral_constant<bool, sizeof(_Tp) == 4 || sizeof(_Tp) == 8> {};
+
+//! Iterators over contiguous storage of a compressible type
+template<typename _Iterator, typename _Tp = typename std::iterator_traits<_Iterator>::value_type,
+         bool = is_compressible_type<_Tp>::value>
+struct is_compressible_iterator : std::false_type {};
+
+template<typename _Iterator, typename _Tp>
+struct is_compressible_iterator<_Iterator, _Tp, true> : std::integral_constant<bool,
+    std::is_pointer<_Iterator>::value ||
+    std::is_same<_Iterator, typename std::vector<_Tp>::iterator>::value ||
+    std::is_same<_Iterator, typename std::vector<_Tp>::const_iterator>::value> {};
+
+//! Whether elements can be compacted from _InputIterator to _OutputIterator by the compress engine
+template<typename _InputIterator, typename _OutputIterator>
+struct is_compressible : std::integral_constant<bool,
+    is_compressible_iterator<_InputIterator>::value && is_compressible_iterator<_OutputIterator>::value &&
+    std::is_same<typename std::iterator_traits<_InputIterator>::value_type,
+                 typename std::iterator_traits<_OutputIterator>::value_type>::value> {};
+
+//! Stores __src[__j] for every set bit __j of __mask, __j < __len, contiguously from __dst
+template<typename _Tp>
+std::size_t compress_word_scalar(const _Tp* __src, std::size_t __len, internal::mask_word __mask, _Tp* __dst) noexcept {
+    std::size_t __cnt = 0;
+    if (__len < internal::__PSTL_MASK_WORD_BITS)
+        __mask &= (internal::mask_word(1) << __len) - 1;
+    for (; __mask; __mask &= __mask - 1, ++__cnt)
+        __dst[__cnt] = __src[internal::mask_lowest(__mask)];
+    return __cnt;
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT || __PSTL_SIMD_COMPRESS_AVX2 || __PSTL_SIMD_COMPRESS_SSSE3
+//! Shuffle tables for the compaction of 8 (AVX2) or 4 (SSSE3) 32-bit lanes
+struct compress_tables {
+    std::uint32_t _M_perm8[256];            // 3-bit lane indices, packed from the lowest bits
+    alignas(16) std::uint8_t _M_shuffle4[16][16];   // pshufb controls
+
+    compress_tables() {
+        for (std::uint32_t __m = 0; __m < 256; ++__m) {
+            std::uint32_t __code = 0, __pos = 0;
+            for (std::uint32_t __b = 0; __b < 8; ++__b)
+                if (__m >> __b & 1)
+                    __code |= __b << (3 * __pos++);
+            _M_perm8[__m] = __code;
+        }
+        for (std::uint32_t __m = 0; __m < 16; ++__m) {
+            std::uint32_t __pos = 0;
+            for (std::uint32_t __b = 0; __b < 4; ++__b)
+                if (__m >> __b & 1) {
+                    for (std::uint32_t __byte = 0; __byte < 4; ++__byte)
+                        _M_shuffle4[__m][4 * __pos + __byte] = std::uint8_t(4 * __b + __byte);
+                    ++__pos;
+                }
+            for (std::uint32_t __byte = 4 * __pos; __byte < 16; ++__byte)
+                _M_shuffle4[__m][__byte] = 0x80;
+        }
+    }
+};
+
+inline const compress_tables& get_compress_tables() {
+    static const compress_tables __tables;
+    return __tables;
+}
+
+//! Repeats every bit of a 4-bit mask twice, so that 64-bit lanes can be compacted as pairs of 32-bit lanes
+inline std::uint32_t compress_double_bits(std::uint32_t __m) {
+    return (__m & 1) * 3 | (__m & 2) * 6 | (__m & 4) * 12 | (__m & 8) * 24;
+}
+#endif
+
+#if __PSTL_SIMD_DISPATCH_PRESENT || __PSTL_SIMD_COMPRESS_AVX512
+__PSTL_TARGET_REGION_BEGIN("avx512f,avx512bw,avx2,popcnt")
+namespace __avx512 {
+inline namespace __PSTL_TARGET_NAMESPACE(__avx512) {
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t compress_word(const _Tp* __src, std::size_t __len, internal::mask_word __mask, _Tp* __dst, std::integral_constant<std::size_t, 4>) noexcept {
+    std::size_t __cnt = 0, __j = 0;
+    for (; __j + 16 <= __len; __j += 16) {
+        const __mmask16 __k = __mmask16(__mask >> __j);
+        _mm512_mask_compressstoreu_epi32(__dst + __cnt, __k, _mm512_loadu_si512(__src + __j));
+        __cnt += internal::mask_popcount(__k);
+    }
+    return __cnt + compress_word_scalar(__src + __j, __len - __j, __mask >> (__j & 63), __dst + __cnt);
+}
+
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t compress_word(const _Tp* __src, std::size_t __len, internal::mask_word __mask, _Tp* __dst, std::integral_constant<std::size_t, 8>) noexcept {
+    std::size_t __cnt = 0, __j = 0;
+    for (; __j + 8 <= __len; __j += 8) {
+        const __mmask8 __k = __mmask8(__mask >> __j);
+        _mm512_mask_compressstoreu_epi64(__dst + __cnt, __k, _mm512_loadu_si512(__src + __j));
+        __cnt += internal::mask_popcount(__k);
+    }
+    return __cnt + compress_word_scalar(__src + __j, __len - __j, __mask >> (__j & 63), __dst + __cnt);
+}
+} // inline namespace
+} // namespace __avx512
+__PSTL_TARGET_REGION_END
+#endif
+
+#if __PSTL_SIMD_DISPATCH_PRESENT || __PSTL_SIMD_COMPRESS_AVX2
+__PSTL_TARGET_REGION_BEGIN("avx2,popcnt")
+namespace __avx2 {
+inline namespace __PSTL_TARGET_NAMESPACE(__avx2) {
+// Full vectors are stored while they fit into the compacted output, the last one is stored with a lane mask.
+// Hence nothing beyond the compacted output is written and the compaction may be done in place.
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t compress_word(const _Tp* __src, std::size_t __len, internal::mask_word __mask, _Tp* __dst, std::integral_constant<std::size_t, 4>) noexcept {
+    const compress_tables& __tables = get_compress_tables();
+    const __m256i __shift = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    const __m256i __lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const std::size_t __total = internal::mask_popcount(__len < 64 ? __mask & ((internal::mask_word(1) << __len) - 1) : __mask);
+    std::size_t __cnt = 0, __j = 0;
+    for (; __j + 8 <= __len; __j += 8) {
+        const std::uint32_t __m = std::uint32_t(__mask >> __j) & 0xFF;
+        const __m256i __idx = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(__tables._M_perm8[__m]), __shift), _mm256_set1_epi32(7));
+        const __m256i __v = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)(__src + __j)), __idx);
+        const std::size_t __k = internal::mask_popcount(__m);
+        if (__cnt + 8 <= __total)
+            _mm256_storeu_si256((__m256i*)(__dst + __cnt), __v);
+        else
+            _mm256_maskstore_epi32((int*)(__dst + __cnt), _mm256_cmpgt_epi32(_mm256_set1_epi32(int(__k)), __lane), __v);
+        __cnt += __k;
+    }
+    return __cnt + compress_word_scalar(__src + __j, __len - __j, __mask >> (__j & 63), __dst + __cnt);
+}
+
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t compress_word(const _Tp* __src, std::size_t __len, internal::mask_word __mask, _Tp* __dst, std::integral_constant<std::size_t, 8>) noexcept {
+    const compress_tables& __tables = get_compress_tables();
+    const __m256i __shift = _mm256_setr_epi32(0, 3, 6, 9, 12, 15, 18, 21);
+    const __m256i __lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    const std::size_t __total = internal::mask_popcount(__len < 64 ? __mask & ((internal::mask_word(1) << __len) - 1) : __mask);
+    std::size_t __cnt = 0, __j = 0;
+    for (; __j + 4 <= __len; __j += 4) {
+        const std::uint32_t __m = std::uint32_t(__mask >> __j) & 0xF;
+        const __m256i __idx = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(__tables._M_perm8[compress_double_bits(__m)]), __shift), _mm256_set1_epi32(7));
+        const __m256i __v = _mm256_permutevar8x32_epi32(_mm256_loadu_si256((const __m256i*)(__src + __j)), __idx);
+        const std::size_t __k = internal::mask_popcount(__m);
+        if (__cnt + 4 <= __total)
+            _mm256_storeu_si256((__m256i*)(__dst + __cnt), __v);
+        else
+            _mm256_maskstore_epi32((int*)(__dst + __cnt), _mm256_cmpgt_epi32(_mm256_set1_epi32(int(2 * __k)), __lane), __v);
+        __cnt += __k;
+    }
+    return __cnt + compress_word_scalar(__src + __j, __len - __j, __mask >> (__j & 63), __dst + __cnt);
+}
+} // inline namespace
+} // namespace __avx2
+__PSTL_TARGET_REGION_END
+#endif
+
+#if __PSTL_SIMD_DISPATCH_PRESENT || __PSTL_SIMD_COMPRESS_SSSE3
+__PSTL_TARGET_REGION_BEGIN("sse4.2,popcnt")
+namespace __sse42 {
+inline namespace __PSTL_TARGET_NAMESPACE(__sse42) {
+// Full vectors are stored while they fit into the compacted output, the rest is stored element-wise.
+template<typename _Tp, std::size_t _Size>
+__PSTL_TARGET_KERNEL std::size_t compress_word(const _Tp* __src, std::size_t __len, internal::mask_word __mask, _Tp* __dst, std::integral_constant<std::size_t, _Size>) noexcept {
+    const compress_tables& __tables = get_compress_tables();
+    const std::size_t __lanes = 16 / _Size;
+    const std::size_t __total = internal::mask_popcount(__len < 64 ? __mask & ((internal::mask_word(1) << __len) - 1) : __mask);
+    std::size_t __cnt = 0, __j = 0;
+    for (; __j + __lanes <= __len && __cnt + __lanes <= __total; __j += __lanes) {
+        std::uint32_t __m = std::uint32_t(__mask >> __j) & ((1u << __lanes) - 1);
+        const std::size_t __k = internal::mask_popcount(__m);
+        if (_Size == 8)
+            __m = compress_double_bits(__m);
+        const __m128i __v = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)(__src + __j)),
+                                             _mm_load_si128((const __m128i*)__tables._M_shuffle4[__m]));
+        _mm_storeu_si128((__m128i*)(__dst + __cnt), __v);
+        __cnt += __k;
+    }
+    return __cnt + compress_word_scalar(__src + __j, __len - __j, __mask >> (__j & 63), __dst + __cnt);
+}
+} // inline namespace
+} // namespace __sse42
+__PSTL_TARGET_REGION_END
+#endif
+
+//! Stores __src[__j] for every set bit __j of __mask, __j < __len <= 64, contiguously from __dst.
+/** Returns the number of stored elements. Nothing beyond them is written and __dst may alias __src
+    as long as __dst <= __src. */
+template<typename _Tp>
+std::size_t compress_word(const _Tp* __src, std::size_t __len, internal::mask_word __mask, _Tp* __dst) noexcept {
+#if __PSTL_SIMD_DISPATCH_PRESENT || __PSTL_SIMD_COMPRESS_AVX512 || __PSTL_SIMD_COMPRESS_AVX2 || __PSTL_SIMD_COMPRESS_SSSE3
+    typedef std::integral_constant<std::size_t, sizeof(_Tp)> _Size;
+#endif
+#if __PSTL_SIMD_DISPATCH_PRESENT
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::compress_word(__src, __len, __mask, __dst, _Size());
+    case __simd_isa_avx2:   return __avx2::compress_word(__src, __len, __mask, __dst, _Size());
+    case __simd_isa_sse42:  return __sse42::compress_word(__src, __len, __mask, __dst, _Size());
+    default:                return compress_word_scalar(__src, __len, __mask, __dst);
+    }
+#elif __PSTL_SIMD_COMPRESS_AVX512
+    return __avx512::compress_word(__src, __len, __mask, __dst, _Size());
+#elif __PSTL_SIMD_COMPRESS_AVX2
+    return __avx2::compress_word(__src, __len, __mask, __dst, _Size());
+#elif __PSTL_SIMD_COMPRESS_SSSE3
+    return __sse42::compress_word(__src, __len, __mask, __dst, _Size());
+#else
+    return compress_word_scalar(__src, __len, __mask, __dst);
+#endif
+}
+
+} // namespace unseq_backend
+} // namespace __pstl
+
+#endif /* __PSTL_unseq_backend_compress_H */
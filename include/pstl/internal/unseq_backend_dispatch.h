@@ -0,0 +1,456 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+
+#ifndef __PSTL_unseq_backend_dispatch_H
+#define __PSTL_unseq_backend_dispatch_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "pstl_config.h"
+#include "utils.h"
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+#include <immintrin.h>
+#endif
+
+#if __PSTL_NONTEMPORAL_STORES_PRESENT && (__unix__ || __APPLE__)
+#include <unistd.h>
+#endif
+
+// This header defines the vector kernels that are chosen at run time from the instruction sets
+// the processor supports (SSE4.2, AVX2 or AVX-512). They serve the common cases of find, count,
+// find_first_of, adjacent_find, mismatch, equal, search, find_end, min_element, max_element and
+// minmax_element over contiguous arithmetic sequences, which the OpenMP SIMD loops of the other
+// unseq routines vectorize only with compilers that support early exits and user-defined reductions.
+// With PSTL_USE_NONTEMPORAL_STORES they also store large copies, fills and transforms with streaming stores.
+namespace __pstl {
+namespace unseq_backend {
+
+//! Element types the dispatched kernels compare for equality
+template<typename _Tp>
+struct is_dispatch_type : std::integral_constant<bool,
+    (std::is_integral<_Tp>::value && !std::is_same<_Tp, bool>::value) ||
+    std::is_same<_Tp, float>::value || std::is_same<_Tp, double>::value> {};
+
+//! Element types the dispatched kernels also order
+template<typename _Tp>
+struct is_dispatch_ordered_type : std::integral_constant<bool,
+    std::is_integral<_Tp>::value && !std::is_same<_Tp, bool>::value> {};
+
+//! Iterators over contiguous storage of a type supported by the dispatched kernels
+template<typename _Iterator, typename _Tp = typename std::iterator_traits<_Iterator>::value_type,
+         bool = __PSTL_SIMD_DISPATCH_PRESENT && is_dispatch_type<_Tp>::value>
+struct is_dispatch_iterator : std::false_type {};
+
+template<typename _Iterator, typename _Tp>
+struct is_dispatch_iterator<_Iterator, _Tp, true> : std::integral_constant<bool,
+    std::is_pointer<_Iterator>::value ||
+    std::is_same<_Iterator, typename std::vector<_Tp>::iterator>::value ||
+    std::is_same<_Iterator, typename std::vector<_Tp>::const_iterator>::value> {};
+
+//! Whether a search for elements equal to a value of type _Up can be done by the dispatched kernels
+template<typename _Iterator, typename _Up, typename _Tp = typename std::iterator_traits<_Iterator>::value_type>
+struct is_dispatch_equal_value : std::integral_constant<bool, is_dispatch_iterator<_Iterator>::value &&
+    ((is_dispatch_ordered_type<_Tp>::value && is_dispatch_ordered_type<_Up>::value) || std::is_same<_Tp, _Up>::value)> {};
+
+//! Whether _Predicate is the equality of the value type of _Iterator
+template<typename _Iterator, typename _Predicate, typename _Tp = typename std::iterator_traits<_Iterator>::value_type>
+struct is_dispatch_equal : std::integral_constant<bool, is_dispatch_iterator<_Iterator>::value &&
+    (std::is_same<_Predicate, internal::pstl_equal>::value || std::is_same<_Predicate, std::equal_to<_Tp>>::value)> {};
+
+//! Whether _Predicate is the equality of the common value type of _Iterator1 and _Iterator2
+template<typename _Iterator1, typename _Iterator2, typename _Predicate,
+         typename _Tp = typename std::iterator_traits<_Iterator1>::value_type>
+struct is_dispatch_equal_ranges : std::integral_constant<bool,
+    is_dispatch_iterator<_Iterator1>::value && is_dispatch_iterator<_Iterator2>::value &&
+    std::is_same<_Tp, typename std::iterator_traits<_Iterator2>::value_type>::value &&
+    (std::is_same<_Predicate, internal::pstl_equal>::value || std::is_same<_Predicate, std::equal_to<_Tp>>::value)> {};
+
+//! Whether _Compare is the "<" of the common value type of _Iterator1 and _Iterator2, under which equivalence is equality
+template<typename _Iterator1, typename _Iterator2, typename _Compare,
+         typename _Tp = typename std::iterator_traits<_Iterator1>::value_type>
+struct is_dispatch_less_ranges : std::integral_constant<bool,
+    is_dispatch_iterator<_Iterator1>::value && is_dispatch_iterator<_Iterator2>::value &&
+    std::is_same<_Tp, typename std::iterator_traits<_Iterator2>::value_type>::value && is_dispatch_ordered_type<_Tp>::value &&
+    (std::is_same<_Compare, internal::pstl_less>::value || std::is_same<_Compare, std::less<_Tp>>::value)> {};
+
+//! Whether _Predicate is the inequality of the common value type of _Iterator1 and _Iterator2, as mismatch and equal pass it
+template<typename _Iterator1, typename _Iterator2, typename _Predicate,
+         typename _Tp = typename std::iterator_traits<_Iterator1>::value_type>
+struct is_dispatch_not_equal : std::integral_constant<bool,
+    is_dispatch_iterator<_Iterator1>::value && is_dispatch_iterator<_Iterator2>::value &&
+    std::is_same<_Tp, typename std::iterator_traits<_Iterator2>::value_type>::value &&
+    (std::is_same<_Predicate, internal::not_pred<internal::pstl_equal>>::value ||
+     std::is_same<_Predicate, internal::not_pred<std::equal_to<_Tp>>>::value)> {};
+
+//! Whether _Compare is the "<" of the value type of _Iterator
+template<typename _Iterator, typename _Compare, typename _Tp = typename std::iterator_traits<_Iterator>::value_type>
+struct is_dispatch_less : std::integral_constant<bool, is_dispatch_iterator<_Iterator>::value &&
+    is_dispatch_ordered_type<_Tp>::value &&
+    (std::is_same<_Compare, internal::pstl_less>::value || std::is_same<_Compare, std::less<_Tp>>::value)> {};
+
+//! Whether _Compare is the ">" of the value type of _Iterator, as max_element passes it to min_element
+template<typename _Iterator, typename _Compare, typename _Tp = typename std::iterator_traits<_Iterator>::value_type>
+struct is_dispatch_greater : std::integral_constant<bool, is_dispatch_iterator<_Iterator>::value &&
+    is_dispatch_ordered_type<_Tp>::value &&
+    (std::is_same<_Compare, internal::reorder_pred<internal::pstl_less>>::value ||
+     std::is_same<_Compare, internal::reorder_pred<std::less<_Tp>>>::value)> {};
+
+//! Element types that may be copied as bytes
+template<typename _Tp>
+struct is_bytewise_type : std::integral_constant<bool,
+#if __PSTL_CPP11_IS_TRIVIALLY_COPYABLE_BROKEN
+    std::is_trivial<_Tp>::value &&
+#else
+    std::is_trivially_copyable<_Tp>::value &&
+#endif
+    !std::is_array<_Tp>::value> {};
+
+//! Iterators over contiguous storage of elements that may be copied as bytes; vector<bool> is not contiguous
+template<typename _Iterator, typename _Tp = typename std::iterator_traits<_Iterator>::value_type,
+         bool = is_bytewise_type<_Tp>::value>
+struct is_bytewise_iterator : std::false_type {};
+
+template<typename _Iterator, typename _Tp>
+struct is_bytewise_iterator<_Iterator, _Tp, true> : std::integral_constant<bool,
+    std::is_pointer<_Iterator>::value || (!std::is_same<_Tp, bool>::value &&
+    (std::is_same<_Iterator, typename std::vector<_Tp>::iterator>::value ||
+     std::is_same<_Iterator, typename std::vector<_Tp>::const_iterator>::value))> {};
+
+//! Whether a copy from _Iterator1 to _Iterator2 may be done by memmove
+template<typename _Iterator1, typename _Iterator2>
+struct is_bytewise_copy : std::integral_constant<bool,
+    is_bytewise_iterator<_Iterator1>::value && is_bytewise_iterator<_Iterator2>::value &&
+    std::is_same<typename std::iterator_traits<_Iterator1>::value_type,
+                 typename std::iterator_traits<_Iterator2>::value_type>::value> {};
+
+//! Whether values can be stored to _Iterator by memset, if all the bytes of the value are equal
+template<typename _Iterator, typename _Tp = typename std::iterator_traits<_Iterator>::value_type>
+struct is_bytewise_fill : std::integral_constant<bool, is_bytewise_iterator<_Iterator>::value &&
+    std::is_scalar<_Tp>::value && !std::is_member_pointer<_Tp>::value> {};
+
+//! Whether swapping the elements of _Iterator1 and _Iterator2 may be done by copying bytes, i.e. there is no user swap
+template<typename _Iterator1, typename _Iterator2, typename _Tp = typename std::iterator_traits<_Iterator1>::value_type>
+struct is_bytewise_swap : std::integral_constant<bool, is_bytewise_copy<_Iterator1, _Iterator2>::value &&
+    (std::is_arithmetic<_Tp>::value || std::is_pointer<_Tp>::value)> {};
+
+//! Whether a copy from _Iterator1 to _Iterator2 can be done by the streaming kernels
+template<typename _Iterator1, typename _Iterator2>
+struct is_stream_copy : std::integral_constant<bool, __PSTL_NONTEMPORAL_STORES_PRESENT && is_bytewise_copy<_Iterator1, _Iterator2>::value> {};
+
+//! Whether values can be stored to _Iterator by the streaming fill kernel.
+/** The element is a scalar whose size is a power of two that divides the vector width and whose alignment is its size. */
+template<typename _Iterator, typename _Tp = typename std::iterator_traits<_Iterator>::value_type>
+struct is_stream_fill : std::integral_constant<bool, __PSTL_NONTEMPORAL_STORES_PRESENT && is_bytewise_fill<_Iterator>::value &&
+    sizeof(_Tp) <= 16 && (sizeof(_Tp) & (sizeof(_Tp) - 1)) == 0 && alignof(_Tp) == sizeof(_Tp)> {};
+
+//! Converts __value to the element type _Tp.
+/** Returns false if no value of type _Tp compares equal to __value, e.g. 300 for unsigned char. */
+template<typename _Tp, typename _Up>
+bool dispatch_value(const _Up& __value, _Tp& __result) noexcept {
+    typedef typename std::common_type<_Tp, _Up>::type _Cp;
+    __result = static_cast<_Tp>(__value);
+    return _Cp(__result) == _Cp(__value);
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+
+//! Most values find_first_of compares against at once
+const std::size_t __PSTL_DISPATCH_MAX_NEEDLES = 16;
+
+__PSTL_TARGET_REGION_BEGIN("sse4.2,popcnt")
+namespace __sse42 {
+inline namespace __PSTL_TARGET_NAMESPACE(__sse42) {
+template<typename _Mp>
+internal::mask_word movemask(_Mp __m) noexcept { return std::uint32_t(_mm_movemask_epi8((__m128i)__m)); }
+
+//! Byte __t[__i[__j]] of the 16-byte row of __t that holds byte __j, for each __j; __i[__j] < 16
+template<typename _Vp>
+_Vp shuffle_bytes(_Vp __t, _Vp __i) noexcept { return (_Vp)_mm_shuffle_epi8((__m128i)__t, (__m128i)__i); }
+
+//! Non-temporal store of __v to __p, which is aligned to the vector width
+template<typename _Vp>
+void stream_store(_Vp* __p, _Vp __v) noexcept { _mm_stream_si128((__m128i*)__p, (__m128i)__v); }
+
+#define __PSTL_DISPATCH_WIDTH 16
+#include "unseq_backend_dispatch_impl.h"
+#undef __PSTL_DISPATCH_WIDTH
+} // inline namespace
+} // namespace __sse42
+__PSTL_TARGET_REGION_END
+
+__PSTL_TARGET_REGION_BEGIN("avx2,popcnt")
+namespace __avx2 {
+inline namespace __PSTL_TARGET_NAMESPACE(__avx2) {
+template<typename _Mp>
+internal::mask_word movemask(_Mp __m) noexcept { return std::uint32_t(_mm256_movemask_epi8((__m256i)__m)); }
+
+//! Byte __t[__i[__j]] of the 16-byte row of __t that holds byte __j, for each __j; __i[__j] < 16
+template<typename _Vp>
+_Vp shuffle_bytes(_Vp __t, _Vp __i) noexcept { return (_Vp)_mm256_shuffle_epi8((__m256i)__t, (__m256i)__i); }
+
+//! Non-temporal store of __v to __p, which is aligned to the vector width
+template<typename _Vp>
+void stream_store(_Vp* __p, _Vp __v) noexcept { _mm256_stream_si256((__m256i*)__p, (__m256i)__v); }
+
+#define __PSTL_DISPATCH_WIDTH 32
+#include "unseq_backend_dispatch_impl.h"
+#undef __PSTL_DISPATCH_WIDTH
+} // inline namespace
+} // namespace __avx2
+__PSTL_TARGET_REGION_END
+
+__PSTL_TARGET_REGION_BEGIN("avx512f,avx512bw,avx2,popcnt")
+namespace __avx512 {
+inline namespace __PSTL_TARGET_NAMESPACE(__avx512) {
+template<typename _Mp>
+internal::mask_word movemask(_Mp __m) noexcept { return _mm512_movepi8_mask((__m512i)__m); }
+
+//! Byte __t[__i[__j]] of the 16-byte row of __t that holds byte __j, for each __j; __i[__j] < 16
+template<typename _Vp>
+_Vp shuffle_bytes(_Vp __t, _Vp __i) noexcept { return (_Vp)_mm512_shuffle_epi8((__m512i)__t, (__m512i)__i); }
+
+//! Non-temporal store of __v to __p, which is aligned to the vector width
+template<typename _Vp>
+void stream_store(_Vp* __p, _Vp __v) noexcept { _mm512_stream_si512((__m512i*)__p, (__m512i)__v); }
+
+#define __PSTL_DISPATCH_WIDTH 64
+#include "unseq_backend_dispatch_impl.h"
+#undef __PSTL_DISPATCH_WIDTH
+} // inline namespace
+} // namespace __avx512
+__PSTL_TARGET_REGION_END
+
+enum simd_isa {
+    __simd_isa_none,
+    __simd_isa_sse42,
+    __simd_isa_avx2,
+    __simd_isa_avx512
+};
+
+inline simd_isa detect_simd_isa() noexcept {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        return __simd_isa_avx512;
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt"))
+        return __simd_isa_avx2;
+    if (__builtin_cpu_supports("sse4.2") && __builtin_cpu_supports("popcnt"))
+        return __simd_isa_sse42;
+    return __simd_isa_none;
+}
+
+//! Best instruction set of the processor, detected on the first call
+inline simd_isa get_simd_isa() noexcept {
+    static const simd_isa __isa = detect_simd_isa();
+    return __isa;
+}
+
+template<typename _Tp>
+std::size_t dispatch_find_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::find_equal(__p, __n, __value);
+    case __simd_isa_avx2:   return __avx2::find_equal(__p, __n, __value);
+    case __simd_isa_sse42:  return __sse42::find_equal(__p, __n, __value);
+    default:                return std::find(__p, __p + __n, __value) - __p;
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_rfind_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::rfind_equal(__p, __n, __value);
+    case __simd_isa_avx2:   return __avx2::rfind_equal(__p, __n, __value);
+    case __simd_isa_sse42:  return __sse42::rfind_equal(__p, __n, __value);
+    default:
+        for (std::size_t __i = __n; __i > 0; --__i)
+            if (__p[__i - 1] == __value)
+                return __i - 1;
+        return __n;
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_mismatch_equal(const _Tp* __p1, const _Tp* __p2, std::size_t __n) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::mismatch_equal(__p1, __p2, __n);
+    case __simd_isa_avx2:   return __avx2::mismatch_equal(__p1, __p2, __n);
+    case __simd_isa_sse42:  return __sse42::mismatch_equal(__p1, __p2, __n);
+    default:                return std::mismatch(__p1, __p1 + __n, __p2).first - __p1;
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_search_equal(const _Tp* __p, std::size_t __n, const _Tp* __s, std::size_t __m) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::search_equal(__p, __n, __s, __m);
+    case __simd_isa_avx2:   return __avx2::search_equal(__p, __n, __s, __m);
+    case __simd_isa_sse42:  return __sse42::search_equal(__p, __n, __s, __m);
+    default:                return std::search(__p, __p + __n, __s, __s + __m) - __p;
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_rsearch_equal(const _Tp* __p, std::size_t __n, const _Tp* __s, std::size_t __m) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::rsearch_equal(__p, __n, __s, __m);
+    case __simd_isa_avx2:   return __avx2::rsearch_equal(__p, __n, __s, __m);
+    case __simd_isa_sse42:  return __sse42::rsearch_equal(__p, __n, __s, __m);
+    default:                return std::find_end(__p, __p + __n, __s, __s + __m) - __p;
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_count_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::count_equal(__p, __n, __value);
+    case __simd_isa_avx2:   return __avx2::count_equal(__p, __n, __value);
+    case __simd_isa_sse42:  return __sse42::count_equal(__p, __n, __value);
+    default:                return std::count(__p, __p + __n, __value);
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_find_first_of_equal(const _Tp* __p, std::size_t __n, const _Tp* __s, std::size_t __m) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::find_first_of_equal(__p, __n, __s, __m);
+    case __simd_isa_avx2:   return __avx2::find_first_of_equal(__p, __n, __s, __m);
+    case __simd_isa_sse42:  return __sse42::find_first_of_equal(__p, __n, __s, __m);
+    default:                return std::find_first_of(__p, __p + __n, __s, __s + __m) - __p;
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_find_in_byte_set(const _Tp* __p, std::size_t __n, const unsigned char* __set) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::find_in_byte_set(__p, __n, __set);
+    case __simd_isa_avx2:   return __avx2::find_in_byte_set(__p, __n, __set);
+    case __simd_isa_sse42:  return __sse42::find_in_byte_set(__p, __n, __set);
+    default:
+        for (std::size_t __i = 0; __i < __n; ++__i)
+            if (__set[static_cast<unsigned char>(__p[__i])])
+                return __i;
+        return __n;
+    }
+}
+
+template<typename _Tp>
+std::size_t dispatch_adjacent_find_equal(const _Tp* __p, std::size_t __n) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::adjacent_find_equal(__p, __n);
+    case __simd_isa_avx2:   return __avx2::adjacent_find_equal(__p, __n);
+    case __simd_isa_sse42:  return __sse42::adjacent_find_equal(__p, __n);
+    default:                return std::adjacent_find(__p, __p + __n) - __p;
+    }
+}
+
+template<typename _Tp>
+_Tp dispatch_min_value(const _Tp* __p, std::size_t __n) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::min_value(__p, __n);
+    case __simd_isa_avx2:   return __avx2::min_value(__p, __n);
+    case __simd_isa_sse42:  return __sse42::min_value(__p, __n);
+    default:                return *std::min_element(__p, __p + __n);
+    }
+}
+
+template<typename _Tp>
+_Tp dispatch_max_value(const _Tp* __p, std::size_t __n) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: return __avx512::max_value(__p, __n);
+    case __simd_isa_avx2:   return __avx2::max_value(__p, __n);
+    case __simd_isa_sse42:  return __sse42::max_value(__p, __n);
+    default:                return *std::max_element(__p, __p + __n);
+    }
+}
+
+template<typename _Tp>
+void dispatch_minmax_value(const _Tp* __p, std::size_t __n, _Tp& __min, _Tp& __max) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: __avx512::minmax_value(__p, __n, __min, __max); break;
+    case __simd_isa_avx2:   __avx2::minmax_value(__p, __n, __min, __max); break;
+    case __simd_isa_sse42:  __sse42::minmax_value(__p, __n, __min, __max); break;
+    default:
+        __min = *std::min_element(__p, __p + __n);
+        __max = *std::max_element(__p, __p + __n);
+    }
+}
+
+#if __PSTL_NONTEMPORAL_STORES_PRESENT
+inline std::size_t detect_nontemporal_threshold() noexcept {
+#if defined(PSTL_NONTEMPORAL_THRESHOLD)
+    return PSTL_NONTEMPORAL_THRESHOLD;
+#else
+    long __cache = 0;
+#if defined(_SC_LEVEL3_CACHE_SIZE)
+    __cache = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    if (__cache <= 0)
+        __cache = sysconf(_SC_LEVEL2_CACHE_SIZE);
+#endif
+    if (__cache <= 0)
+        __cache = 8L << 20;
+    const unsigned __threads = std::thread::hardware_concurrency();
+    return std::size_t(__cache) / (__threads ? __threads : 1);
+#endif
+}
+
+//! Bytes stored by a brick above which streaming stores are used, detected on the first call.
+/** It is the share of the last level cache of a thread: a larger destination, or a larger chunk of
+    a parallel one, would only evict the data of the others before it is read again. The user may
+    set it by defining PSTL_NONTEMPORAL_THRESHOLD. */
+inline std::size_t nontemporal_threshold() noexcept {
+    static const std::size_t __bytes = detect_nontemporal_threshold();
+    return __bytes;
+}
+
+inline void dispatch_stream_copy(void* __dst, const void* __src, std::size_t __n) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: __avx512::stream_copy(__dst, __src, __n); break;
+    case __simd_isa_avx2:   __avx2::stream_copy(__dst, __src, __n); break;
+    case __simd_isa_sse42:  __sse42::stream_copy(__dst, __src, __n); break;
+    default:                std::memmove(__dst, __src, __n);
+    }
+}
+
+template<typename _Tp, typename _Generator>
+void dispatch_stream_generate(_Tp* __p, std::size_t __n, _Generator __g) noexcept {
+    switch (get_simd_isa()) {
+    case __simd_isa_avx512: __avx512::stream_generate(__p, __n, __g); break;
+    case __simd_isa_avx2:   __avx2::stream_generate(__p, __n, __g); break;
+    case __simd_isa_sse42:  __sse42::stream_generate(__p, __n, __g); break;
+    default:
+        for (std::size_t __i = 0; __i < __n; ++__i)
+            __p[__i] = __g(__i);
+    }
+}
+#endif /* __PSTL_NONTEMPORAL_STORES_PRESENT */
+
+#endif /* __PSTL_SIMD_DISPATCH_PRESENT */
+
+} // namespace unseq_backend
+} // namespace __pstl
+
+#endif /* __PSTL_unseq_backend_dispatch_H */
@@ -0,0 +1,382 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+
+// Kernels of the runtime-dispatched vector backend.
+// There is no include guard: unseq_backend_dispatch.h includes this file once per instruction set, inside
+// the namespace and the target region of that instruction set, after defining
+//     __PSTL_DISPATCH_WIDTH   - the vector width in bytes,
+//     movemask(__m)           - the bit mask of the bytes of a comparison result, one bit per byte, and
+//     shuffle_bytes(__t, __i) - the byte table lookup of the instruction set (pshufb), and
+//     stream_store(__p, __v)  - the non-temporal store of a vector to an aligned address.
+// Thus a lane of an element type _Tp is described by sizeof(_Tp) consecutive bits of a mask.
+// The kernels the dispatch functions call are __PSTL_TARGET_KERNEL functions.
+
+template<typename _Tp>
+struct vec {
+    typedef _Tp type __attribute__((vector_size(__PSTL_DISPATCH_WIDTH)));
+    static const std::size_t lanes = __PSTL_DISPATCH_WIDTH / sizeof(_Tp);
+};
+
+template<typename _Tp>
+typename vec<_Tp>::type load(const _Tp* __p) noexcept {
+    typename vec<_Tp>::type __v;
+    __builtin_memcpy(&__v, __p, sizeof(__v));
+    return __v;
+}
+
+template<typename _Tp>
+typename vec<_Tp>::type broadcast(_Tp __x) noexcept {
+    typename vec<_Tp>::type __v;
+    for (std::size_t __j = 0; __j < vec<_Tp>::lanes; ++__j)
+        __v[__j] = __x;
+    return __v;
+}
+
+//! Lane-wise minimum and maximum of integer vectors
+template<typename _Vp>
+_Vp select_min(_Vp __a, _Vp __b) noexcept {
+    const _Vp __m = (_Vp)(__b < __a);
+    return (__b & __m) | (__a & ~__m);
+}
+
+template<typename _Vp>
+_Vp select_max(_Vp __a, _Vp __b) noexcept {
+    const _Vp __m = (_Vp)(__a < __b);
+    return (__b & __m) | (__a & ~__m);
+}
+
+//! Index of the first element equal to __value, or __n
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t find_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    const typename vec<_Tp>::type __v = broadcast(__value);
+    std::size_t __i = 0;
+    // Four vectors per test; the hit is located only once the block hits
+    for (; __i + 4 * __lanes <= __n; __i += 4 * __lanes) {
+        const auto __c0 = load(__p + __i) == __v;
+        const auto __c1 = load(__p + __i + __lanes) == __v;
+        const auto __c2 = load(__p + __i + 2 * __lanes) == __v;
+        const auto __c3 = load(__p + __i + 3 * __lanes) == __v;
+        if (movemask(__c0 | __c1 | __c2 | __c3))
+            break;
+    }
+    for (; __i + __lanes <= __n; __i += __lanes) {
+        const internal::mask_word __m = movemask(load(__p + __i) == __v);
+        if (__m)
+            return __i + internal::mask_lowest(__m) / sizeof(_Tp);
+    }
+    for (; __i < __n; ++__i)
+        if (__p[__i] == __value)
+            return __i;
+    return __n;
+}
+
+//! Index of the last element equal to __value, or __n
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t rfind_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    const typename vec<_Tp>::type __v = broadcast(__value);
+    std::size_t __i = __n;
+    for (; __i >= __lanes; __i -= __lanes) {
+        const internal::mask_word __m = movemask(load(__p + __i - __lanes) == __v);
+        if (__m)
+            return __i - __lanes + internal::mask_highest(__m) / sizeof(_Tp);
+    }
+    while (__i > 0)
+        if (__p[--__i] == __value)
+            return __i;
+    return __n;
+}
+
+//! Index of the first position where [__p1, __p1 + __n) and [__p2, __p2 + __n) differ, or __n
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t mismatch_equal(const _Tp* __p1, const _Tp* __p2, std::size_t __n) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    std::size_t __i = 0;
+    for (; __i + 4 * __lanes <= __n; __i += 4 * __lanes) {
+        const auto __c0 = load(__p1 + __i) != load(__p2 + __i);
+        const auto __c1 = load(__p1 + __i + __lanes) != load(__p2 + __i + __lanes);
+        const auto __c2 = load(__p1 + __i + 2 * __lanes) != load(__p2 + __i + 2 * __lanes);
+        const auto __c3 = load(__p1 + __i + 3 * __lanes) != load(__p2 + __i + 3 * __lanes);
+        if (movemask(__c0 | __c1 | __c2 | __c3))
+            break;
+    }
+    for (; __i + __lanes <= __n; __i += __lanes) {
+        const internal::mask_word __m = movemask(load(__p1 + __i) != load(__p2 + __i));
+        if (__m)
+            return __i + internal::mask_lowest(__m) / sizeof(_Tp);
+    }
+    for (; __i < __n; ++__i)
+        if (!(__p1[__i] == __p2[__i]))
+            return __i;
+    return __n;
+}
+
+//! Bit mask of one bit per lane of _Tp, at the first byte of the lane
+template<typename _Tp>
+internal::mask_word lane_bits() noexcept {
+    return ~internal::mask_word(0) / ((internal::mask_word(1) << sizeof(_Tp)) - 1);
+}
+
+//! Index of the first occurrence of [__s, __s + __m) in [__p, __p + __n), or __n; 2 <= __m <= __n
+/** The vector loop selects the positions where both the first and the last element of the needle match;
+    only these are compared in full. */
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t search_equal(const _Tp* __p, std::size_t __n, const _Tp* __s, std::size_t __m) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    const typename vec<_Tp>::type __vfirst = broadcast(__s[0]), __vlast = broadcast(__s[__m - 1]);
+    const std::size_t __end = __n - __m + 1;
+    std::size_t __i = 0;
+    for (; __i + __lanes <= __end; __i += __lanes) {
+        internal::mask_word __mask = movemask((load(__p + __i) == __vfirst) & (load(__p + __i + __m - 1) == __vlast)) & lane_bits<_Tp>();
+        for (; __mask; __mask &= __mask - 1) {
+            const std::size_t __j = __i + internal::mask_lowest(__mask) / sizeof(_Tp);
+            if (mismatch_equal(__p + __j + 1, __s + 1, __m - 2) == __m - 2)
+                return __j;
+        }
+    }
+    for (; __i < __end; ++__i)
+        if (__p[__i] == __s[0] && __p[__i + __m - 1] == __s[__m - 1] && mismatch_equal(__p + __i + 1, __s + 1, __m - 2) == __m - 2)
+            return __i;
+    return __n;
+}
+
+//! Index of the last occurrence of [__s, __s + __m) in [__p, __p + __n), or __n; 2 <= __m <= __n
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t rsearch_equal(const _Tp* __p, std::size_t __n, const _Tp* __s, std::size_t __m) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    const typename vec<_Tp>::type __vfirst = broadcast(__s[0]), __vlast = broadcast(__s[__m - 1]);
+    std::size_t __i = __n - __m + 1;
+    for (; __i >= __lanes; __i -= __lanes) {
+        const _Tp* __q = __p + __i - __lanes;
+        internal::mask_word __mask = movemask((load(__q) == __vfirst) & (load(__q + __m - 1) == __vlast)) & lane_bits<_Tp>();
+        while (__mask) {
+            const std::size_t __b = internal::mask_highest(__mask);
+            const std::size_t __j = __i - __lanes + __b / sizeof(_Tp);
+            if (mismatch_equal(__p + __j + 1, __s + 1, __m - 2) == __m - 2)
+                return __j;
+            __mask &= ~(internal::mask_word(1) << __b);
+        }
+    }
+    while (__i > 0) {
+        --__i;
+        if (__p[__i] == __s[0] && __p[__i + __m - 1] == __s[__m - 1] && mismatch_equal(__p + __i + 1, __s + 1, __m - 2) == __m - 2)
+            return __i;
+    }
+    return __n;
+}
+
+//! Number of elements equal to __value
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t count_equal(const _Tp* __p, std::size_t __n, _Tp __value) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    const typename vec<_Tp>::type __v = broadcast(__value);
+    std::size_t __bits = 0, __i = 0;
+    for (; __i + __lanes <= __n; __i += __lanes)
+        __bits += internal::mask_popcount(movemask(load(__p + __i) == __v));
+    std::size_t __count = __bits / sizeof(_Tp);
+    for (; __i < __n; ++__i)
+        __count += __p[__i] == __value;
+    return __count;
+}
+
+//! Index of the first element equal to one of [__s, __s + __m), or __n; __m <= __PSTL_DISPATCH_MAX_NEEDLES
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t find_first_of_equal(const _Tp* __p, std::size_t __n, const _Tp* __s, std::size_t __m) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    typename vec<_Tp>::type __needles[__PSTL_DISPATCH_MAX_NEEDLES];
+    for (std::size_t __j = 0; __j < __m; ++__j)
+        __needles[__j] = broadcast(__s[__j]);
+    std::size_t __i = 0;
+    for (; __i + __lanes <= __n; __i += __lanes) {
+        const typename vec<_Tp>::type __x = load(__p + __i);
+        auto __c = __x == __needles[0];
+        for (std::size_t __j = 1; __j < __m; ++__j)
+            __c |= __x == __needles[__j];
+        const internal::mask_word __mask = movemask(__c);
+        if (__mask)
+            return __i + internal::mask_lowest(__mask) / sizeof(_Tp);
+    }
+    for (; __i < __n; ++__i)
+        for (std::size_t __j = 0; __j < __m; ++__j)
+            if (__p[__i] == __s[__j])
+                return __i;
+    return __n;
+}
+
+//! Index of the first byte __x of [__p, __p + __n) with __set[__x] != 0, or __n; sizeof(_Tp) == 1
+/** The set is kept as two tables of 16 bit masks, for bytes below and above 0x80, that are indexed by the
+    low nibble and hold one bit per value of the high nibble; so one byte shuffle classifies a whole vector
+    whatever the size of the set. */
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t find_in_byte_set(const _Tp* __p, std::size_t __n, const unsigned char* __set) noexcept {
+    typedef typename vec<unsigned char>::type _Vp;
+    const std::size_t __lanes = vec<unsigned char>::lanes;
+    _Vp __low, __high, __bit;
+    for (std::size_t __j = 0; __j < __lanes; ++__j) {
+        const std::size_t __nibble = __j & 15;
+        unsigned char __l = 0, __h = 0;
+        for (std::size_t __k = 0; __k < 8; ++__k) {
+            __l |= (__set[__k << 4 | __nibble] != 0) << __k;
+            __h |= (__set[(__k + 8) << 4 | __nibble] != 0) << __k;
+        }
+        __low[__j] = __l;
+        __high[__j] = __h;
+        __bit[__j] = 1 << (__nibble & 7);
+    }
+
+    const unsigned char* __q = reinterpret_cast<const unsigned char*>(__p);
+    std::size_t __i = 0;
+    for (; __i + __lanes <= __n; __i += __lanes) {
+        const _Vp __x = load(__q + __i);
+        const _Vp __lo = __x & 15, __hi = __x >> 4;
+        const _Vp __below = (_Vp)(__hi < 8);
+        const _Vp __rows = (shuffle_bytes(__low, __lo) & __below) | (shuffle_bytes(__high, __lo) & ~__below);
+        const internal::mask_word __m = movemask((__rows & shuffle_bytes(__bit, __hi)) != 0);
+        if (__m)
+            return __i + internal::mask_lowest(__m);
+    }
+    for (; __i < __n; ++__i)
+        if (__set[__q[__i]])
+            return __i;
+    return __n;
+}
+
+//! Index of the first element equal to its successor, or __n
+template<typename _Tp>
+__PSTL_TARGET_KERNEL std::size_t adjacent_find_equal(const _Tp* __p, std::size_t __n) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    std::size_t __i = 0;
+    for (; __i + __lanes < __n; __i += __lanes) {
+        const internal::mask_word __m = movemask(load(__p + __i) == load(__p + __i + 1));
+        if (__m)
+            return __i + internal::mask_lowest(__m) / sizeof(_Tp);
+    }
+    for (; __i + 1 < __n; ++__i)
+        if (__p[__i] == __p[__i + 1])
+            return __i;
+    return __n;
+}
+
+//! Smallest and largest of __n > 0 integers
+template<typename _Tp>
+__PSTL_TARGET_KERNEL void minmax_value(const _Tp* __p, std::size_t __n, _Tp& __min, _Tp& __max) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    if (__n < __lanes) {
+        __min = __max = __p[0];
+        for (std::size_t __i = 1; __i < __n; ++__i) {
+            __min = __p[__i] < __min ? __p[__i] : __min;
+            __max = __max < __p[__i] ? __p[__i] : __max;
+        }
+        return;
+    }
+    typename vec<_Tp>::type __vmin = load(__p), __vmax = __vmin;
+    for (std::size_t __i = __lanes; __i + __lanes <= __n; __i += __lanes) {
+        const typename vec<_Tp>::type __x = load(__p + __i);
+        __vmin = select_min(__vmin, __x);
+        __vmax = select_max(__vmax, __x);
+    }
+    // The last vector may overlap the processed ones, which does not change the result
+    const typename vec<_Tp>::type __x = load(__p + __n - __lanes);
+    __vmin = select_min(__vmin, __x);
+    __vmax = select_max(__vmax, __x);
+    __min = __vmin[0];
+    __max = __vmax[0];
+    for (std::size_t __j = 1; __j < __lanes; ++__j) {
+        __min = __vmin[__j] < __min ? _Tp(__vmin[__j]) : __min;
+        __max = __max < __vmax[__j] ? _Tp(__vmax[__j]) : __max;
+    }
+}
+
+//! Smallest of __n > 0 integers
+template<typename _Tp>
+__PSTL_TARGET_KERNEL _Tp min_value(const _Tp* __p, std::size_t __n) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    _Tp __min = __p[0];
+    if (__n < __lanes) {
+        for (std::size_t __i = 1; __i < __n; ++__i)
+            __min = __p[__i] < __min ? __p[__i] : __min;
+        return __min;
+    }
+    typename vec<_Tp>::type __vmin = load(__p);
+    for (std::size_t __i = __lanes; __i + __lanes <= __n; __i += __lanes)
+        __vmin = select_min(__vmin, load(__p + __i));
+    __vmin = select_min(__vmin, load(__p + __n - __lanes));
+    for (std::size_t __j = 0; __j < __lanes; ++__j)
+        __min = __vmin[__j] < __min ? _Tp(__vmin[__j]) : __min;
+    return __min;
+}
+
+//! Largest of __n > 0 integers
+template<typename _Tp>
+__PSTL_TARGET_KERNEL _Tp max_value(const _Tp* __p, std::size_t __n) noexcept {
+    const std::size_t __lanes = vec<_Tp>::lanes;
+    _Tp __max = __p[0];
+    if (__n < __lanes) {
+        for (std::size_t __i = 1; __i < __n; ++__i)
+            __max = __max < __p[__i] ? __p[__i] : __max;
+        return __max;
+    }
+    typename vec<_Tp>::type __vmax = load(__p);
+    for (std::size_t __i = __lanes; __i + __lanes <= __n; __i += __lanes)
+        __vmax = select_max(__vmax, load(__p + __i));
+    __vmax = select_max(__vmax, load(__p + __n - __lanes));
+    for (std::size_t __j = 0; __j < __lanes; ++__j)
+        __max = __max < __vmax[__j] ? _Tp(__vmax[__j]) : __max;
+    return __max;
+}
+
+//! Copies __n bytes from __src to __dst, storing the part of __dst aligned to the vector width with streaming stores.
+/** The stores are fenced before returning, so that they are ordered before whatever publishes the copy to
+    other threads, e.g. the completion of the task. __dst may precede an overlapping __src. */
+__PSTL_TARGET_KERNEL inline void stream_copy(void* __dst, const void* __src, std::size_t __n) noexcept {
+    typedef vec<unsigned char>::type _Vp;
+    const std::size_t __w = __PSTL_DISPATCH_WIDTH;
+    unsigned char* __d = static_cast<unsigned char*>(__dst);
+    const unsigned char* __s = static_cast<const unsigned char*>(__src);
+    std::size_t __i = std::min(__n, std::size_t(-reinterpret_cast<std::uintptr_t>(__d) & (__w - 1)));
+    __builtin_memmove(__d, __s, __i);
+    for (; __i + __w <= __n; __i += __w)
+        stream_store(reinterpret_cast<_Vp*>(__d + __i), load(__s + __i));
+    __builtin_memmove(__d + __i, __s + __i, __n - __i);
+    _mm_sfence();
+}
+
+//! Stores __g(__i) to __p[__i] for each __i < __n as stream_copy stores; _Tp is as is_stream_fill requires
+template<typename _Tp, typename _Generator>
+__PSTL_TARGET_KERNEL void stream_generate(_Tp* __p, std::size_t __n, _Generator __g) noexcept {
+    typedef vec<unsigned char>::type _Vp;
+    const std::size_t __w = __PSTL_DISPATCH_WIDTH;
+    const std::size_t __lanes = __w / sizeof(_Tp);
+    std::size_t __i = 0;
+    for (; __i < __n && (reinterpret_cast<std::uintptr_t>(__p + __i) & (__w - 1)) != 0; ++__i)
+        __p[__i] = __g(__i);
+    for (; __i + __lanes <= __n; __i += __lanes) {
+        _Tp __values[__lanes];
+        for (std::size_t __j = 0; __j < __lanes; ++__j)
+            __values[__j] = __g(__i + __j);
+        _Vp __v;
+        __builtin_memcpy(&__v, __values, sizeof(__v));
+        stream_store(reinterpret_cast<_Vp*>(__p + __i), __v);
+    }
+    for (; __i < __n; ++__i)
+        __p[__i] = __g(__i);
+    _mm_sfence();
+}
@@ -0,0 +1,167 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_unseq_backend_reduce_H
+#define __PSTL_unseq_backend_reduce_H
+
+#include <cstddef>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#include "pstl_config.h"
+
+// This header defines the lane-blocked reduction engine used by the vectorized reductions
+// (reduce, transform_reduce, min_element, max_element, minmax_element) where the compiler has no
+// user-defined SIMD reductions. The elements are dealt round-robin to a fixed number of accumulators
+// (lanes) that are updated in lock step, so the updates within a block are independent and can be
+// vectorized or at least pipelined. The lanes are combined at the end, hence the reduction has to be
+// associative and commutative; positions kept in the accumulators make ties deterministic.
+namespace __pstl {
+namespace unseq_backend {
+
+// Bytes of accumulators a lane-blocked reduction keeps: one 512-bit vector or a few narrower ones
+#if defined(PSTL_LANE_BYTES)
+const std::size_t __PSTL_LANE_BYTES = PSTL_LANE_BYTES;
+#else
+const std::size_t __PSTL_LANE_BYTES = 64;
+#endif
+
+//! Number of lanes for accumulators of type _Tp
+template<typename _Tp>
+struct lane_count : std::integral_constant<std::size_t,
+    sizeof(_Tp) >= __PSTL_LANE_BYTES ? 1 : __PSTL_LANE_BYTES / sizeof(_Tp)> {};
+
+//! Element types cheap enough to be copied into the accumulators of min_element and minmax_element
+template<typename _Tp>
+struct is_lane_type : std::is_scalar<_Tp> {};
+
+//! Reduces the elements 0, ..., __n - 1 (__n > 0) with _Lanes accumulators of type _Acc.
+/** __init(__i) returns the accumulator of the single element __i, __step(__acc, __i) folds the element __i
+    into __acc, and __combine(__acc, __other) folds the accumulator __other into __acc. */
+template<std::size_t _Lanes, typename _Acc, typename _Size, typename _Init, typename _Step, typename _Combine>
+_Acc lane_reduce(_Size __n, _Init __init, _Step __step, _Combine __combine) {
+    if (_Lanes < 2 || __n < 2 * _Size(_Lanes)) {
+        _Acc __acc = __init(_Size(0));
+        for (_Size __i = 1; __i < __n; ++__i)
+            __step(__acc, __i);
+        return __acc;
+    }
+    alignas(alignof(_Acc) > 64 ? alignof(_Acc) : 64) char __lane_[_Lanes * sizeof(_Acc)];
+    _Acc* __lane = reinterpret_cast<_Acc*>(__lane_);
+
+    // initializer
+__PSTL_PRAGMA_SIMD
+    for (std::size_t __j = 0; __j < _Lanes; ++__j)
+        ::new (__lane + __j) _Acc(__init(_Size(__j)));
+    // main loop
+    const _Size __last = _Size(_Lanes) * (__n / _Size(_Lanes));
+    for (_Size __i = _Size(_Lanes); __i < __last; __i += _Size(_Lanes)) {
+__PSTL_PRAGMA_SIMD
+        for (std::size_t __j = 0; __j < _Lanes; ++__j)
+            __step(__lane[__j], __i + _Size(__j));
+    }
+    // remainder
+    for (_Size __j = 0; __last + __j < __n; ++__j)
+        __step(__lane[__j], __last + __j);
+    // combiner
+    for (std::size_t __j = 1; __j < _Lanes; ++__j)
+        __combine(__lane[0], __lane[__j]);
+    _Acc __result(std::move(__lane[0]));
+    // destroyer
+    for (std::size_t __j = 0; __j < _Lanes; ++__j)
+        __lane[__j].~_Acc();
+    return __result;
+}
+
+//! Accumulator of lane_min_element: the smallest value seen and its position
+template<typename _Tp, typename _Size>
+struct lane_min_acc {
+    _Tp __min_val;
+    _Size __min_idx;
+};
+
+//! Position of the first smallest of __first[0], ..., __first[__n - 1] (__n > 0)
+template<typename _RandomAccessIterator, typename _Size, typename _Compare>
+_Size lane_min_element(_RandomAccessIterator __first, _Size __n, _Compare __comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type _ValueType;
+    typedef lane_min_acc<_ValueType, _Size> _Acc;
+    return lane_reduce<lane_count<_ValueType>::value, _Acc>(__n,
+        [__first](_Size __i) { return _Acc{__first[__i], __i}; },
+        [__first, &__comp](_Acc& __acc, _Size __i) {
+            _ValueType __current = __first[__i];
+            if (__comp(__current, __acc.__min_val)) {
+                __acc.__min_val = __current;
+                __acc.__min_idx = __i;
+            }
+        },
+        [&__comp](_Acc& __acc, _Acc& __other) {
+            if (__comp(__other.__min_val, __acc.__min_val) ||
+                (!__comp(__acc.__min_val, __other.__min_val) && __other.__min_idx < __acc.__min_idx))
+                __acc = __other;
+        }).__min_idx;
+}
+
+//! Accumulator of lane_minmax_element: the smallest and the largest values seen and their positions
+template<typename _Tp, typename _Size>
+struct lane_minmax_acc {
+    _Tp __min_val;
+    _Tp __max_val;
+    _Size __min_idx;
+    _Size __max_idx;
+};
+
+//! Positions of the first smallest and of the last largest of __first[0], ..., __first[__n - 1] (__n > 0)
+template<typename _RandomAccessIterator, typename _Size, typename _Compare>
+std::pair<_Size, _Size> lane_minmax_element(_RandomAccessIterator __first, _Size __n, _Compare __comp) {
+    typedef typename std::iterator_traits<_RandomAccessIterator>::value_type _ValueType;
+    typedef lane_minmax_acc<_ValueType, _Size> _Acc;
+    const _Acc __result = lane_reduce<lane_count<_ValueType>::value, _Acc>(__n,
+        [__first](_Size __i) { return _Acc{__first[__i], __first[__i], __i, __i}; },
+        [__first, &__comp](_Acc& __acc, _Size __i) {
+            _ValueType __current = __first[__i];
+            if (__comp(__current, __acc.__min_val)) {
+                __acc.__min_val = __current;
+                __acc.__min_idx = __i;
+            }
+            if (!__comp(__current, __acc.__max_val)) {
+                __acc.__max_val = __current;
+                __acc.__max_idx = __i;
+            }
+        },
+        [&__comp](_Acc& __acc, _Acc& __other) {
+            if (__comp(__other.__min_val, __acc.__min_val) ||
+                (!__comp(__acc.__min_val, __other.__min_val) && __other.__min_idx < __acc.__min_idx)) {
+                __acc.__min_val = __other.__min_val;
+                __acc.__min_idx = __other.__min_idx;
+            }
+            if (__comp(__acc.__max_val, __other.__max_val) ||
+                (!__comp(__other.__max_val, __acc.__max_val) && __other.__max_idx > __acc.__max_idx)) {
+                __acc.__max_val = __other.__max_val;
+                __acc.__max_idx = __other.__max_idx;
+            }
+        });
+    return std::make_pair(__result.__min_idx, __result.__max_idx);
+}
+
+} // namespace unseq_backend
+} // namespace __pstl
+
+#endif /* __PSTL_unseq_backend_reduce_H */
@@ -22,10 +22,14 @@
 #define __PSTL_unseq_backend_simd_H
 
 #include <algorithm> //for std::min
+#include <cstring>
 #include <type_traits>
 
 #include "pstl_config.h"
 #include "utils.h"
+#include "unseq_backend_compress.h"
+#include "unseq_backend_dispatch.h"
+#include "unseq_backend_reduce.h"
 
 // This header defines the minimum set of vector routines required
 // to support parallel STL.
@@ -49,6 +53,36 @@ __PSTL_PRAGMA_SIMD
     return __first2 + __n;
 }
 
+template<class _Iterator1, class _DifferenceType, class _Iterator2, class _UnaryOperation>
+_Iterator2 simd_walk_2(_Iterator1 __first1, _DifferenceType __n, _Iterator2 __first2, internal::transform_functor<_UnaryOperation> __f,
+                       /*stream=*/std::false_type) noexcept {
+__PSTL_PRAGMA_SIMD
+    for(_DifferenceType __i = 0; __i < __n; ++__i)
+        __f(__first1[__i], __first2[__i]);
+    return __first2 + __n;
+}
+
+#if __PSTL_NONTEMPORAL_STORES_PRESENT
+template<class _Iterator1, class _DifferenceType, class _Iterator2, class _UnaryOperation>
+_Iterator2 simd_walk_2(_Iterator1 __first1, _DifferenceType __n, _Iterator2 __first2, internal::transform_functor<_UnaryOperation> __f,
+                       /*stream=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_Iterator2>::value_type _Tp;
+    if (__n == 0 || std::size_t(__n) * sizeof(_Tp) < nontemporal_threshold())
+        return unseq_backend::simd_walk_2(__first1, __n, __first2, __f, std::false_type());
+    dispatch_stream_generate(std::addressof(*__first2), std::size_t(__n), [__first1, &__f](std::size_t __i) {
+        _Tp __y;
+        __f(__first1[__i], __y);
+        return __y;
+    });
+    return __first2 + __n;
+}
+#endif
+
+template<class _Iterator1, class _DifferenceType, class _Iterator2, class _UnaryOperation>
+_Iterator2 simd_walk_2(_Iterator1 __first1, _DifferenceType __n, _Iterator2 __first2, internal::transform_functor<_UnaryOperation> __f) noexcept {
+    return unseq_backend::simd_walk_2(__first1, __n, __first2, __f, is_stream_fill<_Iterator2>());
+}
+
 template<class _Iterator1, class _DifferenceType, class _Iterator2, class _Iterator3, class _Function>
 _Iterator3 simd_walk_3(_Iterator1 __first1, _DifferenceType __n, _Iterator2 __first2, _Iterator3 __first3, _Function __f) noexcept {
 __PSTL_PRAGMA_SIMD
@@ -57,6 +91,34 @@ __PSTL_PRAGMA_SIMD
     return __first3 + __n;
 }
 
+// Bytes of elements a block of the emulated early-exit loops covers: a few vector registers
+const std::size_t __PSTL_SIMD_BLOCK_BYTES = 128;
+
+//! Largest number of elements per block of the emulated early-exit loops.
+/** The predicate values of a block are packed into a mask word, so that the first hit is the lowest set bit. */
+template<class _Index, std::size_t _Size = sizeof(typename std::iterator_traits<_Index>::value_type)>
+struct simd_block_size : std::integral_constant<std::ptrdiff_t,
+    _Size * internal::__PSTL_MASK_WORD_BITS <= __PSTL_SIMD_BLOCK_BYTES ? std::ptrdiff_t(internal::__PSTL_MASK_WORD_BITS) :
+    _Size * 8 >= __PSTL_SIMD_BLOCK_BYTES ? 8 : std::ptrdiff_t(__PSTL_SIMD_BLOCK_BYTES / _Size)> {};
+
+// Bytes of a vector register of the target
+#if __AVX512F__
+const std::size_t __PSTL_SIMD_VECTOR_BYTES = 64;
+#elif __AVX__
+const std::size_t __PSTL_SIMD_VECTOR_BYTES = 32;
+#else
+const std::size_t __PSTL_SIMD_VECTOR_BYTES = 16;
+#endif
+
+//! Number of elements of the first block of the emulated early-exit loops: the lanes of a vector register.
+/** The following blocks double up to simd_block_size, so that the elements evaluated beyond the first hit
+    are fewer than the lanes of a register or than the elements before the hit. */
+template<class _Index, std::size_t _Size = sizeof(typename std::iterator_traits<_Index>::value_type)>
+struct simd_first_block_size : std::integral_constant<std::ptrdiff_t,
+    _Size >= __PSTL_SIMD_VECTOR_BYTES ? 1 :
+    std::ptrdiff_t(__PSTL_SIMD_VECTOR_BYTES / _Size) < simd_block_size<_Index>::value ? std::ptrdiff_t(__PSTL_SIMD_VECTOR_BYTES / _Size) :
+    simd_block_size<_Index>::value> {};
+
 // TODO: check whether simd_first() can be used here
 template<class _Index, class _DifferenceType, class _Pred>
 bool simd_or(_Index __first, _DifferenceType __n, _Pred __pred) noexcept {
@@ -106,44 +168,27 @@ __PSTL_PRAGMA_SIMD_EARLYEXIT
     }
     return __first + __i;
 #else
-    // Experiments show good block sizes like this
-    const _DifferenceType __block_size = 8;
-    alignas(64) _DifferenceType __lane[__block_size] = { 0 };
-    while (__end - __begin >= __block_size) {
-        _DifferenceType __found = 0;
+    _DifferenceType __block_size = simd_first_block_size<_Index>::value;
+    while (__begin < __end) {
+        const _DifferenceType __len = std::min(__block_size, __end - __begin);
+        internal::mask_word __mask = 0;
 __PSTL_PRAGMA_VECTOR_UNALIGNED // Do not generate peel loop part
-__PSTL_PRAGMA_SIMD_REDUCTION(| :__found)
-        for (_DifferenceType __i = __begin; __i < __begin + __block_size; ++__i) {
-            const _DifferenceType __t = __comp(__first, __i);
-            __lane[__i - __begin] = __t;
-            __found |= __t;
+__PSTL_PRAGMA_SIMD_REDUCTION(|:__mask)
+        for (_DifferenceType __i = 0; __i < __len; ++__i)
+            __mask |= internal::mask_word(__comp(__first, __begin + __i) ? 1 : 0) << __i;
+        if (__mask) {
+            return __first + __begin + internal::mask_lowest(__mask);
         }
-        if (__found) {
-            _DifferenceType __i;
-            // This will vectorize
-            for (__i = 0; __i < __block_size; ++__i) {
-                if (__lane[__i]) {
-                    break;
-                }
-            }
-            return __first + __begin + __i;
-        }
-        __begin += __block_size;
-    }
-
-    //Keep remainder scalar
-    while (__begin != __end) {
-        if (__comp(__first, __begin)) {
-            return __first + __begin;
-        }
-        ++__begin;
+        __begin += __len;
+        // Double the block size. Any unnecessary iterations can be amortized against work done so far.
+        __block_size = std::min<_DifferenceType>(__block_size << 1, simd_block_size<_Index>::value);
     }
     return __first + __end;
 #endif //__PSTL_EARLYEXIT_PRESENT
 }
 
 template<class _Index1, class _DifferenceType, class _Index2, class _Pred>
-std::pair<_Index1, _Index2> simd_first(_Index1 __first1, _DifferenceType __n, _Index2 __first2, _Pred __pred) noexcept {
+std::pair<_Index1, _Index2> simd_first(_Index1 __first1, _DifferenceType __n, _Index2 __first2, _Pred __pred, /*dispatch=*/std::false_type) noexcept {
 #if __PSTL_EARLYEXIT_PRESENT
     _DifferenceType __i = 0;
 __PSTL_PRAGMA_VECTOR_UNALIGNED
@@ -155,42 +200,70 @@ __PSTL_PRAGMA_SIMD_EARLYEXIT
 #else
     const _Index1 __last1 = __first1 + __n;
     const _Index2 __last2 = __first2 + __n;
-    // Experiments show good block sizes like this
-    const _DifferenceType __block_size = 8;
-    alignas(64) _DifferenceType __lane[__block_size] = {0};
-    while ( __last1 - __first1 >= __block_size ) {
-        _DifferenceType __found = 0;
-        _DifferenceType __i;
+    _DifferenceType __block_size = simd_first_block_size<_Index1>::value;
+    while ( __last1 != __first1 ) {
+        const _DifferenceType __len = std::min<_DifferenceType>(__block_size, __last1 - __first1);
+        internal::mask_word __mask = 0;
 __PSTL_PRAGMA_VECTOR_UNALIGNED // Do not generate peel loop part
-__PSTL_PRAGMA_SIMD_REDUCTION(|:__found)
-        for ( __i = 0; __i < __block_size; ++__i ) {
-            const _DifferenceType __t = __pred(__first1[__i], __first2[__i]);
-            __lane[__i] = __t;
-            __found |= __t;
-        }
-        if ( __found ) {
-            _DifferenceType __i;
-            // This will vectorize
-            for ( __i = 0; __i < __block_size; ++__i ) {
-                if ( __lane[__i] ) break;
-            }
+__PSTL_PRAGMA_SIMD_REDUCTION(|:__mask)
+        for (_DifferenceType __i = 0; __i < __len; ++__i)
+            __mask |= internal::mask_word(__pred(__first1[__i], __first2[__i]) ? 1 : 0) << __i;
+        if ( __mask ) {
+            const _DifferenceType __i = internal::mask_lowest(__mask);
             return std::make_pair(__first1 + __i, __first2 + __i);
         }
-        __first1 += __block_size;
-        __first2 += __block_size;
+        __first1 += __len;
+        __first2 += __len;
+        // Double the block size. Any unnecessary iterations can be amortized against work done so far.
+        __block_size = std::min<_DifferenceType>(__block_size << 1, simd_block_size<_Index1>::value);
     }
-
-    //Keep remainder scalar
-    for(; __last1 != __first1; ++__first1, ++__first2)
-        if ( __pred(*(__first1), *(__first2)) )
-            return std::make_pair(__first1, __first2);
-
     return std::make_pair(__last1, __last2);
 #endif //__PSTL_EARLYEXIT_PRESENT
 }
 
+#if __PSTL_SIMD_DISPATCH_PRESENT
+template<class _Index1, class _DifferenceType, class _Index2, class _Pred>
+std::pair<_Index1, _Index2> simd_first(_Index1 __first1, _DifferenceType __n, _Index2 __first2, _Pred, /*dispatch=*/std::true_type) noexcept {
+    if (__n == 0)
+        return std::make_pair(__first1, __first2);
+    const std::size_t __i = dispatch_mismatch_equal(std::addressof(*__first1), std::addressof(*__first2), std::size_t(__n));
+    return std::make_pair(__first1 + __i, __first2 + __i);
+}
+#endif
+
+template<class _Index1, class _DifferenceType, class _Index2, class _Pred>
+std::pair<_Index1, _Index2> simd_first(_Index1 __first1, _DifferenceType __n, _Index2 __first2, _Pred __pred) noexcept {
+    return unseq_backend::simd_first(__first1, __n, __first2, __pred, is_dispatch_not_equal<_Index1, _Index2, _Pred>());
+}
+
 template<class _Index, class _DifferenceType, class _Pred>
-_DifferenceType simd_count(_Index __index, _DifferenceType __n, _Pred __pred) noexcept {
+_Index simd_find_if(_Index __first, _DifferenceType __n, _Pred __pred, /*dispatch=*/std::false_type) noexcept {
+    return unseq_backend::simd_first(__first, _DifferenceType(0), __n,
+        [&__pred](_Index __it, _DifferenceType __i) { return __pred(__it[__i]); });
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+template<class _Index, class _DifferenceType, class _Tp>
+_Index simd_find_if(_Index __first, _DifferenceType __n, internal::equal_value<_Tp> __pred, /*dispatch=*/std::true_type) noexcept {
+    typename std::iterator_traits<_Index>::value_type __value;
+    if (__n == 0 || !dispatch_value(__pred.value(), __value))
+        return __first + __n;
+    return __first + dispatch_find_equal(std::addressof(*__first), std::size_t(__n), __value);
+}
+#endif
+
+template<class _Index, class _DifferenceType, class _Pred>
+_Index simd_find_if(_Index __first, _DifferenceType __n, _Pred __pred) noexcept {
+    return unseq_backend::simd_find_if(__first, __n, __pred, std::false_type());
+}
+
+template<class _Index, class _DifferenceType, class _Tp>
+_Index simd_find_if(_Index __first, _DifferenceType __n, internal::equal_value<_Tp> __pred) noexcept {
+    return unseq_backend::simd_find_if(__first, __n, __pred, is_dispatch_equal_value<_Index, _Tp>());
+}
+
+template<class _Index, class _DifferenceType, class _Pred>
+_DifferenceType simd_count(_Index __index, _DifferenceType __n, _Pred __pred, /*dispatch=*/std::false_type) noexcept {
     _DifferenceType __count = 0;
 __PSTL_PRAGMA_SIMD_REDUCTION(+:__count)
     for (_DifferenceType __i = 0; __i < __n; ++__i)
@@ -200,9 +273,87 @@ __PSTL_PRAGMA_SIMD_REDUCTION(+:__count)
     return __count;
 }
 
+#if __PSTL_SIMD_DISPATCH_PRESENT
+template<class _Index, class _DifferenceType, class _Tp>
+_DifferenceType simd_count(_Index __index, _DifferenceType __n, internal::equal_value<_Tp> __pred, /*dispatch=*/std::true_type) noexcept {
+    typename std::iterator_traits<_Index>::value_type __value;
+    if (__n == 0 || !dispatch_value(__pred.value(), __value))
+        return 0;
+    return dispatch_count_equal(std::addressof(*__index), std::size_t(__n), __value);
+}
+#endif
+
+template<class _Index, class _DifferenceType, class _Pred>
+_DifferenceType simd_count(_Index __index, _DifferenceType __n, _Pred __pred) noexcept {
+    return unseq_backend::simd_count(__index, __n, __pred, std::false_type());
+}
+
+template<class _Index, class _DifferenceType, class _Tp>
+_DifferenceType simd_count(_Index __index, _DifferenceType __n, internal::equal_value<_Tp> __pred) noexcept {
+    return unseq_backend::simd_count(__index, __n, __pred, is_dispatch_equal_value<_Index, _Tp>());
+}
+
+//------------------------------------------------------------------------
+// stream compaction
+//
+// Elements are processed in groups of __PSTL_MASK_WORD_BITS: the predicate values of a group are packed into a
+// mask word, which is then handed to the compress engine when the iterators are compressible.
+//------------------------------------------------------------------------
+
+template<class _InputIterator, class _DifferenceType, class _UnaryPredicate>
+internal::mask_word simd_calc_word_1(_InputIterator __first, _DifferenceType __len, _UnaryPredicate __pred) noexcept {
+    internal::mask_word __word = 0;
+__PSTL_PRAGMA_SIMD_REDUCTION(|:__word)
+    for (_DifferenceType __j = 0; __j < __len; ++__j)
+        __word |= internal::mask_word(bool(__pred(__first[__j]))) << __j;
+    return __word;
+}
+
+template<class _InputIterator, class _DifferenceType, class _BinaryPredicate>
+internal::mask_word simd_calc_word_2(_InputIterator __first, _DifferenceType __len, _BinaryPredicate __pred) noexcept {
+    internal::mask_word __word = 0;
+__PSTL_PRAGMA_SIMD_REDUCTION(|:__word)
+    for (_DifferenceType __j = 0; __j < __len; ++__j)
+        __word |= internal::mask_word(!__pred(__first[__j], __first[__j - 1])) << __j;
+    return __word;
+}
+
+//! Compacts [__src, __src + __n) into __result with the mask word __word_of(__k, __len) for every group
+template<class _Tp, class _DifferenceType, class _OutputIterator, class _WordFunction>
+_DifferenceType compress_groups(const _Tp* __src, _DifferenceType __n, _OutputIterator __result, _WordFunction __word_of) noexcept {
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
+    _Tp* __dst = nullptr; // __result is dereferenced only when something is stored, it may be the end of a sequence
+    _DifferenceType __cnt = 0;
+    for (_DifferenceType __k = 0; __k < __n; __k += __word_bits) {
+        const _DifferenceType __len = std::min(__n - __k, __word_bits);
+        const internal::mask_word __word = __word_of(__k, __len);
+        if (__word) {
+            if (!__dst)
+                __dst = std::addressof(*__result);
+            __cnt += compress_word(__src + __k, __len, __word, __dst + __cnt);
+        }
+    }
+    return __cnt;
+}
+
 template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _BinaryPredicate>
 _OutputIterator simd_unique_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result,
-                                 _BinaryPredicate __pred) noexcept {
+                                 _BinaryPredicate __pred, /*compressible=*/std::true_type) noexcept {
+    if (__n == 0)
+        return __result;
+    const auto* __src = std::addressof(*__first);
+    return __result + compress_groups(__src, __n, __result, [__src, __pred](_DifferenceType __k, _DifferenceType __len) {
+        if (__k > 0)
+            return simd_calc_word_2(__src + __k, __len, __pred);
+        // The first element is always copied
+        return (simd_calc_word_2(__src + 1, __len - 1, __pred) << 1) | 1;
+    });
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _BinaryPredicate>
+_OutputIterator simd_unique_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result,
+                                 _BinaryPredicate __pred, /*compressible=*/std::false_type) noexcept {
+#if (__PSTL_MONOTONIC_PRESENT)
     if (__n == 0)
         return __result;
 
@@ -218,6 +369,15 @@ __PSTL_PRAGMA_SIMD_ORDERED_MONOTONIC(__cnt:1)
         }
     }
     return __result + __cnt;
+#else
+    return std::unique_copy(__first, __first + __n, __result, __pred);
+#endif
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _BinaryPredicate>
+_OutputIterator simd_unique_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result,
+                                 _BinaryPredicate __pred) noexcept {
+    return unseq_backend::simd_unique_copy(__first, __n, __result, __pred, is_compressible<_InputIterator, _OutputIterator>());
 }
 
 template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _Assigner>
@@ -229,8 +389,124 @@ __PSTL_PRAGMA_SIMD
     return __result + __n;
 }
 
+//! Copies [__first, __first + __n) to __result with streaming stores if the destination is large enough.
+/** Returns whether it did; simd_copy_bytes falls back to memmove otherwise. */
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+bool simd_stream_copy(_InputIterator, _DifferenceType, _OutputIterator, /*stream=*/std::false_type) noexcept {
+    return false;
+}
+
+#if __PSTL_NONTEMPORAL_STORES_PRESENT
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+bool simd_stream_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, /*stream=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_OutputIterator>::value_type _Tp;
+    if (__n == 0 || std::size_t(__n) * sizeof(_Tp) < nontemporal_threshold())
+        return false;
+    dispatch_stream_copy(std::addressof(*__result), std::addressof(*__first), std::size_t(__n) * sizeof(_Tp));
+    return true;
+}
+#endif
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+bool simd_stream_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result) noexcept {
+    return unseq_backend::simd_stream_copy(__first, __n, __result, is_stream_copy<_InputIterator, _OutputIterator>());
+}
+
+//! Copies [__first, __first + __n) to __result as bytes by one memmove, so __result may precede an overlapping source
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+_OutputIterator simd_copy_bytes(_InputIterator __first, _DifferenceType __n, _OutputIterator __result) noexcept {
+    typedef typename std::iterator_traits<_OutputIterator>::value_type _Tp;
+    if (__n > 0 && !unseq_backend::simd_stream_copy(__first, __n, __result))
+        std::memmove(std::addressof(*__result), std::addressof(*__first), std::size_t(__n) * sizeof(_Tp));
+    return __result + __n;
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+_OutputIterator simd_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, /*bytewise=*/std::false_type) noexcept {
+    return unseq_backend::simd_assign(__first, __n, __result,
+        [](_InputIterator __x, _OutputIterator __y) {
+            *__y = *__x;
+    });
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+_OutputIterator simd_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, /*bytewise=*/std::true_type) noexcept {
+    return unseq_backend::simd_copy_bytes(__first, __n, __result);
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+_OutputIterator simd_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator __result) noexcept {
+    return unseq_backend::simd_copy(__first, __n, __result, is_bytewise_copy<_InputIterator, _OutputIterator>());
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+_OutputIterator simd_move(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, /*bytewise=*/std::false_type) noexcept {
+    return unseq_backend::simd_assign(__first, __n, __result,
+        [](_InputIterator __x, _OutputIterator __y) {
+            *__y = std::move(*__x);
+    });
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+_OutputIterator simd_move(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, /*bytewise=*/std::true_type) noexcept {
+    return unseq_backend::simd_copy_bytes(__first, __n, __result);
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+_OutputIterator simd_move(_InputIterator __first, _DifferenceType __n, _OutputIterator __result) noexcept {
+    return unseq_backend::simd_move(__first, __n, __result, is_bytewise_copy<_InputIterator, _OutputIterator>());
+}
+
+template<class _Iterator1, class _DifferenceType, class _Iterator2>
+_Iterator2 simd_swap_ranges(_Iterator1 __first, _DifferenceType __n, _Iterator2 __result, /*bytewise=*/std::false_type) noexcept {
+    return unseq_backend::simd_assign(__first, __n, __result, std::iter_swap<_Iterator1, _Iterator2>);
+}
+
+// The ranges are exchanged block by block; the two blocks of a constant size are kept in vector registers.
+template<class _Iterator1, class _DifferenceType, class _Iterator2>
+_Iterator2 simd_swap_ranges(_Iterator1 __first, _DifferenceType __n, _Iterator2 __result, /*bytewise=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_Iterator1>::value_type _Tp;
+    const std::size_t __block = 64;
+    if (__n == 0)
+        return __result;
+    unsigned char* __a = reinterpret_cast<unsigned char*>(std::addressof(*__first));
+    unsigned char* __b = reinterpret_cast<unsigned char*>(std::addressof(*__result));
+    const std::size_t __size = std::size_t(__n) * sizeof(_Tp);
+    unsigned char __x[__block], __y[__block];
+    std::size_t __i = 0;
+    for (; __i + __block <= __size; __i += __block) {
+        std::memcpy(__x, __a + __i, __block);
+        std::memcpy(__y, __b + __i, __block);
+        std::memcpy(__a + __i, __y, __block);
+        std::memcpy(__b + __i, __x, __block);
+    }
+    std::memcpy(__x, __a + __i, __size - __i);
+    std::memcpy(__y, __b + __i, __size - __i);
+    std::memcpy(__a + __i, __y, __size - __i);
+    std::memcpy(__b + __i, __x, __size - __i);
+    return __result + __n;
+}
+
+template<class _Iterator1, class _DifferenceType, class _Iterator2>
+_Iterator2 simd_swap_ranges(_Iterator1 __first, _DifferenceType __n, _Iterator2 __result) noexcept {
+    return unseq_backend::simd_swap_ranges(__first, __n, __result, is_bytewise_swap<_Iterator1, _Iterator2>());
+}
+
 template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _UnaryPredicate>
-_OutputIterator simd_copy_if(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, _UnaryPredicate __pred) noexcept {
+_OutputIterator simd_copy_if(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, _UnaryPredicate __pred,
+                             /*compressible=*/std::true_type) noexcept {
+    if (__n == 0)
+        return __result;
+    const auto* __src = std::addressof(*__first);
+    return __result + compress_groups(__src, __n, __result, [__src, __pred](_DifferenceType __k, _DifferenceType __len) {
+        return simd_calc_word_1(__src + __k, __len, __pred);
+    });
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _UnaryPredicate>
+_OutputIterator simd_copy_if(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, _UnaryPredicate __pred,
+                             /*compressible=*/std::false_type) noexcept {
+#if (__PSTL_MONOTONIC_PRESENT)
     _DifferenceType __cnt = 0;
 
 __PSTL_PRAGMA_SIMD
@@ -242,55 +518,155 @@ __PSTL_PRAGMA_SIMD
             }
     }
     return __result + __cnt;
+#else
+    return std::copy_if(__first, __first + __n, __result, __pred);
+#endif
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _UnaryPredicate>
+_OutputIterator simd_copy_if(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, _UnaryPredicate __pred) noexcept {
+    return unseq_backend::simd_copy_if(__first, __n, __result, __pred, is_compressible<_InputIterator, _OutputIterator>());
 }
 
 template<class _InputIterator, class _DifferenceType, class _BinaryPredicate>
-_DifferenceType simd_calc_mask_2(_InputIterator __first, _DifferenceType __n, bool* __mask, _BinaryPredicate __pred) noexcept {
+_DifferenceType simd_calc_mask_2(_InputIterator __first, _DifferenceType __n, internal::mask_word* __mask, _BinaryPredicate __pred) noexcept {
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
     _DifferenceType __count = 0;
-
-__PSTL_PRAGMA_SIMD_REDUCTION(+:__count)
-    for (_DifferenceType __i = 0; __i < __n; ++__i) {
-        __mask[__i] = !__pred(__first[__i], __first[__i - 1]);
-        __count += __mask[__i];
+    for (_DifferenceType __k = 0; __k < __n; __k += __word_bits, ++__mask) {
+        *__mask = simd_calc_word_2(__first + __k, std::min(__n - __k, __word_bits), __pred);
+        __count += internal::mask_popcount(*__mask);
     }
     return __count;
 }
 
 template<class _InputIterator, class _DifferenceType, class _UnaryPredicate>
-_DifferenceType simd_calc_mask_1(_InputIterator __first, _DifferenceType __n, bool* __mask, _UnaryPredicate __pred) noexcept {
+_DifferenceType simd_calc_mask_1(_InputIterator __first, _DifferenceType __n, internal::mask_word* __mask, _UnaryPredicate __pred) noexcept {
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
     _DifferenceType __count = 0;
-
-__PSTL_PRAGMA_SIMD_REDUCTION(+:__count)
-    for (_DifferenceType __i = 0; __i < __n; ++__i) {
-        __mask[__i] = __pred(__first[__i]);
-        __count += __mask[__i];
+    for (_DifferenceType __k = 0; __k < __n; __k += __word_bits, ++__mask) {
+        *__mask = simd_calc_word_1(__first + __k, std::min(__n - __k, __word_bits), __pred);
+        __count += internal::mask_popcount(*__mask);
     }
     return __count;
 }
 
+// Only the set bits of every mask word are visited, so sparse masks skip most of the input.
 template<class _InputIterator, class _DifferenceType, class _OutputIterator, class _Assigner>
-void simd_copy_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, bool* __mask, _Assigner __assigner) noexcept {
+void simd_copy_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, const internal::mask_word* __mask, _Assigner __assigner) noexcept {
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
     _DifferenceType __cnt = 0;
-__PSTL_PRAGMA_SIMD
-    for (_DifferenceType __i = 0; __i < __n; ++__i) {
-        if (__mask[__i]) {
-__PSTL_PRAGMA_SIMD_ORDERED_MONOTONIC(__cnt:1)
-            {
-                __assigner(__first + __i, __result + __cnt);
-                ++__cnt;
-            }
+    for (_DifferenceType __k = 0; __k < __n; __k += __word_bits, ++__mask) {
+        for (internal::mask_word __word = *__mask; __word; __word &= __word - 1) {
+            __assigner(__first + (__k + _DifferenceType(internal::mask_lowest(__word))), __result + __cnt);
+            ++__cnt;
         }
     }
 }
 
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+void simd_copy_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, const internal::mask_word* __mask,
+                       internal::copy_assigner __assigner, /*compressible=*/std::true_type) noexcept {
+    if (__n == 0)
+        return;
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
+    compress_groups(std::addressof(*__first), __n, __result, [__mask, __word_bits](_DifferenceType __k, _DifferenceType) {
+        return __mask[__k / __word_bits];
+    });
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+void simd_copy_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, const internal::mask_word* __mask,
+                       internal::copy_assigner __assigner, /*compressible=*/std::false_type) noexcept {
+    unseq_backend::simd_copy_by_mask<_InputIterator, _DifferenceType, _OutputIterator, internal::copy_assigner>(__first, __n, __result, __mask, __assigner);
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator>
+void simd_copy_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator __result, const internal::mask_word* __mask, internal::copy_assigner __assigner) noexcept {
+    unseq_backend::simd_copy_by_mask(__first, __n, __result, __mask, __assigner, is_compressible<_InputIterator, _OutputIterator>());
+}
+
 template<class _InputIterator, class _DifferenceType, class _OutputIterator1, class _OutputIterator2>
 void simd_partition_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator1 __out_true, _OutputIterator2 __out_false,
-                            bool* __mask) noexcept {
+                            const internal::mask_word* __mask, /*compressible=*/std::true_type) noexcept {
+    if (__n == 0)
+        return;
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
+    const auto* __src = std::addressof(*__first);
+    compress_groups(__src, __n, __out_true, [__mask, __word_bits](_DifferenceType __k, _DifferenceType) {
+        return __mask[__k / __word_bits];
+    });
+    compress_groups(__src, __n, __out_false, [__mask, __word_bits](_DifferenceType __k, _DifferenceType __len) {
+        return ~__mask[__k / __word_bits] & (__len == __word_bits ? ~internal::mask_word(0) : (internal::mask_word(1) << __len) - 1);
+    });
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator1, class _OutputIterator2>
+void simd_partition_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator1 __out_true, _OutputIterator2 __out_false,
+                            const internal::mask_word* __mask, /*compressible=*/std::false_type) noexcept {
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
     _DifferenceType __cnt_true = 0, __cnt_false = 0;
+    for (_DifferenceType __k = 0; __k < __n; __k += __word_bits, ++__mask) {
+        const _DifferenceType __len = std::min(__n - __k, __word_bits);
+        const internal::mask_word __valid = __len == __word_bits ? ~internal::mask_word(0) : (internal::mask_word(1) << __len) - 1;
+        for (internal::mask_word __word = *__mask; __word; __word &= __word - 1) {
+            __out_true[__cnt_true] = __first[__k + _DifferenceType(internal::mask_lowest(__word))];
+            ++__cnt_true;
+        }
+        for (internal::mask_word __word = ~*__mask & __valid; __word; __word &= __word - 1) {
+            __out_false[__cnt_false] = __first[__k + _DifferenceType(internal::mask_lowest(__word))];
+            ++__cnt_false;
+        }
+    }
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator1, class _OutputIterator2>
+void simd_partition_by_mask(_InputIterator __first, _DifferenceType __n, _OutputIterator1 __out_true, _OutputIterator2 __out_false,
+                            const internal::mask_word* __mask) noexcept {
+    unseq_backend::simd_partition_by_mask(__first, __n, __out_true, __out_false, __mask,
+        std::integral_constant<bool, is_compressible<_InputIterator, _OutputIterator1>::value && is_compressible<_InputIterator, _OutputIterator2>::value>());
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator1, class _OutputIterator2, class _UnaryPredicate>
+std::pair<_OutputIterator1, _OutputIterator2>
+simd_partition_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator1 __out_true, _OutputIterator2 __out_false, _UnaryPredicate __pred,
+                    /*compressible=*/std::true_type) noexcept {
+    if (__n == 0)
+        return std::make_pair(__out_true, __out_false);
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
+    const auto* __src = std::addressof(*__first);
+    typedef typename std::iterator_traits<_InputIterator>::value_type _Tp;
+    _Tp* __dst_true = nullptr;
+    _Tp* __dst_false = nullptr;
+    _DifferenceType __cnt_true = 0, __cnt_false = 0;
+    for (_DifferenceType __k = 0; __k < __n; __k += __word_bits) {
+        const _DifferenceType __len = std::min(__n - __k, __word_bits);
+        const internal::mask_word __word = simd_calc_word_1(__src + __k, __len, __pred);
+        const internal::mask_word __valid = __len == __word_bits ? ~internal::mask_word(0) : (internal::mask_word(1) << __len) - 1;
+        if (__word) {
+            if (!__dst_true)
+                __dst_true = std::addressof(*__out_true);
+            __cnt_true += compress_word(__src + __k, __len, __word, __dst_true + __cnt_true);
+        }
+        if (~__word & __valid) {
+            if (!__dst_false)
+                __dst_false = std::addressof(*__out_false);
+            __cnt_false += compress_word(__src + __k, __len, ~__word & __valid, __dst_false + __cnt_false);
+        }
+    }
+    return std::make_pair(__out_true + __cnt_true, __out_false + __cnt_false);
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator1, class _OutputIterator2, class _UnaryPredicate>
+std::pair<_OutputIterator1, _OutputIterator2>
+simd_partition_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator1 __out_true, _OutputIterator2 __out_false, _UnaryPredicate __pred,
+                    /*compressible=*/std::false_type) noexcept {
+#if (__PSTL_MONOTONIC_PRESENT)
+    _DifferenceType __cnt_true = 0, __cnt_false = 0;
+
 __PSTL_PRAGMA_SIMD
     for (_DifferenceType __i = 0; __i < __n; ++__i) {
-__PSTL_PRAGMA_SIMD_ORDERED_MONOTONIC_2ARGS(__cnt_true:1, __cnt_false:1)
-        if (__mask[__i]) {
+__PSTL_PRAGMA_SIMD_ORDERED_MONOTONIC_2ARGS(__cnt_true:1, __cnt_false : 1)
+        if (__pred(__first[__i])) {
             __out_true[__cnt_true] = __first[__i];
             ++__cnt_true;
         }
@@ -299,10 +675,148 @@ __PSTL_PRAGMA_SIMD_ORDERED_MONOTONIC_2ARGS(__cnt_true:1, __cnt_false:1)
             ++__cnt_false;
         }
     }
+    return std::make_pair(__out_true + __cnt_true, __out_false + __cnt_false);
+#else
+    return std::partition_copy(__first, __first + __n, __out_true, __out_false, __pred);
+#endif
+}
+
+template<class _InputIterator, class _DifferenceType, class _OutputIterator1, class _OutputIterator2, class _UnaryPredicate>
+std::pair<_OutputIterator1, _OutputIterator2>
+simd_partition_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator1 __out_true, _OutputIterator2 __out_false, _UnaryPredicate __pred) noexcept {
+    return unseq_backend::simd_partition_copy(__first, __n, __out_true, __out_false, __pred,
+        std::integral_constant<bool, is_compressible<_InputIterator, _OutputIterator1>::value && is_compressible<_InputIterator, _OutputIterator2>::value>());
+}
+
+//! In-place unique: every group is compacted right after its mask word is computed.
+template<class _Iterator, class _DifferenceType, class _BinaryPredicate>
+_Iterator simd_unique(_Iterator __first, _DifferenceType __n, _BinaryPredicate __pred, /*compressible=*/std::true_type) noexcept {
+    if (__n == 0)
+        return __first;
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
+    auto* __p = std::addressof(*__first);
+    // Last element of the previous group, saved before the group is overwritten by the compaction
+    auto __prev = __p[0];
+    _DifferenceType __cnt = 1;
+    for (_DifferenceType __k = 1; __k < __n; __k += __word_bits) {
+        const _DifferenceType __len = std::min(__n - __k, __word_bits);
+        const internal::mask_word __word = internal::mask_word(!__pred(__p[__k], __prev)) |
+                                           (simd_calc_word_2(__p + __k + 1, __len - 1, __pred) << 1);
+        __prev = __p[__k + __len - 1];
+        __cnt += compress_word(__p + __k, __len, __word, __p + __cnt);
+    }
+    return __first + __cnt;
+}
+
+template<class _Iterator, class _DifferenceType, class _BinaryPredicate>
+_Iterator simd_unique(_Iterator __first, _DifferenceType __n, _BinaryPredicate __pred, /*compressible=*/std::false_type) noexcept {
+    return std::unique(__first, __first + __n, __pred);
+}
+
+template<class _Iterator, class _DifferenceType, class _BinaryPredicate>
+_Iterator simd_unique(_Iterator __first, _DifferenceType __n, _BinaryPredicate __pred) noexcept {
+    return unseq_backend::simd_unique(__first, __n, __pred, is_compressible<_Iterator, _Iterator>());
+}
+
+//! In-place partition.
+/** The first and the last groups are saved aside. Then groups are read from the side with less free space,
+    their true elements are compacted to the left end and the false ones to the right end of the free space.
+    Finally the middle remainder and the saved groups fill the rest. */
+template<class _Iterator, class _DifferenceType, class _UnaryPredicate>
+_Iterator simd_partition(_Iterator __first, _DifferenceType __n, _UnaryPredicate __pred, /*compressible=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_Iterator>::value_type _Tp;
+    const _DifferenceType __word_bits = internal::__PSTL_MASK_WORD_BITS;
+    if (__n == 0)
+        return __first;
+    _Tp* __p = std::addressof(*__first);
+    _DifferenceType __write_left = 0, __write_right = __n;
+    auto __flush = [__p, __pred, __word_bits, &__write_left, &__write_right](const _Tp* __src, _DifferenceType __len) {
+        const internal::mask_word __word = simd_calc_word_1(__src, __len, __pred);
+        const internal::mask_word __valid = __len == __word_bits ? ~internal::mask_word(0) : (internal::mask_word(1) << __len) - 1;
+        __write_left += compress_word(__src, __len, __word, __p + __write_left);
+        __write_right -= __len - _DifferenceType(internal::mask_popcount(__word));
+        compress_word(__src, __len, ~__word & __valid, __p + __write_right);
+    };
+
+    _Tp __saved[2 * internal::__PSTL_MASK_WORD_BITS];
+    _Tp __group[internal::__PSTL_MASK_WORD_BITS];
+    const _DifferenceType __n_saved = std::min(__n, 2 * __word_bits);
+    std::copy(__p, __p + __n_saved / 2, __saved);
+    std::copy(__p + (__n - (__n_saved - __n_saved / 2)), __p + __n, __saved + __n_saved / 2);
+    _DifferenceType __read_left = __n_saved / 2, __read_right = __n - (__n_saved - __n_saved / 2);
+
+    while (__read_right - __read_left >= __word_bits) {
+        if (__read_left - __write_left <= __write_right - __read_right) {
+            std::copy(__p + __read_left, __p + __read_left + __word_bits, __group);
+            __read_left += __word_bits;
+        }
+        else {
+            __read_right -= __word_bits;
+            std::copy(__p + __read_right, __p + __read_right + __word_bits, __group);
+        }
+        __flush(__group, __word_bits);
+    }
+    const _DifferenceType __rest = __read_right - __read_left;
+    std::copy(__p + __read_left, __p + __read_right, __group);
+    __flush(__group, __rest);
+    for (_DifferenceType __k = 0; __k < __n_saved; __k += __word_bits)
+        __flush(__saved + __k, std::min(__n_saved - __k, __word_bits));
+    return __first + __write_left;
+}
+
+template<class _Iterator, class _DifferenceType, class _UnaryPredicate>
+_Iterator simd_partition(_Iterator __first, _DifferenceType __n, _UnaryPredicate __pred, /*compressible=*/std::false_type) noexcept {
+    return std::partition(__first, __first + __n, __pred);
+}
+
+template<class _Iterator, class _DifferenceType, class _UnaryPredicate>
+_Iterator simd_partition(_Iterator __first, _DifferenceType __n, _UnaryPredicate __pred) noexcept {
+    return unseq_backend::simd_partition(__first, __n, __pred, is_compressible<_Iterator, _Iterator>());
+}
+
+//! Stores __value to [__first, __first + __n) with streaming stores if the destination is large enough; returns whether it did
+template<class _Index, class _DifferenceType, class _Tp>
+bool simd_stream_fill(_Index, _DifferenceType, const _Tp&, /*stream=*/std::false_type) noexcept {
+    return false;
+}
+
+#if __PSTL_NONTEMPORAL_STORES_PRESENT
+template<class _Index, class _DifferenceType, class _Tp>
+bool simd_stream_fill(_Index __first, _DifferenceType __n, const _Tp& __value, /*stream=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_Index>::value_type _Up;
+    if (__n == 0 || std::size_t(__n) * sizeof(_Up) < nontemporal_threshold())
+        return false;
+    const _Up __v = __value;
+    dispatch_stream_generate(std::addressof(*__first), std::size_t(__n), [__v](std::size_t) { return __v; });
+    return true;
+}
+#endif
+
+//! Stores __value to [__first, __first + __n) by one memset if all its bytes are equal; returns whether it did
+template<class _Index, class _DifferenceType, class _Tp>
+bool simd_fill_bytes(_Index, _DifferenceType, const _Tp&, /*bytewise=*/std::false_type) noexcept {
+    return false;
+}
+
+template<class _Index, class _DifferenceType, class _Tp>
+bool simd_fill_bytes(_Index __first, _DifferenceType __n, const _Tp& __value, /*bytewise=*/std::true_type) noexcept {
+    typedef typename std::iterator_traits<_Index>::value_type _Up;
+    const _Up __v = __value;
+    unsigned char __bytes[sizeof(_Up)];
+    std::memcpy(__bytes, &__v, sizeof(_Up));
+    for (std::size_t __j = 1; __j < sizeof(_Up); ++__j)
+        if (__bytes[__j] != __bytes[0])
+            return false;
+    if (__n > 0)
+        std::memset(std::addressof(*__first), __bytes[0], std::size_t(__n) * sizeof(_Up));
+    return true;
 }
 
 template<class _Index, class _DifferenceType, class _Tp>
 _Index simd_fill_n(_Index __first, _DifferenceType __n, const _Tp& __value) noexcept {
+    if (unseq_backend::simd_stream_fill(__first, __n, __value, is_stream_fill<_Index>()) ||
+        unseq_backend::simd_fill_bytes(__first, __n, __value, is_bytewise_fill<_Index>()))
+        return __first + __n;
 __PSTL_USE_NONTEMPORAL_STORES_IF_ALLOWED
 __PSTL_PRAGMA_SIMD
     for (_DifferenceType __i = 0; __i < __n; ++__i)
@@ -320,7 +834,7 @@ __PSTL_PRAGMA_SIMD
 }
 
 template<class _Index, class _BinaryPredicate>
-_Index simd_adjacent_find(_Index __first, _Index __last, _BinaryPredicate __pred, bool __or_semantic) noexcept {
+_Index simd_adjacent_find(_Index __first, _Index __last, _BinaryPredicate __pred, bool __or_semantic, /*dispatch=*/std::false_type) noexcept {
     if(__last - __first < 2)
         return __last;
 
@@ -338,45 +852,43 @@ __PSTL_PRAGMA_SIMD_EARLYEXIT
 
     return __i < __n ? __first + __i : __last;
 #else
-    // Experiments show good block sizes like this
-    //TODO: to consider tuning block_size for various data types
-    const _DifferenceType __block_size = 8;
-    alignas(64) _DifferenceType __lane[__block_size] = {0};
-    while ( __last - __first >= __block_size ) {
-        _DifferenceType __found = 0;
+    _DifferenceType __block_size = simd_first_block_size<_Index>::value;
+    // A block also compares its last element with the first one of the next block
+    while ( __last - __first > 1 ) {
+        const _DifferenceType __len = std::min<_DifferenceType>(__block_size, __last - __first - 1);
+        internal::mask_word __mask = 0;
 __PSTL_PRAGMA_VECTOR_UNALIGNED // Do not generate peel loop part
-__PSTL_PRAGMA_SIMD_REDUCTION(|:__found)
-        for ( __i = 0; __i < __block_size-1; ++__i ) {
-            //TODO: to improve SIMD vectorization
-            const _DifferenceType __t = __pred(*(__first + __i), *(__first + __i + 1));
-            __lane[__i] = __t;
-            __found |= __t;
-        }
-
-        //Process a pair of elements on a boundary of a data block
-        if(__first + __block_size < __last && __pred(*(__first + __i), *(__first + __i + 1)))
-            __lane[__i] = __found = 1;
+__PSTL_PRAGMA_SIMD_REDUCTION(|:__mask)
+        for ( __i = 0; __i < __len; ++__i )
+            __mask |= internal::mask_word(__pred(__first[__i], __first[__i + 1]) ? 1 : 0) << __i;
 
-        if ( __found ) {
+        if ( __mask ) {
             if(__or_semantic)
                 return __first;
-
-            // This will vectorize
-            for ( __i = 0; __i < __block_size; ++__i )
-                if ( __lane[__i] ) break;
-            return __first + __i; //As far as found is true a __result (__lane[__i] is true) is guaranteed
+            return __first + internal::mask_lowest(__mask);
         }
-        __first += __block_size;
+        __first += __len;
+        // Double the block size. Any unnecessary iterations can be amortized against work done so far.
+        __block_size = std::min<_DifferenceType>(__block_size << 1, simd_block_size<_Index>::value);
     }
-    //Process the rest elements
-    for (; __last - __first > 1; ++__first)
-        if(__pred(*__first, *(__first+1)))
-            return __first;
-
     return __last;
 #endif
 }
 
+#if __PSTL_SIMD_DISPATCH_PRESENT
+template<class _Index, class _BinaryPredicate>
+_Index simd_adjacent_find(_Index __first, _Index __last, _BinaryPredicate, bool, /*dispatch=*/std::true_type) noexcept {
+    if (__last - __first < 2)
+        return __last;
+    return __first + dispatch_adjacent_find_equal(std::addressof(*__first), std::size_t(__last - __first));
+}
+#endif
+
+template<class _Index, class _BinaryPredicate>
+_Index simd_adjacent_find(_Index __first, _Index __last, _BinaryPredicate __pred, bool __or_semantic) noexcept {
+    return unseq_backend::simd_adjacent_find(__first, __last, __pred, __or_semantic, is_dispatch_equal<_Index, _BinaryPredicate>());
+}
+
 // It was created to reduce the code inside std::enable_if
 template<typename _Tp, typename _BinaryOperation>
 using is_arithmetic_plus = std::integral_constant<bool, std::is_arithmetic<_Tp>::value && std::is_same<_BinaryOperation, std::plus<_Tp>>::value>;
@@ -393,47 +905,13 @@ __PSTL_PRAGMA_SIMD_REDUCTION(+:__init)
 template<typename _Size, typename _Tp, typename _BinaryOperation, typename _UnaryOperation>
 typename std::enable_if<!is_arithmetic_plus<_Tp, _BinaryOperation>::value, _Tp>::type
 simd_transform_reduce(_Size __n, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __f) noexcept {
-    const std::size_t __lane_size = 64;
-    const std::size_t block_size = __lane_size / sizeof(_Tp);
-    if (__n > 2 * block_size && block_size > 1) {
-        alignas(__lane_size) char __lane_[__lane_size];
-        _Tp* __lane = reinterpret_cast<_Tp*>(__lane_);
-
-        // initializer
-__PSTL_PRAGMA_SIMD
-        for (_Size __i = 0; __i < block_size; ++__i) {
-            ::new (__lane + __i) _Tp(__binary_op(__f(__i), __f(block_size + __i)));
-        }
-        // main loop
-        _Size __i = 2 * block_size;
-        const _Size last_iteration = block_size * (__n / block_size);
-        for (; __i < last_iteration; __i += block_size) {
-__PSTL_PRAGMA_SIMD
-            for (_Size __j = 0; __j < block_size; ++__j) {
-                __lane[__j] = __binary_op(__lane[__j], __f(__i + __j));
-            }
-        }
-        // remainder
-__PSTL_PRAGMA_SIMD
-        for (_Size __j = 0; __j < __n - last_iteration; ++__j) {
-            __lane[__j] = __binary_op(__lane[__j], __f(last_iteration + __j));
-        }
-        // combiner
-        for (_Size __i = 0; __i < block_size; ++__i) {
-            __init = __binary_op(__init, __lane[__i]);
-        }
-        // destroyer
-__PSTL_PRAGMA_SIMD
-        for (_Size __i = 0; __i < block_size; ++__i) {
-            __lane[__i].~_Tp();
-        }
-    }
-    else {
-        for (_Size __i = 0; __i < __n; ++__i) {
-            __init = __binary_op(__init, __f(__i));
-        }
+    if (__n <= 0) {
+        return __init;
     }
-    return __init;
+    return __binary_op(__init, lane_reduce<lane_count<_Tp>::value, _Tp>(__n,
+        [&__f](_Size __i) { return _Tp(__f(__i)); },
+        [&__binary_op, &__f](_Tp& __acc, _Size __i) { __acc = __binary_op(__acc, __f(__i)); },
+        [&__binary_op](_Tp& __acc, const _Tp& __other) { __acc = __binary_op(__acc, __other); }));
 }
 
 // As soon as we cannot call __binary_op in "combiner" we create a wrapper over _Tp to encapsulate __binary_op
@@ -512,10 +990,27 @@ __PSTL_PRAGMA_SIMD_INCLUSIVE_SCAN(__init_)
     return std::make_pair(__result + __n, __init_.value);
 }
 
+#if !__PSTL_UDR_PRESENT
+// The lanes keep copies of the smallest values, which pays off only for cheaply copied types.
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+_ForwardIterator simd_min_element(_ForwardIterator __first, _Size __n, _Compare __comp, /*dispatch=*/std::false_type, /*lanes=*/std::true_type) noexcept {
+    if (__n == 0) {
+        return __first;
+    }
+    return __first + lane_min_element(__first, __n, __comp);
+}
+
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+_ForwardIterator simd_min_element(_ForwardIterator __first, _Size __n, _Compare __comp, /*dispatch=*/std::false_type, /*lanes=*/std::false_type) noexcept {
+    return std::min_element(__first, __first + __n, __comp);
+}
+#endif
+
 // [restriction] - std::iterator_traits<_ForwardIterator>::value_type should be DefaultConstructible.
 // complexity [violation] - We will have at most (__n-1 + number_of_lanes) comparisons instead of at most __n-1.
 template <typename _ForwardIterator, typename _Size, typename _Compare>
-_ForwardIterator simd_min_element(_ForwardIterator __first, _Size __n, _Compare __comp) noexcept {
+_ForwardIterator simd_min_element(_ForwardIterator __first, _Size __n, _Compare __comp, /*dispatch=*/std::false_type) noexcept {
+#if __PSTL_UDR_PRESENT
     if (__n == 0) {
         return __first;
     }
@@ -554,12 +1049,53 @@ __PSTL_PRAGMA_SIMD_REDUCTION(min_func:__init)
         }
     }
     return __init.__min_it;
+#else
+    return unseq_backend::simd_min_element(__first, __n, __comp, std::false_type(),
+                                           is_lane_type<typename std::iterator_traits<_ForwardIterator>::value_type>());
+#endif
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+// The extreme value is found first, then its first occurrence.
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+_ForwardIterator simd_min_element(_ForwardIterator __first, _Size __n, _Compare, /*dispatch=*/std::true_type) noexcept {
+    if (__n == 0) {
+        return __first;
+    }
+    const auto* __p = std::addressof(*__first);
+    const auto __value = is_dispatch_less<_ForwardIterator, _Compare>::value ? dispatch_min_value(__p, std::size_t(__n))
+                                                                              : dispatch_max_value(__p, std::size_t(__n));
+    return __first + dispatch_find_equal(__p, std::size_t(__n), __value);
+}
+#endif
+
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+_ForwardIterator simd_min_element(_ForwardIterator __first, _Size __n, _Compare __comp) noexcept {
+    return unseq_backend::simd_min_element(__first, __n, __comp, std::integral_constant<bool,
+        is_dispatch_less<_ForwardIterator, _Compare>::value || is_dispatch_greater<_ForwardIterator, _Compare>::value>());
 }
 
+#if !__PSTL_UDR_PRESENT
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+std::pair<_ForwardIterator, _ForwardIterator> simd_minmax_element(_ForwardIterator __first, _Size __n, _Compare __comp, /*dispatch=*/std::false_type, /*lanes=*/std::true_type) noexcept {
+    if (__n == 0) {
+        return std::make_pair(__first, __first);
+    }
+    const auto __idx = lane_minmax_element(__first, __n, __comp);
+    return std::make_pair(__first + __idx.first, __first + __idx.second);
+}
+
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+std::pair<_ForwardIterator, _ForwardIterator> simd_minmax_element(_ForwardIterator __first, _Size __n, _Compare __comp, /*dispatch=*/std::false_type, /*lanes=*/std::false_type) noexcept {
+    return std::minmax_element(__first, __first + __n, __comp);
+}
+#endif
+
 // [restriction] - std::iterator_traits<_ForwardIterator>::value_type should be DefaultConstructible.
 // complexity [violation] - We will have at most (2*(__n-1) + 4*number_of_lanes) comparisons instead of at most [1.5*(__n-1)].
 template <typename _ForwardIterator, typename _Size, typename _Compare>
-std::pair<_ForwardIterator, _ForwardIterator> simd_minmax_element(_ForwardIterator __first, _Size __n, _Compare __comp) noexcept {
+std::pair<_ForwardIterator, _ForwardIterator> simd_minmax_element(_ForwardIterator __first, _Size __n, _Compare __comp, /*dispatch=*/std::false_type) noexcept {
+#if __PSTL_UDR_PRESENT
     if (__n == 0) {
         return std::make_pair(__first, __first);
     }
@@ -614,6 +1150,31 @@ __PSTL_PRAGMA_SIMD_REDUCTION(min_func:__init)
         }
     }
     return std::make_pair(__init.__min_it, __init.__max_it);
+#else
+    return unseq_backend::simd_minmax_element(__first, __n, __comp, std::false_type(),
+                                              is_lane_type<typename std::iterator_traits<_ForwardIterator>::value_type>());
+#endif
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+// The smallest and the largest values are found first, then the first occurrence of the smallest
+// and the last occurrence of the largest one.
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+std::pair<_ForwardIterator, _ForwardIterator> simd_minmax_element(_ForwardIterator __first, _Size __n, _Compare, /*dispatch=*/std::true_type) noexcept {
+    if (__n == 0) {
+        return std::make_pair(__first, __first);
+    }
+    const auto* __p = std::addressof(*__first);
+    typename std::iterator_traits<_ForwardIterator>::value_type __min, __max;
+    dispatch_minmax_value(__p, std::size_t(__n), __min, __max);
+    return std::make_pair(__first + dispatch_find_equal(__p, std::size_t(__n), __min),
+                          __first + dispatch_rfind_equal(__p, std::size_t(__n), __max));
+}
+#endif
+
+template <typename _ForwardIterator, typename _Size, typename _Compare>
+std::pair<_ForwardIterator, _ForwardIterator> simd_minmax_element(_ForwardIterator __first, _Size __n, _Compare __comp) noexcept {
+    return unseq_backend::simd_minmax_element(__first, __n, __comp, is_dispatch_less<_ForwardIterator, _Compare>());
 }
 
 template<class _Iterator, class _DifferenceType, class _Function>
@@ -633,29 +1194,9 @@ __PSTL_PRAGMA_SIMD
     return __first2 + __n;
 }
 
-template<class _InputIterator, class _DifferenceType, class _OutputIterator1, class _OutputIterator2, class _UnaryPredicate>
-std::pair<_OutputIterator1, _OutputIterator2>
-simd_partition_copy(_InputIterator __first, _DifferenceType __n, _OutputIterator1 __out_true, _OutputIterator2 __out_false, _UnaryPredicate __pred) noexcept {
-    _DifferenceType __cnt_true = 0, __cnt_false = 0;
-
-__PSTL_PRAGMA_SIMD
-    for (_DifferenceType __i = 0; __i < __n; ++__i) {
-__PSTL_PRAGMA_SIMD_ORDERED_MONOTONIC_2ARGS(__cnt_true:1, __cnt_false : 1)
-        if (__pred(__first[__i])) {
-            __out_true[__cnt_true] = __first[__i];
-            ++__cnt_true;
-        }
-        else {
-            __out_false[__cnt_false] = __first[__i];
-            ++__cnt_false;
-        }
-    }
-    return std::make_pair(__out_true + __cnt_true, __out_false + __cnt_false);
-}
-
 template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
 _ForwardIterator1 simd_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first,
-                                     _ForwardIterator2 __s_last, _BinaryPredicate __pred) noexcept {
+                                     _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*dispatch=*/std::false_type) noexcept {
     typedef typename std::iterator_traits<_ForwardIterator1>::difference_type _DifferencType;
 
     const _DifferencType __n1 = __last - __first;
@@ -677,17 +1218,59 @@ _ForwardIterator1 simd_find_first_of(_ForwardIterator1 __first, _ForwardIterator
         }
     }
     else {
-        for (; __s_first != __s_last; ++__s_first) {
-            const auto __result = unseq_backend::simd_first(__first, _DifferencType(0), __n1,
+        // A later needle is only of interest before the first match found so far
+        for (; __s_first != __s_last && __first != __last; ++__s_first) {
+            __last = unseq_backend::simd_first(__first, _DifferencType(0), _DifferencType(__last - __first),
                 [__s_first, &__pred](_ForwardIterator1 __it, _DifferencType __i) {return __pred(__it[__i], *__s_first); });
-            if (__result != __last) {
-                return __result;
-            }
         }
     }
     return __last;
 }
 
+#if __PSTL_SIMD_DISPATCH_PRESENT
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
+_ForwardIterator1 simd_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first,
+                                     _ForwardIterator2 __s_last, _BinaryPredicate __pred, /*dispatch=*/std::true_type) noexcept {
+    const auto __n1 = __last - __first;
+    const auto __n2 = __s_last - __s_first;
+    if (__n1 == 0 || __n2 == 0) {
+        return __last;
+    }
+    if (std::size_t(__n2) > __PSTL_DISPATCH_MAX_NEEDLES) {
+        return unseq_backend::simd_find_first_of(__first, __last, __s_first, __s_last, __pred, std::false_type());
+    }
+    return __first + dispatch_find_first_of_equal(std::addressof(*__first), std::size_t(__n1), std::addressof(*__s_first), std::size_t(__n2));
+}
+#endif
+
+template<class _ForwardIterator1, class _ForwardIterator2, class _BinaryPredicate>
+_ForwardIterator1 simd_find_first_of(_ForwardIterator1 __first, _ForwardIterator1 __last, _ForwardIterator2 __s_first,
+                                     _ForwardIterator2 __s_last, _BinaryPredicate __pred) noexcept {
+    return unseq_backend::simd_find_first_of(__first, __last, __s_first, __s_last, __pred, std::integral_constant<bool,
+        is_dispatch_equal<_ForwardIterator1, _BinaryPredicate>::value && is_dispatch_iterator<_ForwardIterator2>::value &&
+        std::is_same<typename std::iterator_traits<_ForwardIterator1>::value_type,
+                     typename std::iterator_traits<_ForwardIterator2>::value_type>::value>());
+}
+
+#if __PSTL_SIMD_DISPATCH_PRESENT
+//! First element __x of [__first, __first + __n) with __set[(unsigned char)__x] != 0, or __first + __n.
+/** Requires an iterator satisfying is_dispatch_iterator over a byte type. */
+template<class _Iterator, class _Size>
+_Iterator simd_find_in_byte_set(_Iterator __first, _Size __n, const unsigned char* __set) noexcept {
+    return __first + dispatch_find_in_byte_set(std::addressof(*__first), std::size_t(__n), __set);
+}
+
+//! First (__b_first) or last occurrence of [__s_first, __s_first + __n2) in [__first, __first + __n1), or __first + __n1.
+/** Requires 2 <= __n2 <= __n1 and iterators satisfying is_dispatch_iterator over the same value type. */
+template<class _Iterator1, class _Size1, class _Iterator2, class _Size2>
+_Iterator1 simd_search(_Iterator1 __first, _Size1 __n1, _Iterator2 __s_first, _Size2 __n2, bool __b_first) noexcept {
+    const auto __p = std::addressof(*__first);
+    const auto __s = std::addressof(*__s_first);
+    return __first + (__b_first ? dispatch_search_equal(__p, std::size_t(__n1), __s, std::size_t(__n2))
+                                : dispatch_rsearch_equal(__p, std::size_t(__n1), __s, std::size_t(__n2)));
+}
+#endif
+
 template<class _RandomAccessIterator, class _DifferenceType, class _UnaryPredicate>
 _RandomAccessIterator simd_remove_if(_RandomAccessIterator __first, _DifferenceType __n, _UnaryPredicate __pred) noexcept {
     // find first element we need to remove
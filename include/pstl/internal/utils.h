@@ -23,6 +23,8 @@
 
 #include <new>
 #include <iterator>
+#include <cstddef>
+#include <cstdint>
 
 namespace __pstl {
 namespace internal {
@@ -77,6 +79,12 @@ struct no_op {
     _Tp&& operator()(_Tp&& __a) const { return std::forward<_Tp>(__a); }
 };
 
+//! Assigner that copies the value referred by the first iterator to the place referred by the second one.
+struct copy_assigner {
+    template<typename _Xp, typename _Zp>
+    void operator()(_Xp __x, _Zp __z) const { *__z = *__x; }
+};
+
 //! Logical negation of a predicate
 template<typename _Pred>
 class not_pred {
@@ -133,6 +141,17 @@ public:
     bool operator()(_Arg&& __arg) { return _M_pred(std::forward<_Arg>(__arg), _M_value); }
 };
 
+//! Like a polymorphic lambda for y = op(x), the element operation of unary transform
+template<typename _UnaryOperation>
+class transform_functor {
+    _UnaryOperation _M_op;
+public:
+    explicit transform_functor(_UnaryOperation __op) : _M_op(__op) {}
+
+    template<typename _Input, typename _Output>
+    void operator()(_Input&& __x, _Output&& __y) { __y = _M_op(std::forward<_Input>(__x)); }
+};
+
 //! Like a polymorphic lambda for ==value
 template<typename _Tp>
 class equal_value {
@@ -142,6 +161,8 @@ public:
 
     template<typename _Arg>
     bool operator()( _Arg&& __arg ) const { return std::forward<_Arg>(__arg) == _M_value; }
+
+    const _Tp& value() const { return _M_value; }
 };
 
 //! Logical negation of ==value
@@ -155,6 +176,57 @@ public:
     bool operator()( _Arg&& __arg ) const { return !(std::forward<_Arg>(__arg) == _M_value); }
 };
 
+//! Word of a packed predicate mask. Bit __j holds the predicate value for the __j-th element of a group.
+typedef std::uint64_t mask_word;
+
+//! Number of elements described by one mask word
+const std::size_t __PSTL_MASK_WORD_BITS = 64;
+
+//! Number of mask words needed for __n elements
+template<typename _DifferenceType>
+_DifferenceType mask_size(_DifferenceType __n) {
+    return (__n + _DifferenceType(__PSTL_MASK_WORD_BITS) - 1) / _DifferenceType(__PSTL_MASK_WORD_BITS);
+}
+
+//! Value of the bit for the element __i in the packed mask
+template<typename _DifferenceType>
+bool mask_test(const mask_word* __mask, _DifferenceType __i) {
+    return (__mask[__i / _DifferenceType(__PSTL_MASK_WORD_BITS)] >> (__i % _DifferenceType(__PSTL_MASK_WORD_BITS))) & 1;
+}
+
+//! Number of set bits in a mask word
+inline std::size_t mask_popcount(mask_word __w) {
+#if __GNUC__ || __clang__
+    return __builtin_popcountll(__w);
+#else
+    __w = __w - ((__w >> 1) & 0x5555555555555555ULL);
+    __w = (__w & 0x3333333333333333ULL) + ((__w >> 2) & 0x3333333333333333ULL);
+    __w = (__w + (__w >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (__w * 0x0101010101010101ULL) >> 56;
+#endif
+}
+
+//! Index of the lowest set bit of a non-zero mask word
+inline std::size_t mask_lowest(mask_word __w) {
+#if __GNUC__ || __clang__
+    return __builtin_ctzll(__w);
+#else
+    return mask_popcount((__w & (0 - __w)) - 1);
+#endif
+}
+
+//! Index of the highest set bit of a non-zero mask word
+inline std::size_t mask_highest(mask_word __w) {
+#if __GNUC__ || __clang__
+    return 63 - __builtin_clzll(__w);
+#else
+    std::size_t __i = 0;
+    while (__w >>= 1)
+        ++__i;
+    return __i;
+#endif
+}
+
 template <typename _ForwardIterator, typename _Compare>
 _ForwardIterator cmp_iterators_by_values(_ForwardIterator __a, _ForwardIterator __b, _Compare __comp) {
     if(__a < __b) { // we should return closer iterator
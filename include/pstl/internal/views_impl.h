@@ -0,0 +1,416 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_views_impl_H
+#define __PSTL_views_impl_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+#include "../iterators.h"
+#include "execution_impl.h"
+#include "algorithm_impl.h"
+#include "numeric_impl.h"
+#include "unseq_backend_simd.h"
+
+#if __PSTL_USE_PAR_POLICIES
+    #include "parallel_backend.h"
+#endif
+
+namespace __pstl {
+namespace internal {
+
+//------------------------------------------------------------------------
+// sinks: the function objects the views pass their elements to
+//------------------------------------------------------------------------
+
+template<typename _Fp, typename _Sink>
+struct transform_sink {
+    const _Fp& _M_f;
+    _Sink& _M_sink;
+    template<typename _Tp>
+    void operator()(_Tp&& __x) const { _M_sink(_M_f(std::forward<_Tp>(__x))); }
+};
+
+template<typename _Predicate, typename _Sink>
+struct filter_sink {
+    const _Predicate& _M_pred;
+    _Sink& _M_sink;
+    template<typename _Tp>
+    void operator()(_Tp&& __x) const {
+        if (_M_pred(__x))
+            _M_sink(std::forward<_Tp>(__x));
+    }
+};
+
+template<typename _Predicate, typename _Sink>
+struct take_while_sink {
+    const _Predicate& _M_pred;
+    _Sink& _M_sink;
+    bool& _M_go;
+    template<typename _Tp>
+    void operator()(_Tp&& __x) const {
+        if (_M_pred(__x))
+            _M_sink(std::forward<_Tp>(__x));
+        else
+            _M_go = false;
+    }
+};
+
+//! Notes whether an element was produced
+struct view_hit_sink {
+    bool& _M_hit;
+    template<typename _Tp>
+    void operator()(_Tp&&) const { _M_hit = true; }
+};
+
+template<typename _Function>
+struct view_call_sink {
+    _Function& _M_f;
+    template<typename _Tp>
+    void operator()(_Tp&& __x) const { _M_f(std::forward<_Tp>(__x)); }
+};
+
+//! Folds the elements into a reduction that is empty at first
+template<typename _Tp, typename _BinaryOperation>
+struct view_reduce_sink {
+    std::pair<bool, _Tp>& _M_acc;
+    _BinaryOperation& _M_op;
+    template<typename _Up>
+    void operator()(_Up&& __x) const {
+        if (_M_acc.first)
+            _M_acc.second = _M_op(_M_acc.second, std::forward<_Up>(__x));
+        else {
+            _M_acc.second = std::forward<_Up>(__x);
+            _M_acc.first = true;
+        }
+    }
+};
+
+template<typename _OutputIterator>
+struct view_copy_sink {
+    _OutputIterator& _M_result;
+    template<typename _Tp>
+    void operator()(_Tp&& __x) const {
+        *_M_result = std::forward<_Tp>(__x);
+        ++_M_result;
+    }
+};
+
+template<typename... _Views>
+struct all_dense : std::true_type {};
+
+template<typename _View, typename... _Views>
+struct all_dense<_View, _Views...> : std::integral_constant<bool, _View::is_dense && all_dense<_Views...>::value> {};
+
+template<typename _View>
+std::ptrdiff_t min_size(const _View& __v) {
+    return __v.size();
+}
+
+template<typename _View, typename... _Views>
+std::ptrdiff_t min_size(const _View& __v, const _Views&... __views) {
+    const std::ptrdiff_t __n = internal::min_size(__views...);
+    return __v.size() < __n ? __v.size() : __n;
+}
+
+//------------------------------------------------------------------------
+// extent: the number of positions a view covers, i.e. up to the first stop
+//------------------------------------------------------------------------
+
+template<class _View, class _IsParallel>
+std::ptrdiff_t pattern_view_extent(const _View& __v, _IsParallel, /*has_stop=*/std::false_type) noexcept {
+    return __v.size();
+}
+
+template<class _View, class _IsParallel>
+std::ptrdiff_t pattern_view_extent(const _View& __v, _IsParallel __is_parallel, /*has_stop=*/std::true_type) {
+    const counting_iterator<std::ptrdiff_t> __first(0);
+    return internal::pattern_find_if(__first, __first + __v.size(), [&__v](std::ptrdiff_t __i) {
+        bool __hit = false;
+        view_hit_sink __s{__hit};
+        return !__v.__visit(__i, __s);
+    }, std::false_type(), __is_parallel) - __first;
+}
+
+template<class _View, class _IsParallel>
+std::ptrdiff_t pattern_view_extent(const _View& __v, _IsParallel __is_parallel) {
+    return internal::pattern_view_extent(__v, __is_parallel, std::integral_constant<bool, _View::has_stop>());
+}
+
+//------------------------------------------------------------------------
+// for_each
+//------------------------------------------------------------------------
+
+template<class _View, class _Function>
+void brick_view_for_each(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, _Function __f, /*is_vector=*/std::false_type) noexcept {
+    view_call_sink<_Function> __s{__f};
+    for (; __i < __j; ++__i)
+        __v.__visit(__i, __s);
+}
+
+template<class _View, class _Function>
+void brick_view_for_each(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, _Function __f, /*is_vector=*/std::true_type) noexcept {
+    view_call_sink<_Function> __s{__f};
+    unseq_backend::simd_walk_1(counting_iterator<std::ptrdiff_t>(__i), __j - __i, [&__v, &__s](std::ptrdiff_t __k) {
+        __v.__visit(__k, __s);
+    });
+}
+
+template<class _View, class _Function, class _IsVector>
+void pattern_view_for_each(const _View& __v, _Function __f, _IsVector __is_vector, /*is_parallel=*/std::false_type) noexcept {
+    internal::brick_view_for_each(__v, 0, internal::pattern_view_extent(__v, std::false_type()), __f, __is_vector);
+}
+
+template<class _View, class _Function, class _IsVector>
+void pattern_view_for_each(const _View& __v, _Function __f, _IsVector __is_vector, /*is_parallel=*/std::true_type) {
+    internal::except_handler([&]() {
+        par_backend::parallel_for(std::ptrdiff_t(0), internal::pattern_view_extent(__v, std::true_type()),
+            [&__v, __f, __is_vector](std::ptrdiff_t __i, std::ptrdiff_t __j) {
+                internal::brick_view_for_each(__v, __i, __j, __f, __is_vector);
+            });
+    });
+}
+
+//------------------------------------------------------------------------
+// reduce
+//
+// Dense views are reduced by transform_reduce over their positions. Otherwise each subrange reduces to
+// an empty or a non-empty value, since a filter may leave no element to start with.
+//------------------------------------------------------------------------
+
+template<class _Tp, class _BinaryOperation>
+void view_reduce_combine(std::pair<bool, _Tp>& __acc, const std::pair<bool, _Tp>& __other, _BinaryOperation __op) {
+    if (!__other.first)
+        return;
+    if (__acc.first)
+        __acc.second = __op(__acc.second, __other.second);
+    else
+        __acc = __other;
+}
+
+template<class _View, class _Tp, class _BinaryOperation>
+std::pair<bool, _Tp> brick_view_reduce(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, std::pair<bool, _Tp> __acc,
+                                       _BinaryOperation __op, /*is_vector=*/std::false_type) noexcept {
+    view_reduce_sink<_Tp, _BinaryOperation> __s{__acc, __op};
+    for (; __i < __j; ++__i)
+        __v.__visit(__i, __s);
+    return __acc;
+}
+
+// The subrange is reduced by lanes of the engine of simd_transform_reduce.
+template<class _View, class _Tp, class _BinaryOperation>
+std::pair<bool, _Tp> brick_view_reduce(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, std::pair<bool, _Tp> __acc,
+                                       _BinaryOperation __op, /*is_vector=*/std::true_type) noexcept {
+    typedef std::pair<bool, _Tp> _Acc;
+    if (__j <= __i)
+        return __acc;
+    const _Acc __empty(false, __acc.second);
+    const _Acc __r = unseq_backend::lane_reduce<unseq_backend::lane_count<_Tp>::value, _Acc>(__j - __i,
+        [&__v, &__op, &__empty, __i](std::ptrdiff_t __k) {
+            _Acc __lane(__empty);
+            view_reduce_sink<_Tp, _BinaryOperation> __s{__lane, __op};
+            __v.__visit(__i + __k, __s);
+            return __lane;
+        },
+        [&__v, &__op, __i](_Acc& __lane, std::ptrdiff_t __k) {
+            view_reduce_sink<_Tp, _BinaryOperation> __s{__lane, __op};
+            __v.__visit(__i + __k, __s);
+        },
+        [&__op](_Acc& __lane, const _Acc& __other) { internal::view_reduce_combine(__lane, __other, __op); });
+    internal::view_reduce_combine(__acc, __r, __op);
+    return __acc;
+}
+
+template<class _View, class _Tp, class _BinaryOperation, class _IsVector>
+std::pair<bool, _Tp> pattern_view_reduce(const _View& __v, std::ptrdiff_t __n, const std::pair<bool, _Tp>& __empty, _BinaryOperation __op,
+                                         _IsVector __is_vector, /*is_parallel=*/std::false_type) noexcept {
+    return internal::brick_view_reduce(__v, 0, __n, __empty, __op, __is_vector);
+}
+
+template<class _View, class _Tp, class _BinaryOperation, class _IsVector>
+std::pair<bool, _Tp> pattern_view_reduce(const _View& __v, std::ptrdiff_t __n, const std::pair<bool, _Tp>& __empty, _BinaryOperation __op,
+                                         _IsVector __is_vector, /*is_parallel=*/std::true_type) {
+    typedef std::pair<bool, _Tp> _Acc;
+    return internal::except_handler([&]() {
+        return par_backend::parallel_reduce(std::ptrdiff_t(0), __n, __empty,
+            [&__v, __op, __is_vector](std::ptrdiff_t __i, std::ptrdiff_t __j, const _Acc& __acc) {
+                return internal::brick_view_reduce(__v, __i, __j, __acc, __op, __is_vector);
+            },
+            [__op](const _Acc& __x, const _Acc& __y) {
+                _Acc __r(__x);
+                internal::view_reduce_combine(__r, __y, __op);
+                return __r;
+            });
+    });
+}
+
+template<class _View, class _Tp, class _BinaryOperation, class _IsVector, class _IsParallel>
+_Tp pattern_view_reduce(const _View& __v, _Tp __init, _BinaryOperation __op, _IsVector __is_vector, _IsParallel __is_parallel,
+                        /*is_dense=*/std::true_type) {
+    const counting_iterator<std::ptrdiff_t> __first(0);
+    return internal::pattern_transform_reduce(__first, __first + __v.size(), __init, __op,
+        [&__v](std::ptrdiff_t __i) -> typename _View::reference { return __v[__i]; }, __is_vector, __is_parallel);
+}
+
+template<class _View, class _Tp, class _BinaryOperation, class _IsVector, class _IsParallel>
+_Tp pattern_view_reduce(const _View& __v, _Tp __init, _BinaryOperation __op, _IsVector __is_vector, _IsParallel __is_parallel,
+                        /*is_dense=*/std::false_type) {
+    const std::pair<bool, _Tp> __r = internal::pattern_view_reduce(__v, internal::pattern_view_extent(__v, __is_parallel),
+                                                                   std::pair<bool, _Tp>(false, __init), __op, __is_vector, __is_parallel);
+    return __r.first ? __op(__init, __r.second) : __init;
+}
+
+template<class _View, class _Tp, class _BinaryOperation, class _IsVector, class _IsParallel>
+_Tp pattern_view_reduce(const _View& __v, _Tp __init, _BinaryOperation __op, _IsVector __is_vector, _IsParallel __is_parallel) {
+    return internal::pattern_view_reduce(__v, __init, __op, __is_vector, __is_parallel, std::integral_constant<bool, _View::is_dense>());
+}
+
+//------------------------------------------------------------------------
+// count
+//------------------------------------------------------------------------
+
+template<class _View>
+std::ptrdiff_t brick_view_count(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, /*is_vector=*/std::false_type) noexcept {
+    std::ptrdiff_t __count = 0;
+    for (; __i < __j; ++__i) {
+        bool __hit = false;
+        view_hit_sink __s{__hit};
+        __v.__visit(__i, __s);
+        __count += __hit;
+    }
+    return __count;
+}
+
+template<class _View>
+std::ptrdiff_t brick_view_count(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, /*is_vector=*/std::true_type) noexcept {
+    return unseq_backend::simd_transform_reduce(__j - __i, std::ptrdiff_t(0), std::plus<std::ptrdiff_t>(), [&__v, __i](std::ptrdiff_t __k) {
+        bool __hit = false;
+        view_hit_sink __s{__hit};
+        __v.__visit(__i + __k, __s);
+        return std::ptrdiff_t(__hit);
+    });
+}
+
+template<class _View, class _IsVector>
+std::ptrdiff_t pattern_view_count(const _View& __v, _IsVector __is_vector, /*is_parallel=*/std::false_type) noexcept {
+    if (_View::is_dense)
+        return __v.size();
+    return internal::brick_view_count(__v, 0, internal::pattern_view_extent(__v, std::false_type()), __is_vector);
+}
+
+template<class _View, class _IsVector>
+std::ptrdiff_t pattern_view_count(const _View& __v, _IsVector __is_vector, /*is_parallel=*/std::true_type) {
+    if (_View::is_dense)
+        return __v.size();
+    return internal::except_handler([&]() {
+        return par_backend::parallel_reduce(std::ptrdiff_t(0), internal::pattern_view_extent(__v, std::true_type()), std::ptrdiff_t(0),
+            [&__v, __is_vector](std::ptrdiff_t __i, std::ptrdiff_t __j, std::ptrdiff_t __count) {
+                return __count + internal::brick_view_count(__v, __i, __j, __is_vector);
+            },
+            std::plus<std::ptrdiff_t>());
+    });
+}
+
+//------------------------------------------------------------------------
+// copy
+//
+// Views that may drop elements are copied like copy_if: a strict scan counts the elements of each
+// subrange, then every subrange writes its elements from its offset.
+//------------------------------------------------------------------------
+
+template<class _View, class _OutputIterator>
+_OutputIterator brick_view_copy(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, _OutputIterator __result) noexcept {
+    view_copy_sink<_OutputIterator> __s{__result};
+    for (; __i < __j; ++__i)
+        __v.__visit(__i, __s);
+    return __result;
+}
+
+// Each element of a dense view has its place in the output, so the writes are independent.
+template<class _View, class _OutputIterator>
+_OutputIterator brick_view_copy_dense(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, _OutputIterator __result, /*is_vector=*/std::false_type) noexcept {
+    return internal::brick_view_copy(__v, __i, __j, __result);
+}
+
+template<class _View, class _OutputIterator>
+_OutputIterator brick_view_copy_dense(const _View& __v, std::ptrdiff_t __i, std::ptrdiff_t __j, _OutputIterator __result, /*is_vector=*/std::true_type) noexcept {
+    unseq_backend::simd_walk_1(counting_iterator<std::ptrdiff_t>(0), __j - __i, [&__v, __i, __result](std::ptrdiff_t __k) {
+        __result[__k] = __v[__i + __k];
+    });
+    return __result + (__j - __i);
+}
+
+template<class _View, class _OutputIterator, class _IsVector>
+_OutputIterator pattern_view_copy(const _View& __v, _OutputIterator __result, _IsVector __is_vector, /*is_parallel=*/std::false_type,
+                                  /*is_dense=*/std::true_type) noexcept {
+    return internal::brick_view_copy_dense(__v, 0, __v.size(), __result, __is_vector);
+}
+
+template<class _View, class _OutputIterator, class _IsVector>
+_OutputIterator pattern_view_copy(const _View& __v, _OutputIterator __result, _IsVector, /*is_parallel=*/std::false_type,
+                                  /*is_dense=*/std::false_type) noexcept {
+    return internal::brick_view_copy(__v, 0, internal::pattern_view_extent(__v, std::false_type()), __result);
+}
+
+template<class _View, class _OutputIterator, class _IsVector>
+_OutputIterator pattern_view_copy(const _View& __v, _OutputIterator __result, _IsVector __is_vector, /*is_parallel=*/std::false_type) noexcept {
+    return internal::pattern_view_copy(__v, __result, __is_vector, std::false_type(), std::integral_constant<bool, _View::is_dense>());
+}
+
+template<class _View, class _OutputIterator, class _IsVector>
+_OutputIterator pattern_view_copy(const _View& __v, _OutputIterator __result, _IsVector __is_vector, /*is_parallel=*/std::true_type,
+                                  /*is_dense=*/std::true_type) {
+    const std::ptrdiff_t __n = __v.size();
+    par_backend::parallel_for(std::ptrdiff_t(0), __n, [&__v, __result, __is_vector](std::ptrdiff_t __i, std::ptrdiff_t __j) {
+        internal::brick_view_copy_dense(__v, __i, __j, __result + __i, __is_vector);
+    });
+    return __result + __n;
+}
+
+template<class _View, class _OutputIterator, class _IsVector>
+_OutputIterator pattern_view_copy(const _View& __v, _OutputIterator __result, _IsVector __is_vector, /*is_parallel=*/std::true_type,
+                                  /*is_dense=*/std::false_type) {
+    std::ptrdiff_t __m = 0;
+    par_backend::parallel_strict_scan(internal::pattern_view_extent(__v, std::true_type()), std::ptrdiff_t(0),
+        [&__v, __is_vector](std::ptrdiff_t __i, std::ptrdiff_t __len) {                        // Reduce
+            return internal::brick_view_count(__v, __i, __i + __len, __is_vector);
+        },
+        std::plus<std::ptrdiff_t>(),                                                            // Combine
+        [&__v, __result](std::ptrdiff_t __i, std::ptrdiff_t __len, std::ptrdiff_t __initial) {  // Scan
+            internal::brick_view_copy(__v, __i, __i + __len, __result + __initial);
+        },
+        [&__m](std::ptrdiff_t __total) { __m = __total; });
+    return __result + __m;
+}
+
+template<class _View, class _OutputIterator, class _IsVector>
+_OutputIterator pattern_view_copy(const _View& __v, _OutputIterator __result, _IsVector __is_vector, /*is_parallel=*/std::true_type) {
+    return internal::except_handler([&]() {
+        return internal::pattern_view_copy(__v, __result, __is_vector, std::true_type(), std::integral_constant<bool, _View::is_dense>());
+    });
+}
+
+} // namespace internal
+} // namespace __pstl
+
+#endif /* __PSTL_views_impl_H */
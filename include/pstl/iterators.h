@@ -17,24 +17,345 @@
 
 
 */
-
 #ifndef __PSTL_iterators_H
 #define __PSTL_iterators_H
 
-#include <tbb/tbb_stddef.h>
-
-#if TBB_VERSION_MAJOR < 2019
-#error Threading Building Blocks (TBB) 2019 is required for usage of special iterator types
-#else
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
-#include <tbb/iterators.h>
+// Special iterator types for the parallel algorithms. They are random access iterators whose operator[]
+// indexes the underlying sequences directly (e.g. zip_iterator's __it[__i] is a tuple of references to
+// __base[__i]...), so that the loops of the vectorized bricks keep a simple index form.
 
 namespace __pstl {
-    using tbb::counting_iterator;
-    using tbb::zip_iterator;
-    using tbb::make_zip_iterator;
-} //namespace __pstl
+namespace internal {
+
+//! Compile-time list of tuple indices 0, ..., _Np - 1 (std::index_sequence is C++14)
+template<std::size_t... _Ip>
+struct tuple_indices {};
+
+template<std::size_t _Np, std::size_t... _Ip>
+struct make_tuple_indices : make_tuple_indices<_Np - 1, _Np - 1, _Ip...> {};
+
+template<std::size_t... _Ip>
+struct make_tuple_indices<0, _Ip...> {
+    typedef tuple_indices<_Ip...> type;
+};
+
+//! Value assigned through a discard_iterator: accepts anything and keeps nothing
+struct discard_value {
+    template<typename _Tp>
+    const discard_value& operator=(const _Tp&) const { return *this; }
+};
+
+} // namespace internal
+
+//! Iterator over the sequence of integers __init, __init + 1, ...
+template<typename _Ip>
+class counting_iterator {
+    static_assert(std::is_integral<_Ip>::value, "Cannot instantiate counting_iterator with a non-integer type");
+public:
+    typedef typename std::make_signed<_Ip>::type difference_type;
+    typedef _Ip value_type;
+    typedef const _Ip* pointer;
+    typedef _Ip reference;
+    typedef std::random_access_iterator_tag iterator_category;
+
+    counting_iterator() : _M_counter() {}
+    explicit counting_iterator(_Ip __init) : _M_counter(__init) {}
+
+    reference operator*() const { return _M_counter; }
+    reference operator[](difference_type __i) const { return _Ip(_M_counter + __i); }
+
+    difference_type operator-(const counting_iterator& __it) const { return difference_type(_M_counter - __it._M_counter); }
+
+    counting_iterator& operator+=(difference_type __n) { _M_counter += __n; return *this; }
+    counting_iterator& operator-=(difference_type __n) { return *this += -__n; }
+    counting_iterator& operator++() { return *this += 1; }
+    counting_iterator& operator--() { return *this -= 1; }
+    counting_iterator operator++(int) { counting_iterator __it(*this); ++*this; return __it; }
+    counting_iterator operator--(int) { counting_iterator __it(*this); --*this; return __it; }
+
+    counting_iterator operator-(difference_type __n) const { return counting_iterator(_M_counter - __n); }
+    counting_iterator operator+(difference_type __n) const { return counting_iterator(_M_counter + __n); }
+    friend counting_iterator operator+(difference_type __n, const counting_iterator& __it) { return __it + __n; }
+
+    bool operator==(const counting_iterator& __it) const { return *this - __it == 0; }
+    bool operator!=(const counting_iterator& __it) const { return !(*this == __it); }
+    bool operator<(const counting_iterator& __it) const { return *this - __it < 0; }
+    bool operator>(const counting_iterator& __it) const { return __it < *this; }
+    bool operator<=(const counting_iterator& __it) const { return !(*this > __it); }
+    bool operator>=(const counting_iterator& __it) const { return !(*this < __it); }
+
+private:
+    _Ip _M_counter;
+};
+
+//! Iterator over tuples of the elements at the same position of several random access sequences
+/** The first iterator determines the position, the distance and the order. */
+template<typename... _Types>
+class zip_iterator {
+    static_assert(sizeof...(_Types) > 0, "Cannot instantiate zip_iterator with empty template parameter pack");
+    typedef std::tuple<_Types...> __it_types;
+    typedef typename internal::make_tuple_indices<sizeof...(_Types)>::type __indices;
+public:
+    typedef typename std::make_signed<std::size_t>::type difference_type;
+    typedef std::tuple<typename std::iterator_traits<_Types>::value_type...> value_type;
+    typedef std::tuple<typename std::iterator_traits<_Types>::reference...> reference;
+    typedef std::tuple<typename std::iterator_traits<_Types>::pointer...> pointer;
+    typedef std::random_access_iterator_tag iterator_category;
+
+    zip_iterator() : _M_it() {}
+    explicit zip_iterator(_Types... __args) : _M_it(__args...) {}
+    explicit zip_iterator(const __it_types& __input) : _M_it(__input) {}
+
+    reference operator*() const { return this->__at(0, __indices()); }
+    reference operator[](difference_type __i) const { return this->__at(__i, __indices()); }
+
+    difference_type operator-(const zip_iterator& __it) const {
+        return difference_type(std::get<0>(_M_it) - std::get<0>(__it._M_it));
+    }
+
+    zip_iterator& operator+=(difference_type __n) { this->__advance(__n, __indices()); return *this; }
+    zip_iterator& operator-=(difference_type __n) { return *this += -__n; }
+    zip_iterator& operator++() { return *this += 1; }
+    zip_iterator& operator--() { return *this -= 1; }
+    zip_iterator operator++(int) { zip_iterator __it(*this); ++*this; return __it; }
+    zip_iterator operator--(int) { zip_iterator __it(*this); --*this; return __it; }
+
+    zip_iterator operator-(difference_type __n) const { zip_iterator __it(*this); return __it -= __n; }
+    zip_iterator operator+(difference_type __n) const { zip_iterator __it(*this); return __it += __n; }
+    friend zip_iterator operator+(difference_type __n, const zip_iterator& __it) { return __it + __n; }
+
+    bool operator==(const zip_iterator& __it) const { return *this - __it == 0; }
+    bool operator!=(const zip_iterator& __it) const { return !(*this == __it); }
+    bool operator<(const zip_iterator& __it) const { return *this - __it < 0; }
+    bool operator>(const zip_iterator& __it) const { return __it < *this; }
+    bool operator<=(const zip_iterator& __it) const { return !(*this > __it); }
+    bool operator>=(const zip_iterator& __it) const { return !(*this < __it); }
+
+    const __it_types& base() const { return _M_it; }
+
+private:
+    template<std::size_t... _Ip>
+    reference __at(difference_type __i, internal::tuple_indices<_Ip...>) const {
+        return reference(std::get<_Ip>(_M_it)[__i]...);
+    }
+
+    template<std::size_t... _Ip>
+    void __advance(difference_type __n, internal::tuple_indices<_Ip...>) {
+        typedef int __swallow[];
+        (void)__swallow{0, ((void)(std::get<_Ip>(_M_it) += __n), 0)...};
+    }
+
+    __it_types _M_it;
+};
+
+template<typename... _Types>
+zip_iterator<_Types...> make_zip_iterator(_Types... __args) {
+    return zip_iterator<_Types...>(__args...);
+}
+
+//! Iterator over __f(__base[0]), __f(__base[1]), ..., computed on access
+template<typename _Iter, typename _UnaryFunc>
+class transform_iterator {
+public:
+    typedef typename std::iterator_traits<_Iter>::difference_type difference_type;
+    typedef decltype(std::declval<const _UnaryFunc&>()(std::declval<typename std::iterator_traits<_Iter>::reference>())) reference;
+    typedef typename std::remove_cv<typename std::remove_reference<reference>::type>::type value_type;
+    typedef typename std::iterator_traits<_Iter>::pointer pointer;
+    typedef std::random_access_iterator_tag iterator_category;
+
+    transform_iterator(_Iter __it, _UnaryFunc __f) : _M_it(__it), _M_f(__f) {}
+    transform_iterator(const transform_iterator& __it) : _M_it(__it._M_it), _M_f(__it._M_f) {}
+
+    // Lambdas are not copy assignable; their copies made from the same object are kept as they are.
+    transform_iterator& operator=(const transform_iterator& __it) {
+        _M_it = __it._M_it;
+        this->__assign_functor(__it._M_f, std::is_copy_assignable<_UnaryFunc>());
+        return *this;
+    }
+
+    reference operator*() const { return _M_f(*_M_it); }
+    reference operator[](difference_type __i) const { return _M_f(_M_it[__i]); }
+
+    difference_type operator-(const transform_iterator& __it) const { return _M_it - __it._M_it; }
+
+    transform_iterator& operator+=(difference_type __n) { _M_it += __n; return *this; }
+    transform_iterator& operator-=(difference_type __n) { _M_it -= __n; return *this; }
+    transform_iterator& operator++() { ++_M_it; return *this; }
+    transform_iterator& operator--() { --_M_it; return *this; }
+    transform_iterator operator++(int) { transform_iterator __it(*this); ++*this; return __it; }
+    transform_iterator operator--(int) { transform_iterator __it(*this); --*this; return __it; }
+
+    transform_iterator operator-(difference_type __n) const { return transform_iterator(_M_it - __n, _M_f); }
+    transform_iterator operator+(difference_type __n) const { return transform_iterator(_M_it + __n, _M_f); }
+    friend transform_iterator operator+(difference_type __n, const transform_iterator& __it) { return __it + __n; }
 
-#endif //TBB_VERSION_MAJOR < 2019
+    bool operator==(const transform_iterator& __it) const { return _M_it == __it._M_it; }
+    bool operator!=(const transform_iterator& __it) const { return !(*this == __it); }
+    bool operator<(const transform_iterator& __it) const { return _M_it < __it._M_it; }
+    bool operator>(const transform_iterator& __it) const { return __it < *this; }
+    bool operator<=(const transform_iterator& __it) const { return !(*this > __it); }
+    bool operator>=(const transform_iterator& __it) const { return !(*this < __it); }
+
+    const _Iter& base() const { return _M_it; }
+    const _UnaryFunc& functor() const { return _M_f; }
+
+private:
+    void __assign_functor(const _UnaryFunc& __f, /*assignable=*/std::true_type) { _M_f = __f; }
+    void __assign_functor(const _UnaryFunc&, /*assignable=*/std::false_type) {}
+
+    _Iter _M_it;
+    _UnaryFunc _M_f;
+};
+
+template<typename _Iter, typename _UnaryFunc>
+transform_iterator<_Iter, _UnaryFunc> make_transform_iterator(_Iter __it, _UnaryFunc __f) {
+    return transform_iterator<_Iter, _UnaryFunc>(__it, __f);
+}
+
+//! Iterator over __source[__map[0]], __source[__map[1]], ...
+template<typename _SourceIterator, typename _IndexIterator>
+class permutation_iterator {
+public:
+    typedef typename std::iterator_traits<_IndexIterator>::difference_type difference_type;
+    typedef typename std::iterator_traits<_SourceIterator>::value_type value_type;
+    typedef typename std::iterator_traits<_SourceIterator>::pointer pointer;
+    typedef typename std::iterator_traits<_SourceIterator>::reference reference;
+    typedef std::random_access_iterator_tag iterator_category;
+
+    permutation_iterator() : _M_source(), _M_map() {}
+    permutation_iterator(_SourceIterator __source, _IndexIterator __map) : _M_source(__source), _M_map(__map) {}
+
+    reference operator*() const { return _M_source[*_M_map]; }
+    reference operator[](difference_type __i) const { return _M_source[_M_map[__i]]; }
+
+    difference_type operator-(const permutation_iterator& __it) const { return _M_map - __it._M_map; }
+
+    permutation_iterator& operator+=(difference_type __n) { _M_map += __n; return *this; }
+    permutation_iterator& operator-=(difference_type __n) { _M_map -= __n; return *this; }
+    permutation_iterator& operator++() { ++_M_map; return *this; }
+    permutation_iterator& operator--() { --_M_map; return *this; }
+    permutation_iterator operator++(int) { permutation_iterator __it(*this); ++*this; return __it; }
+    permutation_iterator operator--(int) { permutation_iterator __it(*this); --*this; return __it; }
+
+    permutation_iterator operator-(difference_type __n) const { return permutation_iterator(_M_source, _M_map - __n); }
+    permutation_iterator operator+(difference_type __n) const { return permutation_iterator(_M_source, _M_map + __n); }
+    friend permutation_iterator operator+(difference_type __n, const permutation_iterator& __it) { return __it + __n; }
+
+    bool operator==(const permutation_iterator& __it) const { return _M_map == __it._M_map; }
+    bool operator!=(const permutation_iterator& __it) const { return !(*this == __it); }
+    bool operator<(const permutation_iterator& __it) const { return _M_map < __it._M_map; }
+    bool operator>(const permutation_iterator& __it) const { return __it < *this; }
+    bool operator<=(const permutation_iterator& __it) const { return !(*this > __it); }
+    bool operator>=(const permutation_iterator& __it) const { return !(*this < __it); }
+
+    const _SourceIterator& base() const { return _M_source; }
+    const _IndexIterator& map() const { return _M_map; }
+
+private:
+    _SourceIterator _M_source;
+    _IndexIterator _M_map;
+};
+
+template<typename _SourceIterator, typename _IndexIterator>
+permutation_iterator<_SourceIterator, _IndexIterator> make_permutation_iterator(_SourceIterator __source, _IndexIterator __map) {
+    return permutation_iterator<_SourceIterator, _IndexIterator>(__source, __map);
+}
+
+//! Output iterator that ignores the values assigned through it but keeps its position
+class discard_iterator {
+public:
+    typedef std::ptrdiff_t difference_type;
+    typedef internal::discard_value value_type;
+    typedef void pointer;
+    typedef internal::discard_value reference;
+    typedef std::random_access_iterator_tag iterator_category;
+
+    discard_iterator() : _M_pos(0) {}
+    explicit discard_iterator(difference_type __pos) : _M_pos(__pos) {}
+
+    reference operator*() const { return reference(); }
+    reference operator[](difference_type) const { return reference(); }
+
+    difference_type operator-(const discard_iterator& __it) const { return _M_pos - __it._M_pos; }
+
+    discard_iterator& operator+=(difference_type __n) { _M_pos += __n; return *this; }
+    discard_iterator& operator-=(difference_type __n) { _M_pos -= __n; return *this; }
+    discard_iterator& operator++() { ++_M_pos; return *this; }
+    discard_iterator& operator--() { --_M_pos; return *this; }
+    discard_iterator operator++(int) { discard_iterator __it(*this); ++*this; return __it; }
+    discard_iterator operator--(int) { discard_iterator __it(*this); --*this; return __it; }
+
+    discard_iterator operator-(difference_type __n) const { return discard_iterator(_M_pos - __n); }
+    discard_iterator operator+(difference_type __n) const { return discard_iterator(_M_pos + __n); }
+    friend discard_iterator operator+(difference_type __n, const discard_iterator& __it) { return __it + __n; }
+
+    bool operator==(const discard_iterator& __it) const { return _M_pos == __it._M_pos; }
+    bool operator!=(const discard_iterator& __it) const { return !(*this == __it); }
+    bool operator<(const discard_iterator& __it) const { return _M_pos < __it._M_pos; }
+    bool operator>(const discard_iterator& __it) const { return __it < *this; }
+    bool operator<=(const discard_iterator& __it) const { return !(*this > __it); }
+    bool operator>=(const discard_iterator& __it) const { return !(*this < __it); }
+
+private:
+    difference_type _M_pos;
+};
+
+//! Iterator over every __stride-th element of a random access sequence
+/** The stride may be negative; the distance between two strided iterators must be a multiple of it. */
+template<typename _Iter>
+class strided_iterator {
+public:
+    typedef typename std::iterator_traits<_Iter>::difference_type difference_type;
+    typedef typename std::iterator_traits<_Iter>::value_type value_type;
+    typedef typename std::iterator_traits<_Iter>::pointer pointer;
+    typedef typename std::iterator_traits<_Iter>::reference reference;
+    typedef std::random_access_iterator_tag iterator_category;
+
+    strided_iterator() : _M_it(), _M_stride(1) {}
+    strided_iterator(_Iter __it, difference_type __stride) : _M_it(__it), _M_stride(__stride) {}
+
+    reference operator*() const { return *_M_it; }
+    reference operator[](difference_type __i) const { return _M_it[__i * _M_stride]; }
+
+    difference_type operator-(const strided_iterator& __it) const { return (_M_it - __it._M_it) / _M_stride; }
+
+    strided_iterator& operator+=(difference_type __n) { _M_it += __n * _M_stride; return *this; }
+    strided_iterator& operator-=(difference_type __n) { _M_it -= __n * _M_stride; return *this; }
+    strided_iterator& operator++() { return *this += 1; }
+    strided_iterator& operator--() { return *this -= 1; }
+    strided_iterator operator++(int) { strided_iterator __it(*this); ++*this; return __it; }
+    strided_iterator operator--(int) { strided_iterator __it(*this); --*this; return __it; }
+
+    strided_iterator operator-(difference_type __n) const { strided_iterator __it(*this); return __it -= __n; }
+    strided_iterator operator+(difference_type __n) const { strided_iterator __it(*this); return __it += __n; }
+    friend strided_iterator operator+(difference_type __n, const strided_iterator& __it) { return __it + __n; }
+
+    bool operator==(const strided_iterator& __it) const { return _M_it == __it._M_it; }
+    bool operator!=(const strided_iterator& __it) const { return !(*this == __it); }
+    bool operator<(const strided_iterator& __it) const { return *this - __it < 0; }
+    bool operator>(const strided_iterator& __it) const { return __it < *this; }
+    bool operator<=(const strided_iterator& __it) const { return !(*this > __it); }
+    bool operator>=(const strided_iterator& __it) const { return !(*this < __it); }
+
+    const _Iter& base() const { return _M_it; }
+    difference_type stride() const { return _M_stride; }
+
+private:
+    _Iter _M_it;
+    difference_type _M_stride;
+};
+
+template<typename _Iter>
+strided_iterator<_Iter> make_strided_iterator(_Iter __it, typename std::iterator_traits<_Iter>::difference_type __stride) {
+    return strided_iterator<_Iter>(__it, __stride);
+}
+
+} //namespace __pstl
 
 #endif /* __PSTL_iterators_H */
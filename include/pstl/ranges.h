@@ -0,0 +1,1037 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_ranges_H
+#define __PSTL_ranges_H
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "execution"
+#include "algorithm"
+#include "numeric"
+#include "memory"
+#include "views.h"
+#include "internal/ranges_impl.h"
+
+// Overloads of the parallel algorithms that take ranges, i.e. containers, spans, arrays and views, in place of
+// iterator pairs:
+//   - contiguous ranges (data() and size()) reach the algorithms as pointers, whatever their iterators are,
+//     and the iterators returned are those of the range;
+//   - an output may be an iterator or a range; a range bounds the output, so that only as many elements
+//     are written as it holds. Algorithms writing one element per input element process the prefix of the
+//     input that fits. The filtering algorithms (copy_if, unique_copy, merge, set_* and the like) run in
+//     parallel if the output holds the most elements they may write and else write the output in order,
+//     dropping the elements past its end;
+//   - views run fused where the views provide an executor (for_each, reduce, transform_reduce, count_if, copy).
+
+namespace __pstl {
+namespace ranges {
+
+// [alg.any_of]
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+any_of(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred) {
+    return std::any_of(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __pred);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+all_of(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred) {
+    return std::all_of(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __pred);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+none_of(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred) {
+    return std::none_of(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __pred);
+}
+
+// [alg.foreach]
+
+template<class _ExecutionPolicy, class _Range, class _Function>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+for_each(_ExecutionPolicy&& __exec, _Range&& __r, _Function __f) {
+    internal::range_for_each(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __f, views::is_view<_Range>());
+}
+
+// [alg.find]
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+find(_ExecutionPolicy&& __exec, _Range&& __r, const _Tp& __value) {
+    return internal::range_result(__r, std::find(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __value));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+find_if(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred) {
+    return internal::range_result(__r, std::find_if(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+find_if_not(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred) {
+    return internal::range_result(__r, std::find_if_not(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __pred));
+}
+
+// [alg.find.end]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range1>>
+find_end(_ExecutionPolicy&& __exec, _Range1&& __r, _Range2&& __s, _BinaryPredicate __pred) {
+    return internal::range_result(__r, std::find_end(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), internal::range_first(__s), internal::range_last(__s), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range1>>
+find_end(_ExecutionPolicy&& __exec, _Range1&& __r, _Range2&& __s) {
+    return internal::range_result(__r, std::find_end(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), internal::range_first(__s), internal::range_last(__s)));
+}
+
+// [alg.find_first_of]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range1>>
+find_first_of(_ExecutionPolicy&& __exec, _Range1&& __r, _Range2&& __s, _BinaryPredicate __pred) {
+    return internal::range_result(__r, std::find_first_of(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), internal::range_first(__s), internal::range_last(__s), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range1>>
+find_first_of(_ExecutionPolicy&& __exec, _Range1&& __r, _Range2&& __s) {
+    return internal::range_result(__r, std::find_first_of(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), internal::range_first(__s), internal::range_last(__s)));
+}
+
+// [alg.adjacent_find]
+
+template<class _ExecutionPolicy, class _Range, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+adjacent_find(_ExecutionPolicy&& __exec, _Range&& __r, _BinaryPredicate __pred) {
+    return internal::range_result(__r, std::adjacent_find(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+adjacent_find(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return internal::range_result(__r, std::adjacent_find(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r)));
+}
+
+// [alg.count]
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, typename std::iterator_traits<internal::range_iterator_t<_Range>>::difference_type>
+count(_ExecutionPolicy&& __exec, _Range&& __r, const _Tp& __value) {
+    return std::count(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __value);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, std::ptrdiff_t>
+count_if(_ExecutionPolicy&& __exec, _Range&& __r, _Predicate __pred) {
+    return internal::range_count_if(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __pred, views::is_view<_Range>());
+}
+
+// [mismatch]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, std::pair<internal::range_iterator_t<_Range1>, internal::range_iterator_t<_Range2>>>
+mismatch(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _BinaryPredicate __pred) {
+    auto __res = std::mismatch(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2), __pred);
+    return std::make_pair(internal::range_result(__r1, __res.first), internal::range_result(__r2, __res.second));
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, std::pair<internal::range_iterator_t<_Range1>, internal::range_iterator_t<_Range2>>>
+mismatch(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2) {
+    auto __res = std::mismatch(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2));
+    return std::make_pair(internal::range_result(__r1, __res.first), internal::range_result(__r2, __res.second));
+}
+
+// [alg.equal]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+equal(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _BinaryPredicate __pred) {
+    return std::equal(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2), __pred);
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+equal(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2) {
+    return std::equal(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2));
+}
+
+// [alg.search]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range1>>
+search(_ExecutionPolicy&& __exec, _Range1&& __r, _Range2&& __s, _BinaryPredicate __pred) {
+    return internal::range_result(__r, std::search(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), internal::range_first(__s), internal::range_last(__s), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range1>>
+search(_ExecutionPolicy&& __exec, _Range1&& __r, _Range2&& __s) {
+    return internal::range_result(__r, std::search(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), internal::range_first(__s), internal::range_last(__s)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Size, class _Tp, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+search_n(_ExecutionPolicy&& __exec, _Range&& __r, _Size __count, const _Tp& __value, _BinaryPredicate __pred) {
+    return internal::range_result(__r, std::search_n(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __count, __value, __pred));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Size, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+search_n(_ExecutionPolicy&& __exec, _Range&& __r, _Size __count, const _Tp& __value) {
+    return internal::range_result(__r, std::search_n(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __count, __value));
+}
+
+// [alg.copy]
+// The algorithms below write one element per element of the input, of the prefix of the input that fits
+// in the output.
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    return internal::range_copy(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), std::forward<_Output>(__result),
+        views::is_view<_Range>());
+}
+
+// copy_if writes at most one element per element of the input; if they do not all fit in the output,
+// counting the selected ones first tells whether the parallel algorithm may run.
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+copy_if(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _Predicate __pred) {
+    typedef internal::output_access_t<_Output> _Out;
+    auto __first = internal::range_first(__r);
+    auto __last = internal::range_last(__r);
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r) <= __cap ||
+        std::count_if(__exec, __first, __last, __pred) <= __cap)
+        return _Out::result(__result, std::copy_if(std::forward<_ExecutionPolicy>(__exec), __first, __last, _Out::first(__result),
+            __pred));
+    return _Out::result(__result, std::copy_if(__first, __last,
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __pred).base());
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+move(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::move(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result)));
+}
+
+// [alg.swap]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range2>>
+swap_ranges(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2) {
+    return internal::range_result(__r2, std::swap_ranges(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+        internal::range_last(__r1, internal::range_size(__r2)), internal::range_first(__r2)));
+}
+
+// [alg.transform]
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _UnaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+transform(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _UnaryOperation __op) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::transform(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __op));
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output, class _BinaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+transform(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result, _BinaryOperation __op) {
+    typedef internal::output_access_t<_Output> _Out;
+    const std::ptrdiff_t __n = std::min<std::ptrdiff_t>(internal::range_size(__r2), _Out::capacity(__result));
+    return _Out::result(__result, std::transform(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+        internal::range_last(__r1, __n), internal::range_first(__r2), _Out::first(__result), __op));
+}
+
+// [alg.replace]
+
+template<class _ExecutionPolicy, class _Range, class _UnaryPredicate, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+replace_if(_ExecutionPolicy&& __exec, _Range&& __r, _UnaryPredicate __pred, const _Tp& __new_value) {
+    std::replace_if(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __pred,
+        __new_value);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+replace(_ExecutionPolicy&& __exec, _Range&& __r, const _Tp& __old_value, const _Tp& __new_value) {
+    std::replace(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __old_value,
+        __new_value);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _UnaryPredicate, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+replace_copy_if(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _UnaryPredicate __pred, const _Tp& __new_value) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::replace_copy_if(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __pred, __new_value));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+replace_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, const _Tp& __old_value, const _Tp& __new_value) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::replace_copy(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __old_value, __new_value));
+}
+
+// [alg.fill]
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+fill(_ExecutionPolicy&& __exec, _Range&& __r, const _Tp& __value) {
+    std::fill(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __value);
+}
+
+// [alg.generate]
+
+template<class _ExecutionPolicy, class _Range, class _Generator>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+generate(_ExecutionPolicy&& __exec, _Range&& __r, _Generator __g) {
+    std::generate(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __g);
+}
+
+// [alg.remove]
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _Predicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+remove_copy_if(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _Predicate __pred) {
+    typedef internal::output_access_t<_Output> _Out;
+    auto __first = internal::range_first(__r);
+    auto __last = internal::range_last(__r);
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r) <= __cap ||
+        internal::range_size(__r) - std::count_if(__exec, __first, __last, __pred) <= __cap)
+        return _Out::result(__result, std::remove_copy_if(std::forward<_ExecutionPolicy>(__exec), __first, __last,
+            _Out::first(__result), __pred));
+    return _Out::result(__result, std::remove_copy_if(__first, __last,
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __pred).base());
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+remove_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, const _Tp& __value) {
+    typedef internal::output_access_t<_Output> _Out;
+    auto __first = internal::range_first(__r);
+    auto __last = internal::range_last(__r);
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r) <= __cap ||
+        internal::range_size(__r) - std::count(__exec, __first, __last, __value) <= __cap)
+        return _Out::result(__result, std::remove_copy(std::forward<_ExecutionPolicy>(__exec), __first, __last,
+            _Out::first(__result), __value));
+    return _Out::result(__result, std::remove_copy(__first, __last,
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __value).base());
+}
+
+template<class _ExecutionPolicy, class _Range, class _UnaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+remove_if(_ExecutionPolicy&& __exec, _Range&& __r, _UnaryPredicate __pred) {
+    return internal::range_result(__r, std::remove_if(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+remove(_ExecutionPolicy&& __exec, _Range&& __r, const _Tp& __value) {
+    return internal::range_result(__r, std::remove(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __value));
+}
+
+// [alg.unique]
+
+template<class _ExecutionPolicy, class _Range, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+unique(_ExecutionPolicy&& __exec, _Range&& __r, _BinaryPredicate __pred) {
+    return internal::range_result(__r, std::unique(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+unique(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return internal::range_result(__r, std::unique(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _BinaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+unique_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _BinaryPredicate __pred) {
+    typedef internal::output_access_t<_Output> _Out;
+    auto __first = internal::range_first(__r);
+    auto __last = internal::range_last(__r);
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r) <= __cap)
+        return _Out::result(__result, std::unique_copy(std::forward<_ExecutionPolicy>(__exec), __first, __last,
+            _Out::first(__result), __pred));
+    return _Out::result(__result, std::unique_copy(__first, __last,
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __pred).base());
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+unique_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    return ranges::unique_copy(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), std::forward<_Output>(__result),
+        internal::pstl_equal());
+}
+
+// [alg.reverse]
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+reverse(_ExecutionPolicy&& __exec, _Range&& __r) {
+    std::reverse(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+reverse_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    typedef internal::output_access_t<_Output> _Out;
+    auto __first = internal::range_first(__r);
+    auto __last = internal::range_last(__r);
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    // The first elements of the output are the last ones of the input
+    if (__cap != std::numeric_limits<std::ptrdiff_t>::max() && __cap < internal::range_size(__r))
+        __first = std::prev(__last, __cap);
+    return _Out::result(__result, std::reverse_copy(std::forward<_ExecutionPolicy>(__exec), __first, __last,
+        _Out::first(__result)));
+}
+
+// [alg.rotate]
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+rotate(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __middle) {
+    return internal::range_result(__r, std::rotate(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_inner(__r, __middle), internal::range_last(__r)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+rotate_copy(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __middle, _Output&& __result) {
+    typedef internal::output_access_t<_Output> _Out;
+    auto __first = internal::range_first(__r);
+    auto __mid = internal::range_inner(__r, __middle);
+    auto __last = internal::range_last(__r);
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r) <= __cap)
+        return _Out::result(__result, std::rotate_copy(std::forward<_ExecutionPolicy>(__exec), __first, __mid, __last,
+            _Out::first(__result)));
+    // Only a prefix of the rotated sequence fits: [__middle, __last) and then the start of [__first, __middle)
+    const std::ptrdiff_t __n1 = std::min<std::ptrdiff_t>(std::distance(__mid, __last), __cap);
+    auto __out = std::copy(__exec, __mid, std::next(__mid, __n1), _Out::first(__result));
+    __out = std::copy(std::forward<_ExecutionPolicy>(__exec), __first, std::next(__first, __cap - __n1), __out);
+    return _Out::result(__result, __out);
+}
+
+// [alg.partitions]
+
+template<class _ExecutionPolicy, class _Range, class _UnaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+is_partitioned(_ExecutionPolicy&& __exec, _Range&& __r, _UnaryPredicate __pred) {
+    return std::is_partitioned(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r),
+        __pred);
+}
+
+template<class _ExecutionPolicy, class _Range, class _UnaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+partition(_ExecutionPolicy&& __exec, _Range&& __r, _UnaryPredicate __pred) {
+    return internal::range_result(__r, std::partition(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range, class _UnaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+stable_partition(_ExecutionPolicy&& __exec, _Range&& __r, _UnaryPredicate __pred) {
+    return internal::range_result(__r, std::stable_partition(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __pred));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output1, class _Output2, class _UnaryPredicate>
+internal::enable_if_execution_policy<_ExecutionPolicy,
+    std::pair<internal::output_iterator_t<_Output1>, internal::output_iterator_t<_Output2>>>
+partition_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output1&& __out_true, _Output2&& __out_false, _UnaryPredicate __pred) {
+    typedef internal::output_access_t<_Output1> _Out1;
+    typedef internal::output_access_t<_Output2> _Out2;
+    auto __first = internal::range_first(__r);
+    auto __last = internal::range_last(__r);
+    const std::ptrdiff_t __cap1 = _Out1::capacity(__out_true);
+    const std::ptrdiff_t __cap2 = _Out2::capacity(__out_false);
+    const std::ptrdiff_t __n = internal::range_size(__r);
+    bool __fits = __n <= __cap1 && __n <= __cap2;
+    if (!__fits) {
+        const std::ptrdiff_t __n_true = std::count_if(__exec, __first, __last, __pred);
+        __fits = __n_true <= __cap1 && __n - __n_true <= __cap2;
+    }
+    if (__fits) {
+        auto __res = std::partition_copy(std::forward<_ExecutionPolicy>(__exec), __first, __last, _Out1::first(__out_true),
+            _Out2::first(__out_false), __pred);
+        return std::make_pair(_Out1::result(__out_true, __res.first), _Out2::result(__out_false, __res.second));
+    }
+    auto __res = std::partition_copy(__first, __last,
+        internal::bounded_output_iterator<typename _Out1::brick_iterator>(_Out1::first(__out_true), __cap1),
+        internal::bounded_output_iterator<typename _Out2::brick_iterator>(_Out2::first(__out_false), __cap2), __pred);
+    return std::make_pair(_Out1::result(__out_true, __res.first.base()), _Out2::result(__out_false, __res.second.base()));
+}
+
+// [alg.sort]
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+sort(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    std::sort(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+sort(_ExecutionPolicy&& __exec, _Range&& __r) {
+    std::sort(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+// [stable.sort]
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+stable_sort(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    std::stable_sort(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+stable_sort(_ExecutionPolicy&& __exec, _Range&& __r) {
+    std::stable_sort(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+// [partial.sort]
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+partial_sort(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __middle, _Compare __comp) {
+    std::partial_sort(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_inner(__r, __middle),
+        internal::range_last(__r), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+partial_sort(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __middle) {
+    std::partial_sort(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_inner(__r, __middle),
+        internal::range_last(__r));
+}
+
+// [is.sorted]
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+is_sorted_until(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    return internal::range_result(__r, std::is_sorted_until(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __comp));
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+is_sorted_until(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return internal::range_result(__r, std::is_sorted_until(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+is_sorted(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    return std::is_sorted(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+is_sorted(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return std::is_sorted(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+// [alg.nth.element]
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+nth_element(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __nth, _Compare __comp) {
+    std::nth_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_inner(__r, __nth),
+        internal::range_last(__r), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+nth_element(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __nth) {
+    std::nth_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_inner(__r, __nth),
+        internal::range_last(__r));
+}
+
+// [alg.merge]
+// merge and the set operations write at most the sum of the lengths of their inputs (set_intersection:
+// the smaller one, set_difference: the first one).
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+merge(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result, _Compare __comp) {
+    typedef internal::output_access_t<_Output> _Out;
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r1) + internal::range_size(__r2) <= __cap)
+        return _Out::result(__result, std::merge(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+            internal::range_last(__r1), internal::range_first(__r2), internal::range_last(__r2), _Out::first(__result), __comp));
+    return _Out::result(__result, std::merge(internal::range_first(__r1), internal::range_last(__r1), internal::range_first(__r2),
+        internal::range_last(__r2), internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap),
+        __comp).base());
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+merge(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result) {
+    return ranges::merge(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range1>(__r1), std::forward<_Range2>(__r2),
+        std::forward<_Output>(__result), internal::pstl_less());
+}
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+inplace_merge(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __middle, _Compare __comp) {
+    std::inplace_merge(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_inner(__r, __middle),
+        internal::range_last(__r), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+inplace_merge(_ExecutionPolicy&& __exec, _Range&& __r, internal::range_iterator_t<_Range> __middle) {
+    std::inplace_merge(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_inner(__r, __middle),
+        internal::range_last(__r));
+}
+
+// [includes]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+includes(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Compare __comp) {
+    return std::includes(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+includes(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2) {
+    return std::includes(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2));
+}
+// [set.union]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_union(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result, _Compare __comp) {
+    typedef internal::output_access_t<_Output> _Out;
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r1) + internal::range_size(__r2) <= __cap)
+        return _Out::result(__result, std::set_union(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+            internal::range_last(__r1), internal::range_first(__r2), internal::range_last(__r2), _Out::first(__result), __comp));
+    return _Out::result(__result, std::set_union(internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2),
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __comp).base());
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_union(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result) {
+    return ranges::set_union(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range1>(__r1), std::forward<_Range2>(__r2),
+        std::forward<_Output>(__result), internal::pstl_less());
+}
+
+// [set.intersection]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_intersection(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result, _Compare __comp) {
+    typedef internal::output_access_t<_Output> _Out;
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || std::min(internal::range_size(__r1), internal::range_size(__r2)) <= __cap)
+        return _Out::result(__result, std::set_intersection(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+            internal::range_last(__r1), internal::range_first(__r2), internal::range_last(__r2), _Out::first(__result), __comp));
+    return _Out::result(__result, std::set_intersection(internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2),
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __comp).base());
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_intersection(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result) {
+    return ranges::set_intersection(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range1>(__r1), std::forward<_Range2>(__r2),
+        std::forward<_Output>(__result), internal::pstl_less());
+}
+
+// [set.difference]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_difference(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result, _Compare __comp) {
+    typedef internal::output_access_t<_Output> _Out;
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r1) <= __cap)
+        return _Out::result(__result, std::set_difference(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+            internal::range_last(__r1), internal::range_first(__r2), internal::range_last(__r2), _Out::first(__result), __comp));
+    return _Out::result(__result, std::set_difference(internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2),
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __comp).base());
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_difference(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result) {
+    return ranges::set_difference(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range1>(__r1), std::forward<_Range2>(__r2),
+        std::forward<_Output>(__result), internal::pstl_less());
+}
+
+// [set.symmetric.difference]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_symmetric_difference(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result, _Compare __comp) {
+    typedef internal::output_access_t<_Output> _Out;
+    const std::ptrdiff_t __cap = _Out::capacity(__result);
+    if (__cap == std::numeric_limits<std::ptrdiff_t>::max() || internal::range_size(__r1) + internal::range_size(__r2) <= __cap)
+        return _Out::result(__result, std::set_symmetric_difference(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+            internal::range_last(__r1), internal::range_first(__r2), internal::range_last(__r2), _Out::first(__result), __comp));
+    return _Out::result(__result, std::set_symmetric_difference(internal::range_first(__r1), internal::range_last(__r1),
+        internal::range_first(__r2), internal::range_last(__r2),
+        internal::bounded_output_iterator<typename _Out::brick_iterator>(_Out::first(__result), __cap), __comp).base());
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+set_symmetric_difference(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Output&& __result) {
+    return ranges::set_symmetric_difference(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range1>(__r1), std::forward<_Range2>(__r2),
+        std::forward<_Output>(__result), internal::pstl_less());
+}
+
+// [is.heap]
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+is_heap_until(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    return internal::range_result(__r, std::is_heap_until(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __comp));
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+is_heap_until(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return internal::range_result(__r, std::is_heap_until(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+is_heap(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    return std::is_heap(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+is_heap(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return std::is_heap(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+// [alg.min.max]
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+min_element(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    return internal::range_result(__r, std::min_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __comp));
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+min_element(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return internal::range_result(__r, std::min_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+max_element(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    return internal::range_result(__r, std::max_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r), __comp));
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::range_iterator_t<_Range>>
+max_element(_ExecutionPolicy&& __exec, _Range&& __r) {
+    return internal::range_result(__r, std::max_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, std::pair<internal::range_iterator_t<_Range>, internal::range_iterator_t<_Range>>>
+minmax_element(_ExecutionPolicy&& __exec, _Range&& __r, _Compare __comp) {
+    auto __res = std::minmax_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r),
+        __comp);
+    return std::make_pair(internal::range_result(__r, __res.first), internal::range_result(__r, __res.second));
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, std::pair<internal::range_iterator_t<_Range>, internal::range_iterator_t<_Range>>>
+minmax_element(_ExecutionPolicy&& __exec, _Range&& __r) {
+    auto __res = std::minmax_element(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+    return std::make_pair(internal::range_result(__r, __res.first), internal::range_result(__r, __res.second));
+}
+
+// [alg.lex.comparison]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Compare>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+lexicographical_compare(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Compare __comp) {
+    return std::lexicographical_compare(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+        internal::range_last(__r1), internal::range_first(__r2), internal::range_last(__r2), __comp);
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2>
+internal::enable_if_execution_policy<_ExecutionPolicy, bool>
+lexicographical_compare(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2) {
+    return std::lexicographical_compare(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+        internal::range_last(__r1), internal::range_first(__r2), internal::range_last(__r2));
+}
+
+// [reduce]
+
+template<class _ExecutionPolicy, class _Range, class _Tp, class _BinaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, _Tp>
+reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init, _BinaryOperation __binary_op) {
+    return internal::range_reduce(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __init, __binary_op,
+        views::is_view<_Range>());
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, _Tp>
+reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init) {
+    return ranges::reduce(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __init, std::plus<_Tp>());
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, typename std::iterator_traits<internal::range_iterator_t<_Range>>::value_type>
+reduce(_ExecutionPolicy&& __exec, _Range&& __r) {
+    typedef typename std::iterator_traits<internal::range_iterator_t<_Range>>::value_type _ValueType;
+    return ranges::reduce(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), _ValueType{}, std::plus<_ValueType>());
+}
+
+// [transform.reduce]
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Tp, class _BinaryOperation1, class _BinaryOperation2>
+internal::enable_if_execution_policy<_ExecutionPolicy, _Tp>
+transform_reduce(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Tp __init, _BinaryOperation1 __binary_op1,
+                 _BinaryOperation2 __binary_op2) {
+    return std::transform_reduce(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+        internal::range_last(__r1, internal::range_size(__r2)), internal::range_first(__r2), __init, __binary_op1, __binary_op2);
+}
+
+template<class _ExecutionPolicy, class _Range1, class _Range2, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, _Tp>
+transform_reduce(_ExecutionPolicy&& __exec, _Range1&& __r1, _Range2&& __r2, _Tp __init) {
+    return std::transform_reduce(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r1),
+        internal::range_last(__r1, internal::range_size(__r2)), internal::range_first(__r2), __init);
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp, class _BinaryOperation, class _UnaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, _Tp>
+transform_reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init, _BinaryOperation __binary_op, _UnaryOperation __unary_op) {
+    return internal::range_transform_reduce(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __init, __binary_op,
+        __unary_op, views::is_view<_Range>());
+}
+
+// [exclusive.scan]
+// A prefix of a scan is the scan of the prefix of the input: a bounded output receives the scan of the
+// elements that fit.
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+exclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _Tp __init) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::exclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __init));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _Tp, class _BinaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+exclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _Tp __init, _BinaryOperation __binary_op) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::exclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __init, __binary_op));
+}
+
+// [inclusive.scan]
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+inclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::inclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result)));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _BinaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+inclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _BinaryOperation __binary_op) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::inclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __binary_op));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _BinaryOperation, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+inclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _BinaryOperation __binary_op, _Tp __init) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::inclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __binary_op, __init));
+}
+
+// [transform.exclusive.scan]
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _Tp, class _BinaryOperation, class _UnaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+transform_exclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _Tp __init, _BinaryOperation __binary_op,
+                         _UnaryOperation __unary_op) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::transform_exclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __init, __binary_op, __unary_op));
+}
+
+// [transform.inclusive.scan]
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _BinaryOperation, class _UnaryOperation, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+transform_inclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _BinaryOperation __binary_op,
+                         _UnaryOperation __unary_op, _Tp __init) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::transform_inclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __binary_op, __unary_op, __init));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _BinaryOperation, class _UnaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+transform_inclusive_scan(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _BinaryOperation __binary_op,
+                         _UnaryOperation __unary_op) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::transform_inclusive_scan(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __binary_op, __unary_op));
+}
+
+// [adjacent.difference]
+
+template<class _ExecutionPolicy, class _Range, class _Output, class _BinaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+adjacent_difference(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result, _BinaryOperation __op) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::adjacent_difference(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result), __op));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+adjacent_difference(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::adjacent_difference(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result)));
+}
+
+// [uninitialized.copy]
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+uninitialized_copy(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::uninitialized_copy(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result)));
+}
+
+// [uninitialized.move]
+
+template<class _ExecutionPolicy, class _Range, class _Output>
+internal::enable_if_execution_policy<_ExecutionPolicy, internal::output_iterator_t<_Output>>
+uninitialized_move(_ExecutionPolicy&& __exec, _Range&& __r, _Output&& __result) {
+    typedef internal::output_access_t<_Output> _Out;
+    return _Out::result(__result, std::uninitialized_move(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r),
+        internal::range_last(__r, _Out::capacity(__result)), _Out::first(__result)));
+}
+
+// [uninitialized.fill]
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+uninitialized_fill(_ExecutionPolicy&& __exec, _Range&& __r, const _Tp& __value) {
+    std::uninitialized_fill(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r), __value);
+}
+
+// [specialized.destroy]
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+destroy(_ExecutionPolicy&& __exec, _Range&& __r) {
+    std::destroy(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+// [uninitialized.construct.default]
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+uninitialized_default_construct(_ExecutionPolicy&& __exec, _Range&& __r) {
+    std::uninitialized_default_construct(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+// [uninitialized.construct.value]
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+uninitialized_value_construct(_ExecutionPolicy&& __exec, _Range&& __r) {
+    std::uninitialized_value_construct(std::forward<_ExecutionPolicy>(__exec), internal::range_first(__r), internal::range_last(__r));
+}
+
+} // namespace ranges
+} // namespace __pstl
+
+#endif /* __PSTL_ranges_H */
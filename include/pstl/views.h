@@ -0,0 +1,337 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+#ifndef __PSTL_views_H
+#define __PSTL_views_H
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "internal/pstl_config.h"
+#include "internal/execution_defs.h"
+#include "iterators.h"
+#include "internal/views_impl.h"
+
+// Lazy views over random access sequences and the algorithms that execute them fused, in a single pass
+// without intermediate buffers. A view describes its elements by position 0, ..., size() - 1 of the
+// underlying sequence:
+//   - __visit(__i, __sink) passes the element at __i to __sink, unless a filter drops it, and returns false
+//     if the element ends the view (take_while);
+//   - dense views (no filter or take_while) have operator[] and begin()/end(), so that the usual
+//     algorithms accept them as random access sequences.
+
+namespace __pstl {
+namespace views {
+
+//! Base class of the views
+struct view_base {};
+
+template<typename _Tp>
+struct is_view : std::is_base_of<view_base, typename std::decay<_Tp>::type> {};
+
+template<typename _View>
+class view_subscript;
+
+//! begin() and end() of dense views: counting iterators transformed by the subscript of the view
+template<typename _View, bool _Dense = true>
+class view_iterators {
+public:
+    typedef transform_iterator<counting_iterator<std::ptrdiff_t>, view_subscript<_View>> iterator;
+
+    iterator begin() const { return iterator(counting_iterator<std::ptrdiff_t>(0), view_subscript<_View>(__self())); }
+    iterator end() const {
+        return iterator(counting_iterator<std::ptrdiff_t>(__self().size()), view_subscript<_View>(__self()));
+    }
+
+private:
+    const _View& __self() const { return static_cast<const _View&>(*this); }
+};
+
+template<typename _View>
+class view_iterators<_View, false> {};
+
+//! View of the elements of [__first, __last)
+template<typename _Iter>
+class iterator_view : public view_base, public view_iterators<iterator_view<_Iter>> {
+public:
+    typedef std::ptrdiff_t difference_type;
+    typedef typename std::iterator_traits<_Iter>::reference reference;
+    static const bool is_dense = true;
+    static const bool has_stop = false;
+
+    iterator_view(_Iter __first, _Iter __last) : _M_first(__first), _M_n(__last - __first) {}
+
+    difference_type size() const { return _M_n; }
+    reference operator[](difference_type __i) const { return _M_first[__i]; }
+
+    template<typename _Sink>
+    bool __visit(difference_type __i, _Sink& __sink) const {
+        __sink(_M_first[__i]);
+        return true;
+    }
+
+private:
+    _Iter _M_first;
+    difference_type _M_n;
+};
+
+//! View of __f(__x) for the elements __x of a view
+template<typename _View, typename _Fp>
+class transform_view : public view_base, public view_iterators<transform_view<_View, _Fp>, _View::is_dense> {
+public:
+    typedef std::ptrdiff_t difference_type;
+    typedef decltype(std::declval<const _Fp&>()(std::declval<typename _View::reference>())) reference;
+    static const bool is_dense = _View::is_dense;
+    static const bool has_stop = _View::has_stop;
+
+    transform_view(const _View& __base, _Fp __f) : _M_base(__base), _M_f(__f) {}
+
+    difference_type size() const { return _M_base.size(); }
+    reference operator[](difference_type __i) const { return _M_f(_M_base[__i]); }
+
+    template<typename _Sink>
+    bool __visit(difference_type __i, _Sink& __sink) const {
+        internal::transform_sink<_Fp, _Sink> __s{_M_f, __sink};
+        return _M_base.__visit(__i, __s);
+    }
+
+private:
+    _View _M_base;
+    _Fp _M_f;
+};
+
+//! View of the elements of a view that satisfy __pred
+template<typename _View, typename _Predicate>
+class filter_view : public view_base {
+public:
+    typedef std::ptrdiff_t difference_type;
+    typedef typename _View::reference reference;
+    static const bool is_dense = false;
+    static const bool has_stop = _View::has_stop;
+
+    filter_view(const _View& __base, _Predicate __pred) : _M_base(__base), _M_pred(__pred) {}
+
+    difference_type size() const { return _M_base.size(); }
+
+    template<typename _Sink>
+    bool __visit(difference_type __i, _Sink& __sink) const {
+        internal::filter_sink<_Predicate, _Sink> __s{_M_pred, __sink};
+        return _M_base.__visit(__i, __s);
+    }
+
+private:
+    _View _M_base;
+    _Predicate _M_pred;
+};
+
+//! View of the elements of a view up to the first one that does not satisfy __pred
+template<typename _View, typename _Predicate>
+class take_while_view : public view_base {
+public:
+    typedef std::ptrdiff_t difference_type;
+    typedef typename _View::reference reference;
+    static const bool is_dense = false;
+    static const bool has_stop = true;
+
+    take_while_view(const _View& __base, _Predicate __pred) : _M_base(__base), _M_pred(__pred) {}
+
+    difference_type size() const { return _M_base.size(); }
+
+    template<typename _Sink>
+    bool __visit(difference_type __i, _Sink& __sink) const {
+        bool __go = true;
+        internal::take_while_sink<_Predicate, _Sink> __s{_M_pred, __sink, __go};
+        return _M_base.__visit(__i, __s) && __go;
+    }
+
+private:
+    _View _M_base;
+    _Predicate _M_pred;
+};
+
+//! View of the tuples of the elements at the same position of dense views; as long as the shortest one
+template<typename... _Views>
+class zip_view : public view_base, public view_iterators<zip_view<_Views...>> {
+    static_assert(internal::all_dense<_Views...>::value, "zip_view requires dense views");
+    typedef typename internal::make_tuple_indices<sizeof...(_Views)>::type __indices;
+public:
+    typedef std::ptrdiff_t difference_type;
+    typedef std::tuple<typename _Views::reference...> reference;
+    static const bool is_dense = true;
+    static const bool has_stop = false;
+
+    explicit zip_view(const _Views&... __views) : _M_views(__views...), _M_n(internal::min_size(__views...)) {}
+
+    difference_type size() const { return _M_n; }
+    reference operator[](difference_type __i) const { return this->__at(__i, __indices()); }
+
+    template<typename _Sink>
+    bool __visit(difference_type __i, _Sink& __sink) const {
+        __sink((*this)[__i]);
+        return true;
+    }
+
+private:
+    template<std::size_t... _Ip>
+    reference __at(difference_type __i, internal::tuple_indices<_Ip...>) const {
+        return reference(std::get<_Ip>(_M_views)[__i]...);
+    }
+
+    std::tuple<_Views...> _M_views;
+    difference_type _M_n;
+};
+
+//! View of the tuples (position, element) of a dense view
+template<typename _View>
+class enumerate_view : public view_base, public view_iterators<enumerate_view<_View>> {
+    static_assert(_View::is_dense, "enumerate_view requires a dense view");
+public:
+    typedef std::ptrdiff_t difference_type;
+    typedef std::tuple<difference_type, typename _View::reference> reference;
+    static const bool is_dense = true;
+    static const bool has_stop = false;
+
+    explicit enumerate_view(const _View& __base) : _M_base(__base) {}
+
+    difference_type size() const { return _M_base.size(); }
+    reference operator[](difference_type __i) const { return reference(__i, _M_base[__i]); }
+
+    template<typename _Sink>
+    bool __visit(difference_type __i, _Sink& __sink) const {
+        __sink((*this)[__i]);
+        return true;
+    }
+
+private:
+    _View _M_base;
+};
+
+//! Function object returning the element at a position of a dense view
+template<typename _View>
+class view_subscript {
+public:
+    explicit view_subscript(const _View& __view) : _M_view(__view) {}
+    typename _View::reference operator()(std::ptrdiff_t __i) const { return _M_view[__i]; }
+
+private:
+    _View _M_view;
+};
+
+//! The view of a range: views are kept, containers and arrays are viewed as [begin, end)
+template<typename _Range, bool = is_view<_Range>::value>
+struct view_of {
+    typedef typename std::decay<_Range>::type type;
+    static type make(const type& __view) { return __view; }
+};
+
+template<typename _Range>
+struct view_of<_Range, false> {
+    typedef iterator_view<decltype(std::begin(std::declval<_Range&>()))> type;
+    static type make(_Range& __r) { return type(std::begin(__r), std::end(__r)); }
+};
+
+template<typename _Iter>
+iterator_view<_Iter> all(_Iter __first, _Iter __last) {
+    return iterator_view<_Iter>(__first, __last);
+}
+
+template<typename _Range>
+typename view_of<_Range>::type all(_Range&& __r) {
+    static_assert(is_view<_Range>::value || std::is_lvalue_reference<_Range>::value, "a temporary container cannot be viewed");
+    return view_of<_Range>::make(__r);
+}
+
+template<typename _Range, typename _Fp>
+transform_view<typename view_of<_Range>::type, _Fp> transform(_Range&& __r, _Fp __f) {
+    return transform_view<typename view_of<_Range>::type, _Fp>(views::all(std::forward<_Range>(__r)), __f);
+}
+
+template<typename _Range, typename _Predicate>
+filter_view<typename view_of<_Range>::type, _Predicate> filter(_Range&& __r, _Predicate __pred) {
+    return filter_view<typename view_of<_Range>::type, _Predicate>(views::all(std::forward<_Range>(__r)), __pred);
+}
+
+template<typename _Range, typename _Predicate>
+take_while_view<typename view_of<_Range>::type, _Predicate> take_while(_Range&& __r, _Predicate __pred) {
+    return take_while_view<typename view_of<_Range>::type, _Predicate>(views::all(std::forward<_Range>(__r)), __pred);
+}
+
+template<typename... _Ranges>
+zip_view<typename view_of<_Ranges>::type...> zip(_Ranges&&... __r) {
+    return zip_view<typename view_of<_Ranges>::type...>(views::all(std::forward<_Ranges>(__r))...);
+}
+
+template<typename _Range>
+enumerate_view<typename view_of<_Range>::type> enumerate(_Range&& __r) {
+    return enumerate_view<typename view_of<_Range>::type>(views::all(std::forward<_Range>(__r)));
+}
+
+// [views.algorithms]
+// The algorithms pass each element of the view through its whole chain of adaptors before the next one,
+// within a single parallel traversal. A view with take_while is first cut at its end.
+
+template<class _ExecutionPolicy, class _Range, class _Function>
+internal::enable_if_execution_policy<_ExecutionPolicy, void>
+for_each(_ExecutionPolicy&& __exec, _Range&& __r, _Function __f) {
+    typedef counting_iterator<std::ptrdiff_t> _Index;
+    internal::pattern_view_for_each(views::all(std::forward<_Range>(__r)), __f,
+        internal::is_vectorization_preferred<_ExecutionPolicy, _Index>(__exec),
+        internal::is_parallelization_preferred<_ExecutionPolicy, _Index>(__exec));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp, class _BinaryOperation>
+internal::enable_if_execution_policy<_ExecutionPolicy, _Tp>
+reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init, _BinaryOperation __binary_op) {
+    typedef counting_iterator<std::ptrdiff_t> _Index;
+    return internal::pattern_view_reduce(views::all(std::forward<_Range>(__r)), __init, __binary_op,
+        internal::is_vectorization_preferred<_ExecutionPolicy, _Index>(__exec),
+        internal::is_parallelization_preferred<_ExecutionPolicy, _Index>(__exec));
+}
+
+template<class _ExecutionPolicy, class _Range, class _Tp>
+internal::enable_if_execution_policy<_ExecutionPolicy, _Tp>
+reduce(_ExecutionPolicy&& __exec, _Range&& __r, _Tp __init) {
+    return views::reduce(std::forward<_ExecutionPolicy>(__exec), std::forward<_Range>(__r), __init, std::plus<_Tp>());
+}
+
+template<class _ExecutionPolicy, class _Range>
+internal::enable_if_execution_policy<_ExecutionPolicy, std::ptrdiff_t>
+count(_ExecutionPolicy&& __exec, _Range&& __r) {
+    typedef counting_iterator<std::ptrdiff_t> _Index;
+    return internal::pattern_view_count(views::all(std::forward<_Range>(__r)),
+        internal::is_vectorization_preferred<_ExecutionPolicy, _Index>(__exec),
+        internal::is_parallelization_preferred<_ExecutionPolicy, _Index>(__exec));
+}
+
+template<class _ExecutionPolicy, class _Range, class _OutputIterator>
+internal::enable_if_execution_policy<_ExecutionPolicy, _OutputIterator>
+copy(_ExecutionPolicy&& __exec, _Range&& __r, _OutputIterator __result) {
+    typedef counting_iterator<std::ptrdiff_t> _Index;
+    return internal::pattern_view_copy(views::all(std::forward<_Range>(__r)), __result,
+        internal::is_vectorization_preferred<_ExecutionPolicy, _Index, _OutputIterator>(__exec),
+        internal::is_parallelization_preferred<_ExecutionPolicy, _Index, _OutputIterator>(__exec));
+}
+
+} // namespace views
+} // namespace __pstl
+
+#endif /* __PSTL_views_H */
@@ -0,0 +1,144 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+
+// Tests for the parallel algorithms over forward and bidirectional ranges (std::forward_list, std::list)
+#include "pstl_test_config.h"
+
+#include <forward_list>
+#include <list>
+#include <vector>
+
+#include "pstl/execution"
+#include "pstl/algorithm"
+#include "pstl/numeric"
+#include "utils.h"
+
+using namespace TestUtils;
+
+template<typename T>
+struct Gen {
+    T operator()(std::size_t k) const { return T(k % 7 == 3 ? 1 : 3 * k % 101); }
+};
+
+struct test_non_modifying {
+    template<typename Policy, typename Container>
+    void operator()(Policy&& exec, const Container& in, const std::vector<typename Container::value_type>& expected) {
+        typedef typename Container::value_type T;
+        const T last_value = expected.empty() ? T(-1) : expected.back();
+        auto is_one = [](T x) { return x == T(1); };
+        auto is_small = [](T x) { return x < T(101); };
+
+        EXPECT_TRUE(std::any_of(expected.begin(), expected.end(), is_one) == std::any_of(exec, in.begin(), in.end(), is_one),
+            "wrong result from any_of");
+        EXPECT_TRUE(std::all_of(expected.begin(), expected.end(), is_small) == std::all_of(exec, in.begin(), in.end(), is_small),
+            "wrong result from all_of");
+        EXPECT_TRUE(std::none_of(expected.begin(), expected.end(), is_one) == std::none_of(exec, in.begin(), in.end(), is_one),
+            "wrong result from none_of");
+
+        // The positions found must be those in the reference
+        EXPECT_TRUE(std::distance(expected.begin(), std::find(expected.begin(), expected.end(), last_value)) ==
+            std::distance(in.begin(), std::find(exec, in.begin(), in.end(), last_value)), "wrong result from find");
+        EXPECT_TRUE(std::distance(expected.begin(), std::find_if(expected.begin(), expected.end(), is_one)) ==
+            std::distance(in.begin(), std::find_if(exec, in.begin(), in.end(), is_one)), "wrong result from find_if");
+        EXPECT_TRUE(std::distance(expected.begin(), std::find_if_not(expected.begin(), expected.end(), is_one)) ==
+            std::distance(in.begin(), std::find_if_not(exec, in.begin(), in.end(), is_one)), "wrong result from find_if_not");
+
+        EXPECT_TRUE(std::count(expected.begin(), expected.end(), T(1)) == std::count(exec, in.begin(), in.end(), T(1)),
+            "wrong result from count");
+        EXPECT_TRUE(std::count_if(expected.begin(), expected.end(), is_small) == std::count_if(exec, in.begin(), in.end(), is_small),
+            "wrong result from count_if");
+
+        EXPECT_TRUE(std::accumulate(expected.begin(), expected.end(), T(0)) == std::reduce(exec, in.begin(), in.end(), T(0)),
+            "wrong result from reduce");
+        EXPECT_TRUE(std::accumulate(expected.begin(), expected.end(), T(0), [](T a, T x) { return a + 2 * x; }) ==
+            std::transform_reduce(exec, in.begin(), in.end(), T(0), std::plus<T>(), [](T x) { return 2 * x; }),
+            "wrong result from transform_reduce");
+    }
+};
+
+struct test_modifying {
+    template<typename Policy, typename Container>
+    void operator()(Policy&& exec, Container& inout) {
+        typedef typename Container::value_type T;
+        std::vector<T> expected(inout.begin(), inout.end());
+
+        std::for_each(expected.begin(), expected.end(), [](T& x) { x += T(1); });
+        std::for_each(exec, inout.begin(), inout.end(), [](T& x) { x += T(1); });
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), inout.begin()), "wrong effect from for_each");
+
+        std::replace(expected.begin(), expected.end(), T(2), T(5));
+        std::replace(exec, inout.begin(), inout.end(), T(2), T(5));
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), inout.begin()), "wrong effect from replace");
+
+        auto is_odd = [](T x) { return x % 2 != 0; };
+        std::replace_if(expected.begin(), expected.end(), is_odd, T(0));
+        std::replace_if(exec, inout.begin(), inout.end(), is_odd, T(0));
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), inout.begin()), "wrong effect from replace_if");
+
+        // In place, and into a range of another kind
+        auto op = [](T x) { return 3 * x + 1; };
+        std::transform(expected.begin(), expected.end(), expected.begin(), op);
+        std::transform(exec, inout.begin(), inout.end(), inout.begin(), op);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), inout.begin()), "wrong effect from transform");
+
+        std::list<T> out(expected.size());
+        std::transform(exec, inout.begin(), inout.end(), out.begin(), op);
+        std::transform(expected.begin(), expected.end(), expected.begin(), op);
+        EXPECT_TRUE(std::equal(expected.begin(), expected.end(), out.begin()), "wrong effect from transform into a list");
+    }
+};
+
+template<typename Op, typename... T>
+void invoke_on_all_forward_policies(Op op, T&&... rest) {
+    using namespace pstl::execution;
+
+    op(seq, std::forward<T>(rest)...);
+    op(unseq, std::forward<T>(rest)...);
+#if __PSTL_USE_PAR_POLICIES
+    op(par, std::forward<T>(rest)...);
+    op(par_unseq, std::forward<T>(rest)...);
+#endif
+}
+
+template<typename T>
+void test() {
+    // Past 2*__PSTL_FORWARD_CHECKPOINTS elements the checkpoint stride doubles
+    for (size_t n = 0; n <= 100000; n = n <= 16 ? n + 1 : size_t(3.1415 * n)) {
+        Sequence<T> in(n, Gen<T>());
+        const std::vector<T> expected(in.begin(), in.end());
+
+        const std::forward_list<T> flist(expected.begin(), expected.end());
+        const std::list<T> list(expected.begin(), expected.end());
+        invoke_on_all_forward_policies(test_non_modifying(), flist, expected);
+        invoke_on_all_forward_policies(test_non_modifying(), list, expected);
+
+        std::forward_list<T> flist_inout(expected.begin(), expected.end());
+        std::list<T> list_inout(expected.begin(), expected.end());
+        invoke_on_all_forward_policies(test_modifying(), flist_inout);
+        invoke_on_all_forward_policies(test_modifying(), list_inout);
+    }
+}
+
+int32_t main() {
+    test<int32_t>();
+    test<int64_t>();
+    std::cout << done() << std::endl;
+    return 0;
+}
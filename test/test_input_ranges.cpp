@@ -0,0 +1,123 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+
+// Tests for the algorithms over single-pass input ranges (std::istream_iterator), pipelined under the parallel policies
+#include "pstl_test_config.h"
+
+#include <atomic>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "pstl/execution"
+#include "pstl/algorithm"
+#include "pstl/numeric"
+#include "utils.h"
+
+using namespace TestUtils;
+
+template<typename T>
+struct Gen {
+    T operator()(std::size_t k) const { return T(k % 7 == 3 ? -1 : 3 * k % 101); }
+};
+
+struct test_one_policy {
+    template<typename Policy, typename T>
+    void operator()(Policy&& exec, const std::string& text, const std::vector<T>& expected) {
+        typedef std::istream_iterator<T> Iterator;
+        auto is_negative = [](T x) { return x < T(0); };
+
+        {
+            std::istringstream in(text);
+            std::atomic<long long> sum(0);
+            std::for_each(exec, Iterator(in), Iterator(), [&sum](const T& x) { sum += (long long)x; });
+            EXPECT_TRUE(sum == std::accumulate(expected.begin(), expected.end(), 0LL), "wrong effect from for_each");
+        }
+        {
+            std::istringstream in(text);
+            EXPECT_TRUE(std::count(exec, Iterator(in), Iterator(), T(-1)) == std::count(expected.begin(), expected.end(), T(-1)),
+                "wrong result from count");
+        }
+        {
+            std::istringstream in(text);
+            EXPECT_TRUE(std::count_if(exec, Iterator(in), Iterator(), is_negative) ==
+                std::count_if(expected.begin(), expected.end(), is_negative), "wrong result from count_if");
+        }
+        {
+            std::istringstream in(text);
+            EXPECT_TRUE(std::reduce(exec, Iterator(in), Iterator(), T(1)) == std::accumulate(expected.begin(), expected.end(), T(1)),
+                "wrong result from reduce");
+        }
+        {
+            std::istringstream in(text);
+            EXPECT_TRUE(std::transform_reduce(exec, Iterator(in), Iterator(), T(0), std::plus<T>(), [](T x) { return 2 * x; }) ==
+                std::accumulate(expected.begin(), expected.end(), T(0), [](T a, T x) { return a + 2 * x; }),
+                "wrong result from transform_reduce");
+        }
+        {
+            // The output keeps the order of the input, into a random access and into a growable output
+            std::vector<T> expected_out;
+            std::copy_if(expected.begin(), expected.end(), std::back_inserter(expected_out), is_negative);
+
+            std::istringstream in(text);
+            std::vector<T> out(expected_out.size() + 1, T(7));
+            auto end = std::copy_if(exec, Iterator(in), Iterator(), out.begin(), is_negative);
+            EXPECT_TRUE(end - out.begin() == std::ptrdiff_t(expected_out.size()), "wrong result from copy_if");
+            EXPECT_TRUE(std::equal(expected_out.begin(), expected_out.end(), out.begin()) && out.back() == T(7),
+                "wrong effect from copy_if");
+
+            std::istringstream in2(text);
+            std::vector<T> grown(1, T(7));
+            std::copy_if(exec, Iterator(in2), Iterator(), std::back_inserter(grown), is_negative);
+            expected_out.insert(expected_out.begin(), T(7));
+            EXPECT_TRUE(grown == expected_out, "wrong effect from copy_if into a back_inserter");
+        }
+    }
+};
+
+template<typename T>
+void test() {
+    // Sizes around a batch of the pipeline, and past as many batches as may be in flight at once
+    const std::size_t batch = __PSTL_PIPELINE_BATCH;
+    const std::size_t sizes[] = {0, 1, 2, batch - 1, batch, batch + 1, batch * __PSTL_PIPELINE_TOKENS + 1,
+                                 batch * (__PSTL_PIPELINE_TOKENS + 2) + 7};
+    for (std::size_t n : sizes) {
+        Sequence<T> in(n, Gen<T>());
+        const std::vector<T> expected(in.begin(), in.end());
+        std::ostringstream text;
+        std::copy(expected.begin(), expected.end(), std::ostream_iterator<T>(text, " "));
+
+        using namespace pstl::execution;
+        test_one_policy()(seq, text.str(), expected);
+        test_one_policy()(unseq, text.str(), expected);
+#if __PSTL_USE_PAR_POLICIES
+        test_one_policy()(par, text.str(), expected);
+        test_one_policy()(par_unseq, text.str(), expected);
+#endif
+    }
+}
+
+int32_t main() {
+    test<int32_t>();
+    test<int64_t>();
+    std::cout << done() << std::endl;
+    return 0;
+}
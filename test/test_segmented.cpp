@@ -0,0 +1,127 @@
+/*
+    Copyright (c) 2017-2018 Intel Corporation
+
+    Licensed under the Apache License, Version 2.0 (the "License");
+    you may not use this file except in compliance with the License.
+    You may obtain a copy of the License at
+
+        http://www.apache.org/licenses/LICENSE-2.0
+
+    Unless required by applicable law or agreed to in writing, software
+    distributed under the License is distributed on an "AS IS" BASIS,
+    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+    See the License for the specific language governing permissions and
+    limitations under the License.
+
+
+
+
+*/
+
+// Tests for the algorithms over segmented ranges (std::deque), whole and cut inside and at segment boundaries
+#include "pstl_test_config.h"
+
+#include <deque>
+#include <vector>
+
+#include "pstl/execution"
+#include "pstl/algorithm"
+#include "pstl/numeric"
+#include "utils.h"
+
+using namespace TestUtils;
+
+template<typename T>
+struct Gen {
+    T operator()(std::size_t k) const { return T(k % 7 == 3 ? 1 : 3 * k % 101); }
+};
+
+struct test_non_modifying {
+    template<typename Policy, typename Iterator, typename ExpectedIterator>
+    void operator()(Policy&& exec, Iterator first, Iterator last, ExpectedIterator expected_first, ExpectedIterator expected_last) {
+        typedef typename std::iterator_traits<Iterator>::value_type T;
+        auto is_one = [](T x) { return x == T(1); };
+        auto is_small = [](T x) { return x < T(101); };
+        auto is_big = [](T x) { return x > T(90); };
+
+        EXPECT_TRUE(std::any_of(expected_first, expected_last, is_big) == std::any_of(exec, first, last, is_big),
+            "wrong result from any_of");
+        EXPECT_TRUE(std::all_of(expected_first, expected_last, is_small) == std::all_of(exec, first, last, is_small),
+            "wrong result from all_of");
+        EXPECT_TRUE(std::none_of(expected_first, expected_last, is_one) == std::none_of(exec, first, last, is_one),
+            "wrong result from none_of");
+
+        EXPECT_TRUE(std::distance(expected_first, std::find(expected_first, expected_last, T(1))) ==
+            std::distance(first, std::find(exec, first, last, T(1))), "wrong result from find");
+        EXPECT_TRUE(std::distance(expected_first, std::find_if(expected_first, expected_last, is_big)) ==
+            std::distance(first, std::find_if(exec, first, last, is_big)), "wrong result from find_if");
+
+        EXPECT_TRUE(std::count(expected_first, expected_last, T(1)) == std::count(exec, first, last, T(1)),
+            "wrong result from count");
+        EXPECT_TRUE(std::count_if(expected_first, expected_last, is_big) == std::count_if(exec, first, last, is_big),
+            "wrong result from count_if");
+
+        EXPECT_TRUE(std::accumulate(expected_first, expected_last, T(0)) == std::reduce(exec, first, last, T(0)),
+            "wrong result from reduce");
+        EXPECT_TRUE(std::accumulate(expected_first, expected_last, T(0), [](T a, T x) { return a + 2 * x; }) ==
+            std::transform_reduce(exec, first, last, T(0), std::plus<T>(), [](T x) { return 2 * x; }),
+            "wrong result from transform_reduce");
+    }
+};
+
+struct test_modifying {
+    template<typename Policy, typename Iterator, typename ExpectedIterator>
+    void operator()(Policy&& exec, Iterator first, Iterator last, ExpectedIterator expected_first, ExpectedIterator expected_last) {
+        typedef typename std::iterator_traits<Iterator>::value_type T;
+
+        std::for_each(expected_first, expected_last, [](T& x) { x += T(1); });
+        std::for_each(exec, first, last, [](T& x) { x += T(1); });
+        EXPECT_TRUE(std::equal(expected_first, expected_last, first), "wrong effect from for_each");
+
+        auto is_odd = [](T x) { return x % 2 != 0; };
+        std::replace_if(expected_first, expected_last, is_odd, T(0));
+        std::replace_if(exec, first, last, is_odd, T(0));
+        EXPECT_TRUE(std::equal(expected_first, expected_last, first), "wrong effect from replace_if");
+
+        // In place, and into a contiguous range
+        auto op = [](T x) { return T(3 * x % 101 + 1); };
+        std::transform(expected_first, expected_last, expected_first, op);
+        std::transform(exec, first, last, first, op);
+        EXPECT_TRUE(std::equal(expected_first, expected_last, first), "wrong effect from transform");
+
+        std::vector<T> out(std::distance(first, last));
+        std::vector<T> expected_out(out.size());
+        std::transform(exec, first, last, out.begin(), op);
+        std::transform(expected_first, expected_last, expected_out.begin(), op);
+        EXPECT_TRUE(expected_out == out, "wrong effect from transform into a vector");
+    }
+};
+
+template<typename T>
+void test() {
+    // A block of a libstdc++ deque holds 512 bytes; the ranges start and end inside blocks and at their boundaries
+    const std::size_t block = 512 / sizeof(T);
+    for (size_t n = 0; n <= 100000; n = n <= 16 ? n + 1 : size_t(3.1415 * n)) {
+        Sequence<T> in(n, Gen<T>());
+        std::deque<T> inout(in.begin(), in.end());
+        std::vector<T> expected(in.begin(), in.end());
+
+        const std::size_t cuts[] = {0, 1, block - 1, block, block + 1};
+        for (std::size_t cut : cuts) {
+            if (2 * cut > n)
+                break;
+            invoke_on_all_policies(test_non_modifying(), inout.cbegin() + cut, inout.cend() - cut,
+                expected.cbegin() + cut, expected.cend() - cut);
+            invoke_on_all_policies(test_modifying(), inout.begin() + cut, inout.end() - cut,
+                expected.begin() + cut, expected.end() - cut);
+        }
+    }
+}
+
+int32_t main() {
+    test<int32_t>();
+    test<int64_t>();
+    test<uint16_t>();
+    std::cout << done() << std::endl;
+    return 0;
+}